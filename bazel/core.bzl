@@ -334,6 +334,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/renderer/renderer_state.cpp",
     "src/mbgl/renderer/sources/render_custom_geometry_source.cpp",
     "src/mbgl/renderer/sources/render_custom_geometry_source.hpp",
+    "src/mbgl/renderer/sources/render_flatgeobuf_source.cpp",
+    "src/mbgl/renderer/sources/render_flatgeobuf_source.hpp",
     "src/mbgl/renderer/sources/render_geojson_source.cpp",
     "src/mbgl/renderer/sources/render_geojson_source.hpp",
     "src/mbgl/renderer/sources/render_image_source.cpp",
@@ -484,6 +486,9 @@ MLN_CORE_SOURCE = [
     "src/mbgl/style/sources/custom_geometry_source.cpp",
     "src/mbgl/style/sources/custom_geometry_source_impl.cpp",
     "src/mbgl/style/sources/custom_geometry_source_impl.hpp",
+    "src/mbgl/style/sources/flatgeobuf_source.cpp",
+    "src/mbgl/style/sources/flatgeobuf_source_impl.cpp",
+    "src/mbgl/style/sources/flatgeobuf_source_impl.hpp",
     "src/mbgl/style/sources/geojson_source.cpp",
     "src/mbgl/style/sources/geojson_source_impl.cpp",
     "src/mbgl/style/sources/geojson_source_impl.hpp",
@@ -531,6 +536,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/text/quads.hpp",
     "src/mbgl/text/shaping.cpp",
     "src/mbgl/text/shaping.hpp",
+    "src/mbgl/text/shaping_cache.cpp",
+    "src/mbgl/text/shaping_cache.hpp",
     "src/mbgl/text/tagged_string.cpp",
     "src/mbgl/text/tagged_string.hpp",
     "src/mbgl/tile/custom_geometry_tile.cpp",
@@ -578,6 +585,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/util/dtoa.hpp",
     "src/mbgl/util/event.cpp",
     "src/mbgl/util/filesystem.hpp",
+    "src/mbgl/util/flatgeobuf.cpp",
+    "src/mbgl/util/flatgeobuf.hpp",
     "src/mbgl/util/font_stack.cpp",
     "src/mbgl/util/geo.cpp",
     "src/mbgl/util/geojson_impl.cpp",
@@ -602,6 +611,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/util/longest_common_subsequence.hpp",
     "src/mbgl/util/mapbox.cpp",
     "src/mbgl/util/mapbox.hpp",
+    "src/mbgl/util/mapped_file.cpp",
+    "src/mbgl/util/mapped_file.hpp",
     "src/mbgl/util/mat2.cpp",
     "src/mbgl/util/mat2.hpp",
     "src/mbgl/util/mat3.cpp",
@@ -777,6 +788,7 @@ MLN_CORE_HEADERS = [
     "include/mbgl/style/rotation.hpp",
     "include/mbgl/style/source.hpp",
     "include/mbgl/style/sources/custom_geometry_source.hpp",
+    "include/mbgl/style/sources/flatgeobuf_source.hpp",
     "include/mbgl/style/sources/geojson_source.hpp",
     "include/mbgl/style/sources/image_source.hpp",
     "include/mbgl/style/sources/raster_dem_source.hpp",
@@ -15,8 +15,10 @@
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <algorithm>
 #include <sstream>
 #include <optional>
+#include <vector>
 
 using namespace mbgl;
 
@@ -49,6 +51,62 @@ void prepare_map2(Map& map, std::optional<std::string> json = std::nullopt) {
     map.getStyle().addImage(std::make_unique<style::Image>("test-icon", std::move(image), 1.0f));
 }
 
+class FrameObserver : public MapObserver {
+public:
+    void onDidFinishRenderingFrame(RenderFrameStatus status) override {
+        frameTimes.push_back(status.frameTime);
+        placements += status.placementChanged ? 1 : 0;
+    }
+    void onDidFinishRenderingMap(RenderMode mode) override { loaded = loaded || mode == RenderMode::Full; }
+
+    std::vector<double> frameTimes;
+    std::size_t placements = 0;
+    bool loaded = false;
+};
+
+// Rotates a continuously rendered map one frame per iteration, reporting the
+// 99th percentile and longest frame times and the number of placements swapped
+// in.
+void renderContinuous(::benchmark::State& state,
+                      void (*prepareMap)(Map&, std::optional<std::string>),
+                      std::optional<Duration> placementBudget) {
+    RenderBenchmark bench;
+    FrameObserver observer;
+    HeadlessFrontend frontend{size, pixelRatio};
+    Map map{frontend,
+            observer,
+            MapOptions().withMapMode(MapMode::Continuous).withSize(size).withPixelRatio(pixelRatio),
+            ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+    frontend.getRenderer()->setPlacementBudget(placementBudget);
+    prepareMap(map, std::nullopt);
+
+    while (!observer.loaded) {
+        frontend.renderOnce(map);
+    }
+    observer.frameTimes.clear();
+    observer.frameTimes.reserve(static_cast<std::size_t>(state.max_iterations));
+    observer.placements = 0;
+
+    double bearing = 0.0;
+    for (auto _ : state) {
+        bearing += 1.0;
+        map.jumpTo(CameraOptions().withBearing(bearing));
+        const auto frames = observer.frameTimes.size();
+        while (observer.frameTimes.size() == frames) {
+            frontend.renderOnce(map);
+        }
+    }
+
+    auto& frameTimes = observer.frameTimes;
+    if (!frameTimes.empty()) {
+        const auto p99 = frameTimes.begin() + static_cast<std::ptrdiff_t>((frameTimes.size() - 1) * 99 / 100);
+        std::nth_element(frameTimes.begin(), p99, frameTimes.end());
+        state.counters["p99_frame_ms"] = *p99 * 1000.0;
+        state.counters["max_frame_ms"] = *std::max_element(p99, frameTimes.end()) * 1000.0;
+    }
+    state.counters["placements"] = static_cast<double>(observer.placements);
+}
+
 } // end namespace
 
 static void API_renderStill_reuse_map(::benchmark::State& state) {
@@ -154,9 +212,24 @@ static void API_renderStill_multiple_sources(::benchmark::State& state) {
     }
 }
 
+static void API_renderContinuous_placement(::benchmark::State& state) {
+    renderContinuous(state, prepare, std::nullopt);
+}
+
+static void API_renderContinuous_placement_budget(::benchmark::State& state) {
+    renderContinuous(state, prepare, Milliseconds(2));
+}
+
+static void API_renderContinuous_placement_budget_2(::benchmark::State& state) {
+    renderContinuous(state, prepare_map2, Milliseconds(2));
+}
+
 BENCHMARK(API_renderStill_reuse_map)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_reuse_map_formatted_labels)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_reuse_map_switch_styles)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_recreate_map)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_recreate_map_2)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_multiple_sources)->Unit(benchmark::kMillisecond)->Iterations(50);
+BENCHMARK(API_renderContinuous_placement)->Unit(benchmark::kMillisecond)->Iterations(200);
+BENCHMARK(API_renderContinuous_placement_budget)->Unit(benchmark::kMillisecond)->Iterations(200);
+BENCHMARK(API_renderContinuous_placement_budget_2)->Unit(benchmark::kMillisecond)->Iterations(200);
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/conversion/geojson_options.hpp>
+#include <mbgl/style/conversion/json.hpp>
+#include <mbgl/style/sources/geojson_source.hpp>
+
+#include <cassert>
+#include <random>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+// Points spread over Europe, each with a few properties besides the
+// aggregated one, like a feed of vehicles or sensors
+GeoJSONData::Features createPoints(std::size_t count) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> lng(-10, 30);
+    std::uniform_real_distribution<double> lat(35, 60);
+    std::uniform_int_distribution<uint64_t> value(0, 100);
+    GeoJSONData::Features features;
+    features.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        features.emplace_back(Point<double>{lng(random), lat(random)});
+        auto& properties = features.back().properties;
+        properties["value"] = value(random);
+        properties["name"] = std::string("Feature ") + std::to_string(i);
+        properties["type"] = std::string(i % 2 ? "bus" : "tram");
+    }
+    return features;
+}
+
+Immutable<GeoJSONOptions> createOptions(const char* clusterProperties) {
+    conversion::Error error;
+    auto options = conversion::convertJSON<GeoJSONOptions>(
+        std::string(R"({"cluster": true, "clusterProperties": )") + clusterProperties + "}", error);
+    assert(options);
+    return makeMutable<GeoJSONOptions>(std::move(*options));
+}
+
+} // namespace
+
+// Clusters the points with sums, extremes and counts, which are accumulated
+// without evaluating their expressions
+static void GeoJSON_Cluster_Accumulated(benchmark::State& state) {
+    const GeoJSON points{createPoints(static_cast<std::size_t>(state.range(0)))};
+    const auto options = createOptions(R"({
+        "sum": ["+", ["get", "value"]],
+        "max": ["max", ["get", "value"]],
+        "count": ["+", 1]
+    })");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GeoJSONData::create(points, options));
+    }
+}
+
+// Clusters the points with a property whose expressions are evaluated
+static void GeoJSON_Cluster_Evaluated(benchmark::State& state) {
+    const GeoJSON points{createPoints(static_cast<std::size_t>(state.range(0)))};
+    const auto options = createOptions(R"({
+        "sum": [["+", ["accumulated"], ["get", "sum"]], ["*", 2, ["get", "value"]]]
+    })");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GeoJSONData::create(points, options));
+    }
+}
+
+BENCHMARK(GeoJSON_Cluster_Accumulated)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(GeoJSON_Cluster_Evaluated)->Arg(100000)->Unit(benchmark::kMillisecond);
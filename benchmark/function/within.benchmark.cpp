@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/style/expression/within.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <cmath>
+#include <random>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+// A country sized outline around (10, 50) with a jagged border, like the
+// polygons used to restrict labels to a region
+mapbox::geometry::polygon<double> createOutline(std::size_t vertices) {
+    mapbox::geometry::linear_ring<double> ring;
+    for (std::size_t i = 0; i <= vertices; ++i) {
+        const double angle = 2 * M_PI * static_cast<double>(i % vertices) / static_cast<double>(vertices);
+        const double radius = 5.0 + 0.5 * std::sin(angle * 97);
+        ring.emplace_back(10.0 + radius * std::cos(angle), 50.0 + radius * std::sin(angle) / 1.5);
+    }
+    return {ring};
+}
+
+std::vector<StubGeometryTileFeature> createPoints(std::size_t count) {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int16_t> coordinate(0, util::EXTENT - 1);
+    std::vector<StubGeometryTileFeature> features;
+    features.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        features.emplace_back(FeatureIdentifier(static_cast<uint64_t>(i)),
+                              FeatureType::Point,
+                              GeometryCollection{{{coordinate(random), coordinate(random)}}},
+                              PropertyMap());
+    }
+    return features;
+}
+
+} // namespace
+
+// Evaluates `within` for the points of one tile inside the outline
+static void Evaluate_Within(benchmark::State& state) {
+    const auto outline = createOutline(static_cast<std::size_t>(state.range(0)));
+    const expression::Within within(GeoJSON{mapbox::geometry::geometry<double>{outline}}, outline);
+    const auto features = createPoints(1000);
+    const CanonicalTileID canonical(8, 135, 86);
+
+    std::size_t matches = 0;
+    for (auto _ : state) {
+        for (const auto& feature : features) {
+            const auto result = within.evaluate(
+                expression::EvaluationContext(&feature).withCanonicalTileID(&canonical));
+            matches += result && *result == expression::Value(true);
+        }
+    }
+    benchmark::DoNotOptimize(matches);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * features.size()));
+}
+
+BENCHMARK(Evaluate_Within)->Arg(1000)->Arg(20000);
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/renderer/buckets/fill_bucket.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+// Building and landuse sized polygons scattered over a tile, some of them
+// with a courtyard
+std::vector<StubGeometryTileFeature> createPolygons(std::size_t count,
+                                                   std::size_t vertices,
+                                                   double minRadius = 20,
+                                                   double maxRadius = 150) {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int16_t> center(200, util::EXTENT - 200);
+    std::uniform_real_distribution<double> radius(minRadius, maxRadius);
+    std::vector<StubGeometryTileFeature> features;
+    features.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const GeometryCoordinate c{center(random), center(random)};
+        const double r = radius(random);
+        GeometryCollection polygon;
+        for (const double scale : {1.0, 0.4}) {
+            GeometryCoordinates ring;
+            for (std::size_t j = 0; j <= vertices; ++j) {
+                const double angle = 2 * M_PI * static_cast<double>(j % vertices) / static_cast<double>(vertices);
+                const double jagged = r * scale * (j % 2 ? 0.8 : 1.0);
+                ring.emplace_back(static_cast<int16_t>(c.x + jagged * std::cos(angle)),
+                                  static_cast<int16_t>(c.y + jagged * std::sin(angle)));
+            }
+            if (!polygon.empty()) {
+                std::reverse(ring.begin(), ring.end());
+            }
+            polygon.push_back(std::move(ring));
+            if (i % 4 != 0) break;
+        }
+        features.emplace_back(
+            FeatureIdentifier(static_cast<uint64_t>(i)), FeatureType::Polygon, std::move(polygon), PropertyMap());
+    }
+    return features;
+}
+
+void addFeatures(benchmark::State& state, const std::vector<StubGeometryTileFeature>& features) {
+    const FillBucket::PossiblyEvaluatedLayoutProperties layout;
+    std::size_t triangles = 0;
+    for (auto _ : state) {
+        FillBucket bucket{layout, {}, 14.0f, 1};
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            bucket.addFeature(
+                features[i], features[i].getGeometries(), {}, PatternLayerMap(), i, CanonicalTileID(14, 8800, 5370));
+        }
+        triangles += bucket.triangles.elements();
+    }
+    benchmark::DoNotOptimize(triangles);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * features.size()));
+}
+
+} // namespace
+
+// Tessellates the polygons of a dense city tile
+static void Parse_FillBucket(benchmark::State& state) {
+    addFeatures(state, createPolygons(static_cast<std::size_t>(state.range(0)), 12));
+}
+
+// Tessellates a single polygon reaching far into the tile buffer, like a
+// detailed coastline or country outline. The larger one has more vertices
+// than a segment can index.
+static void Parse_FillBucketLargePolygon(benchmark::State& state) {
+    addFeatures(state, createPolygons(1, static_cast<std::size_t>(state.range(0)), 12000, 12000));
+}
+
+BENCHMARK(Parse_FillBucket)->Arg(1000)->Arg(10000);
+BENCHMARK(Parse_FillBucketLargePolygon)->Arg(20000)->Arg(70000);
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/renderer/buckets/line_bucket.hpp>
+#include <mbgl/renderer/possibly_evaluated_property_value.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+// Roads of a dense city tile: lines that mostly bend gently, with the odd
+// sharp turn, and some repeated vertices.
+std::vector<StubGeometryTileFeature> createRoads(std::size_t count) {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int16_t> start(0, util::EXTENT);
+    std::uniform_int_distribution<std::size_t> vertices(2, 60);
+    std::uniform_real_distribution<double> length(10, 200);
+    std::normal_distribution<double> bend(0, 0.3);
+    std::uniform_real_distribution<double> heading(0, 2 * M_PI);
+    std::vector<StubGeometryTileFeature> features;
+    features.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        GeometryCoordinates line{{start(random), start(random)}};
+        double angle = heading(random);
+        for (std::size_t n = vertices(random); n > 1; --n) {
+            angle += random() % 10 == 0 ? 2.5 : bend(random);
+            const double step = random() % 20 == 0 ? 0 : length(random);
+            const auto& last = line.back();
+            line.emplace_back(static_cast<int16_t>(std::clamp(last.x + step * std::cos(angle), -128.0, 8320.0)),
+                              static_cast<int16_t>(std::clamp(last.y + step * std::sin(angle), -128.0, 8320.0)));
+        }
+        features.emplace_back(FeatureIdentifier(static_cast<uint64_t>(i)),
+                              FeatureType::LineString,
+                              GeometryCollection{std::move(line)},
+                              PropertyMap());
+    }
+    return features;
+}
+
+void addFeatures(benchmark::State& state, LineJoinType join, LineCapType cap) {
+    const auto features = createRoads(static_cast<std::size_t>(state.range(0)));
+    LineBucket::PossiblyEvaluatedLayoutProperties layout;
+    layout.get<LineJoin>() = PossiblyEvaluatedPropertyValue<LineJoinType>(join);
+    layout.get<LineCap>() = cap;
+
+    std::size_t vertices = 0;
+    for (auto _ : state) {
+        LineBucket bucket{layout, {}, 14.0f, 1};
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            bucket.addFeature(
+                features[i], features[i].getGeometries(), {}, PatternLayerMap(), i, CanonicalTileID(14, 8800, 5370));
+        }
+        vertices += bucket.vertices.elements();
+    }
+    benchmark::DoNotOptimize(vertices);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * features.size()));
+}
+
+} // namespace
+
+// Extrudes roads with the default miter joins and butt caps
+static void Parse_LineBucketMiter(benchmark::State& state) {
+    addFeatures(state, LineJoinType::Miter, LineCapType::Butt);
+}
+
+// Extrudes roads with round joins and caps, the usual road style
+static void Parse_LineBucketRound(benchmark::State& state) {
+    addFeatures(state, LineJoinType::Round, LineCapType::Round);
+}
+
+BENCHMARK(Parse_LineBucketMiter)->Arg(1000)->Arg(10000);
+BENCHMARK(Parse_LineBucketRound)->Arg(1000)->Arg(10000);
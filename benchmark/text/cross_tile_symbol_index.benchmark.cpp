@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/renderer/buckets/symbol_bucket.hpp>
+#include <mbgl/text/cross_tile_symbol_index.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <memory>
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+// Labels are drawn from a pool, so that a tile and its children share most of
+// their keys the way place and road names do.
+constexpr std::size_t labelPoolSize = 400;
+constexpr std::size_t labelsPerTile = 300;
+
+std::vector<std::u16string> createLabels() {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> letter(u'a', u'z');
+    std::uniform_int_distribution<std::size_t> length(4, 16);
+    std::vector<std::u16string> labels;
+    labels.reserve(labelPoolSize);
+    for (std::size_t i = 0; i < labelPoolSize; ++i) {
+        std::u16string label;
+        for (std::size_t j = length(random); j > 0; --j) {
+            label += static_cast<char16_t>(letter(random));
+        }
+        labels.push_back(std::move(label));
+    }
+    return labels;
+}
+
+SymbolInstance makeSymbolInstance(float x, float y, std::u16string key) {
+    Anchor anchor(x, y, 0, 0);
+    const ShapedTextOrientations shaping{};
+    const std::array<float, 2> offset{{0.0f, 0.0f}};
+    const auto placementType = style::SymbolPlacementType::Point;
+    auto sharedData = std::make_shared<SymbolInstanceSharedData>(GeometryCoordinates{},
+                                                                 shaping,
+                                                                 std::nullopt,
+                                                                 std::nullopt,
+                                                                 style::SymbolLayoutProperties::Evaluated{},
+                                                                 placementType,
+                                                                 offset,
+                                                                 ImageMap{},
+                                                                 0.0f,
+                                                                 SymbolContent::IconSDF,
+                                                                 false,
+                                                                 false);
+    return SymbolInstance(anchor,
+                          std::move(sharedData),
+                          shaping,
+                          std::nullopt,
+                          std::nullopt,
+                          0,
+                          0,
+                          placementType,
+                          offset,
+                          0,
+                          0,
+                          offset,
+                          IndexedSubfeature(0, "", "", 0),
+                          0,
+                          0,
+                          std::move(key),
+                          0.0f,
+                          0.0f,
+                          0.0f,
+                          offset,
+                          false);
+}
+
+// The symbols of a tile at zoom 6, or those of its descendant `tile` that
+// fall within it, so that a child repeats the keys and positions of its parent
+std::unique_ptr<SymbolBucket> createBucket(const std::vector<std::u16string>& labels,
+                                           const CanonicalTileID& tile,
+                                           uint32_t bucketInstanceId) {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<std::size_t> label(0, labels.size() - 1);
+    std::uniform_real_distribution<float> position(0.0f, static_cast<float>(util::EXTENT));
+    const uint32_t scale = 1u << (tile.z - 6);
+    std::vector<SymbolInstance> instances;
+    instances.reserve(labelsPerTile);
+    for (std::size_t i = 0; i < labelsPerTile; ++i) {
+        const float x = position(random) * scale - static_cast<float>(tile.x % scale) * util::EXTENT;
+        const float y = position(random) * scale - static_cast<float>(tile.y % scale) * util::EXTENT;
+        const auto& key = labels[label(random)];
+        if (x >= 0 && y >= 0 && x < util::EXTENT && y < util::EXTENT) {
+            instances.push_back(makeSymbolInstance(x, y, key));
+        }
+    }
+
+    Immutable<style::SymbolLayoutProperties::PossiblyEvaluated> layout =
+        makeMutable<style::SymbolLayoutProperties::PossiblyEvaluated>();
+    auto bucket = std::make_unique<SymbolBucket>(layout,
+                                                 std::map<std::string, Immutable<style::LayerProperties>>{},
+                                                 16.0f,
+                                                 1.0f,
+                                                 static_cast<float>(tile.z),
+                                                 false,
+                                                 false,
+                                                 "symbols",
+                                                 std::move(instances),
+                                                 std::vector<SortKeyRange>{},
+                                                 1.0f,
+                                                 false,
+                                                 std::vector<style::TextWritingModeType>{},
+                                                 false);
+    bucket->bucketInstanceId = bucketInstanceId;
+    return bucket;
+}
+
+} // namespace
+
+// Indexes a tile and then its four children, matching each child's symbols
+// against the parent's by key and position.
+static void CrossTileSymbolIndex_AddBuckets(::benchmark::State& state) {
+    const auto labels = createLabels();
+    const OverscaledTileID parent{6, 0, 6, 8, 8};
+    std::vector<OverscaledTileID> tiles{parent};
+    for (const auto& child : parent.canonical.children()) {
+        tiles.push_back(OverscaledTileID{child.z, 0, child});
+    }
+    std::vector<std::unique_ptr<SymbolBucket>> buckets;
+    for (const auto& tile : tiles) {
+        buckets.push_back(createBucket(labels, tile.canonical, static_cast<uint32_t>(buckets.size() + 1)));
+    }
+
+    std::size_t symbols = 0;
+    for (auto _ : state) {
+        uint32_t maxCrossTileID = 0;
+        CrossTileSymbolLayerIndex index(maxCrossTileID);
+        for (std::size_t i = 0; i < tiles.size(); ++i) {
+            index.addBucket(tiles[i], mat4{}, *buckets[i]);
+            symbols += buckets[i]->symbolInstances.size();
+        }
+        benchmark::DoNotOptimize(maxCrossTileID);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(symbols));
+}
+
+BENCHMARK(CrossTileSymbolIndex_AddBuckets);
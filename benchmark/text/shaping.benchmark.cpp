@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/text/tagged_string.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+// Street names are drawn from a pool, so that neighbouring tiles share most
+// of their labels the way road and place names repeat across tile borders.
+constexpr std::size_t labelPoolSize = 400;
+constexpr std::size_t labelsPerTile = 150;
+constexpr std::size_t tilesPerPan = 16;
+
+class TileSequence {
+public:
+    TileSequence() {
+        const std::u16string alphabet = u"abcdefghijklmnopqrstuvwxyz ";
+        for (char16_t id : alphabet) {
+            Glyph glyph;
+            glyph.id = id;
+            glyph.metrics = {14, 18, 1, -8, id == u' ' ? 6u : 12u};
+            glyphs[fontStackHash].emplace(id, Immutable<Glyph>(makeMutable<Glyph>(std::move(glyph))));
+            if (id != u' ') {
+                positions[fontStackHash].emplace(id, GlyphPosition{{id, 0, 16, 24}, {14, 18, 1, -8, 12}});
+            }
+        }
+
+        std::mt19937 random(42);
+        std::uniform_int_distribution<std::size_t> letter(0, alphabet.size() - 2);
+        std::uniform_int_distribution<std::size_t> wordLength(3, 10);
+        for (std::size_t i = 0; i < labelPoolSize; ++i) {
+            std::u16string text;
+            for (std::size_t words = 1 + i % 3; words > 0; --words) {
+                for (std::size_t length = wordLength(random); length > 0; --length) {
+                    text += alphabet[letter(random)];
+                }
+                if (words > 1) {
+                    text += u' ';
+                }
+            }
+            labels.emplace_back(std::move(text), SectionOptions(1.0, fontStack));
+        }
+    }
+
+    // Shapes the labels of a pan across `tilesPerPan` tiles. Each tile starts
+    // a few labels further into the pool than the one before.
+    template <typename Shape>
+    std::size_t pan(Shape&& shape) {
+        std::size_t lines = 0;
+        for (std::size_t tile = 0; tile < tilesPerPan; ++tile) {
+            for (std::size_t i = 0; i < labelsPerTile; ++i) {
+                const auto& label = labels[(tile * 20 + i) % labels.size()];
+                lines += shape(label).positionedLines.size();
+            }
+        }
+        return lines;
+    }
+
+    const FontStack fontStack{{"Open Sans Regular"}};
+    const FontStackHash fontStackHash = FontStackHasher()(fontStack);
+    BiDi bidi;
+    GlyphMap glyphs;
+    GlyphPositions positions;
+    ImagePositions imagePositions;
+    std::vector<TaggedString> labels;
+};
+
+} // namespace
+
+static void Shaping_tileSequence(benchmark::State& state) {
+    TileSequence sequence;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sequence.pan([&](const TaggedString& label) {
+            return getShaping(label,
+                              10 * util::ONE_EM,
+                              1.2f * util::ONE_EM,
+                              style::SymbolAnchorType::Center,
+                              style::TextJustifyType::Center,
+                              0.0f,
+                              {{0.0f, 0.0f}},
+                              WritingModeType::Horizontal,
+                              sequence.bidi,
+                              sequence.glyphs,
+                              sequence.positions,
+                              sequence.imagePositions,
+                              16.0f,
+                              16.0f,
+                              false);
+        }));
+    }
+}
+
+static void Shaping_tileSequence_cached(benchmark::State& state) {
+    TileSequence sequence;
+    ShapingCache cache;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sequence.pan([&](const TaggedString& label) {
+            return cache.getShaping(label,
+                                    10 * util::ONE_EM,
+                                    1.2f * util::ONE_EM,
+                                    style::SymbolAnchorType::Center,
+                                    style::TextJustifyType::Center,
+                                    0.0f,
+                                    {{0.0f, 0.0f}},
+                                    WritingModeType::Horizontal,
+                                    sequence.bidi,
+                                    sequence.glyphs,
+                                    sequence.positions,
+                                    sequence.imagePositions,
+                                    16.0f,
+                                    16.0f,
+                                    false);
+        }));
+    }
+}
+
+BENCHMARK(Shaping_tileSequence);
+BENCHMARK(Shaping_tileSequence_cached);
@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/grid_index.hpp>
+
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+// A 1200x1200 collision grid, matching a 1000px viewport with its padding
+constexpr float gridSize = 1200.0f;
+constexpr uint32_t cellSize = 25;
+
+using Grid = GridIndex<uint32_t>;
+
+// Places `labels` point labels and, in the same proportion as in a typical
+// street map, line labels made of collision circles: a label is inserted
+// only when it does not hit anything placed before, like CollisionIndex does.
+std::size_t placeLabels(std::size_t labels, uint16_t seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> position(0.0f, gridSize);
+    std::uniform_real_distribution<float> width(30.0f, 120.0f);
+
+    Grid grid(gridSize, gridSize, cellSize);
+    std::size_t placed = 0;
+    for (uint32_t i = 0; i < labels; ++i) {
+        const float x = position(random);
+        const float y = position(random);
+        auto groupPredicate = [i](const uint32_t& key) {
+            return (key & 1u) == (i & 1u);
+        };
+
+        if (i % 3 == 0) {
+            // Line label: a run of circles along a line
+            bool collides = false;
+            for (int c = 0; c < 8 && !collides; ++c) {
+                collides = grid.hitTest(Grid::BCircle{{x + c * 10.0f, y + c * 3.0f}, 6.0f}, groupPredicate);
+            }
+            if (!collides) {
+                for (int c = 0; c < 8; ++c) {
+                    grid.insert(uint32_t(i), Grid::BCircle{{x + c * 10.0f, y + c * 3.0f}, 6.0f});
+                }
+                ++placed;
+            }
+        } else {
+            const Grid::BBox box{{x, y}, {x + width(random), y + 16.0f}};
+            if (!grid.hitTest(box, groupPredicate)) {
+                grid.insert(uint32_t(i), box);
+                ++placed;
+            }
+        }
+    }
+    return placed;
+}
+
+} // namespace
+
+static void GridIndex_placeLabels(benchmark::State& state) {
+    std::size_t placed = 0;
+    for (auto _ : state) {
+        placed += placeLabels(static_cast<std::size_t>(state.range(0)), 42);
+    }
+    benchmark::DoNotOptimize(placed);
+}
+
+static void GridIndex_query(benchmark::State& state) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(0.0f, gridSize);
+    Grid grid(gridSize, gridSize, cellSize);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(state.range(0)); ++i) {
+        const float x = position(random);
+        const float y = position(random);
+        grid.insert(uint32_t(i), Grid::BBox{{x, y}, {x + 80.0f, y + 16.0f}});
+    }
+
+    std::size_t found = 0;
+    for (auto _ : state) {
+        const float x = position(random);
+        const float y = position(random);
+        grid.query(Grid::BBox{{x, y}, {x + 100.0f, y + 100.0f}}, [&](const uint32_t&, const Grid::BBox&) {
+            ++found;
+            return false;
+        });
+    }
+    benchmark::DoNotOptimize(found);
+}
+
+BENCHMARK(GridIndex_placeLabels)->Arg(500)->Arg(2000)->Arg(8000);
+BENCHMARK(GridIndex_query)->Arg(500)->Arg(2000)->Arg(8000);
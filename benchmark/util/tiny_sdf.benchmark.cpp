@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/tiny_sdf.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Antialiased rings standing in for rasterized glyphs, in the 30px size of
+// local CJK glyphs and a larger one
+std::vector<AlphaImage> makeGlyphs(uint32_t size) {
+    std::vector<AlphaImage> glyphs;
+    for (uint32_t i = 0; i < 16; ++i) {
+        AlphaImage glyph({size, size});
+        const double center = size / 2.0;
+        const double outer = size * (0.25 + 0.01 * i);
+        const double inner = outer * 0.6;
+        for (uint32_t y = 0; y < size; ++y) {
+            for (uint32_t x = 0; x < size; ++x) {
+                const double distance = std::hypot(x + 0.5 - center, y + 0.5 - center);
+                const double coverage = std::min(std::max(outer - distance, 0.0), 1.0) *
+                                        std::min(std::max(distance - inner, 0.0), 1.0);
+                glyph.data[y * size + x] = static_cast<uint8_t>(coverage * 255);
+            }
+        }
+        glyphs.push_back(std::move(glyph));
+    }
+    return glyphs;
+}
+
+} // namespace
+
+static void TinySDF_transformRasterToSDF(benchmark::State& state) {
+    const auto glyphs = makeGlyphs(static_cast<uint32_t>(state.range(0)));
+    for (auto _ : state) {
+        for (const auto& glyph : glyphs) {
+            benchmark::DoNotOptimize(util::transformRasterToSDF(glyph, 8, .25));
+        }
+    }
+}
+
+static void TinySDF_transform_reused(benchmark::State& state) {
+    const auto glyphs = makeGlyphs(static_cast<uint32_t>(state.range(0)));
+    util::TinySDF sdf;
+    for (auto _ : state) {
+        for (const auto& glyph : glyphs) {
+            benchmark::DoNotOptimize(sdf.transform(glyph, 8, .25));
+        }
+    }
+}
+
+BENCHMARK(TinySDF_transformRasterToSDF)->Arg(30)->Arg(64);
+BENCHMARK(TinySDF_transform_reused)->Arg(30)->Arg(64);
@@ -1,8 +1,35 @@
 #pragma once
 
+#include <string>
+#include <vector>
+
 namespace mbgl {
 namespace gfx {
 
+/// CPU time, in seconds, spent in the phases of the most recent frame
+struct FrameTimings {
+    struct Layer {
+        std::string id;
+        /// Encoding the draw calls of the layer, in all render passes
+        double encoding = 0.0;
+    };
+
+    /// Building the render tree, including placement
+    double createRenderTree = 0.0;
+    /// Symbol placement, a subset of `createRenderTree`
+    double placement = 0.0;
+    /// Buffer, texture and layer group uploads
+    double upload = 0.0;
+    /// Layer tweakers
+    double tweakers = 0.0;
+    /// Encoding the draw calls for all the render passes
+    double encoding = 0.0;
+    /// The layers drawn in the frame, bottom to top
+    std::vector<Layer> layers;
+
+    double total() const { return createRenderTree + upload + tweakers + encoding; }
+};
+
 struct RenderingStats {
     RenderingStats() = default;
     bool isZero() const;
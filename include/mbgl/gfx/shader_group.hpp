@@ -2,6 +2,7 @@
 
 #include <mbgl/gfx/shader.hpp>
 
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
@@ -13,6 +14,9 @@ namespace gfx {
 
 class Context;
 
+/// @brief Deferred constructor for a shader registered with `ShaderGroup::registerShaderFactory`
+using ShaderFactory = std::function<std::shared_ptr<Shader>()>;
+
 /// @brief A ShaderGroup contains a collection of gfx::Shader.
 /// Using the group, shaders may be dynamically registered or replaced
 /// at runtime.
@@ -70,6 +74,21 @@ public:
     /// already present with a conflicting name.
     [[nodiscard]] virtual bool registerShader(std::shared_ptr<Shader>&& shader, const std::string& shaderName) noexcept;
 
+    /// @brief Register a shader that is only constructed the first time it is
+    /// looked up. If a shader or factory is present in the group with a
+    /// conflicting name, registration will fail.
+    /// @param factory Callable producing the shader instance.
+    /// @param shaderName Unique name to register the shader under.
+    /// @return True if the factory was registered, false if another shader is
+    /// already present with a conflicting name.
+    [[nodiscard]] virtual bool registerShaderFactory(ShaderFactory&& factory, const std::string& shaderName) noexcept;
+
+    /// @brief Check whether a shader registered with a factory is still waiting
+    /// to be constructed.
+    /// @param shaderName Name of shader
+    /// @return True if the shader has a pending factory
+    [[nodiscard]] bool isShaderPending(const std::string& shaderName) const noexcept;
+
     /// @brief Shorthand helper to quickly get a derived type from the group.
     /// @tparam T Derived type, inheriting `gfx::Shader`
     /// @param shaderName The group name to look up
@@ -148,7 +167,9 @@ public:
     }
 
 private:
-    std::unordered_map<std::string, std::shared_ptr<gfx::Shader>> programs;
+    // Deferred shaders are moved from `factories` into `programs` on first lookup
+    mutable std::unordered_map<std::string, std::shared_ptr<gfx::Shader>> programs;
+    mutable std::unordered_map<std::string, ShaderFactory> factories;
     mutable std::shared_mutex programLock;
 };
 
@@ -36,6 +36,18 @@ public:
 
     void draw(PaintParameters&) const override;
 
+    /// Whether this drawable uses the same program and textures as `other`, so it can be
+    /// drawn directly after it without rebinding the textures.
+    bool isBatchCompatible(const DrawableGL& other) const;
+
+    /// Draw as part of a run of drawables. Textures are only bound if `previous` is
+    /// null or not batch-compatible, and bindings are left in place for the next
+    /// drawable in the run.
+    void drawBatched(PaintParameters&, const DrawableGL* previous) const;
+
+    /// Release the bindings left in place by a run of `drawBatched` calls
+    void endBatch(PaintParameters&) const;
+
     struct DrawSegmentGL;
     void setIndexData(gfx::IndexVectorBasePtr, std::vector<UniqueDrawSegment> segments) override;
 
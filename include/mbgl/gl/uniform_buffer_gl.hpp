@@ -2,25 +2,107 @@
 
 #include <mbgl/gfx/uniform_buffer.hpp>
 #include <mbgl/gl/types.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace mbgl {
 namespace gl {
 
+/// Suballocates small uniform buffers from a few large GL buffer objects.
+/// Writes go to a CPU-side copy of each buffer. The few disjoint ranges changed
+/// are uploaded the first time one of the buffer's ranges is bound.
+/// Owned by the `Context`, uniform buffers only keep a weak reference to it.
+class UniformBufferAllocator : private util::noncopyable {
+public:
+    struct Range {
+        std::size_t chunk;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    UniformBufferAllocator() = default;
+    ~UniformBufferAllocator();
+
+    /// Reserve a range of `size` bytes, aligned for binding with an offset.
+    /// Returns nothing if the size is too large to be suballocated.
+    std::optional<Range> allocate(std::size_t size);
+
+    /// Return a range to the allocator for reuse. Once all the ranges of a
+    /// buffer object are returned, it is deleted, unless it is the last one.
+    void release(const Range&);
+
+    /// Copy data into a range. Returns false if the contents were unchanged.
+    bool write(const Range&, const void* data, std::size_t size);
+
+    /// Copy the contents of one range into another of the same size
+    void copy(const Range& from, const Range& to);
+
+    /// Upload pending writes to the buffer holding the range and bind the range
+    void bind(const Range&, int32_t binding);
+
+    /// Forget the buffer objects without deleting them, for when the GL
+    /// context is already gone
+    void abandon();
+
+    /// The number of buffer objects currently allocated
+    std::size_t getBufferCount() const;
+
+    /// The offset alignment of ranges, as required by the GL implementation
+    std::size_t getAlignment();
+
+    /// The number of ranges of a buffer object waiting to be uploaded.
+    /// For testing only.
+    std::size_t getDirtyRangeCount(std::size_t chunk) const;
+
+private:
+    struct Chunk {
+        BufferID id = 0;
+        std::vector<uint8_t> shadow;
+        std::size_t used = 0;
+        // Number of ranges handed out and not yet released
+        std::size_t live = 0;
+        // Byte ranges written since the last upload
+        std::vector<std::pair<std::size_t, std::size_t>> dirtyRanges;
+    };
+
+    void createChunk(Chunk&);
+    void deleteChunk(Chunk&);
+    void markDirty(Chunk&, std::size_t begin, std::size_t end);
+
+    std::vector<Chunk> chunks;
+    // The chunk new ranges are carved from
+    std::size_t current = 0;
+    // Released ranges, by aligned size
+    std::unordered_map<std::size_t, std::vector<Range>> freeRanges;
+    std::size_t alignment = 0;
+};
+
 class UniformBufferGL final : public gfx::UniformBuffer {
 public:
     UniformBufferGL(const void* data, std::size_t size_);
-    UniformBufferGL(const UniformBufferGL& other)
-        : UniformBuffer(other) {}
-    UniformBufferGL(UniformBufferGL&& other)
-        : UniformBuffer(std::move(other)) {}
+    UniformBufferGL(const void* data, std::size_t size_, const std::shared_ptr<UniformBufferAllocator>&);
+    UniformBufferGL(const UniformBufferGL& other);
+    UniformBufferGL(UniformBufferGL&& other);
     ~UniformBufferGL() override;
 
     BufferID getID() const { return id; }
     void update(const void* data, std::size_t size_) override;
 
+    /// Bind the buffer, or its range of a shared buffer, to a uniform block binding
+    void bind(int32_t binding) const;
+
 protected:
     BufferID id = 0;
     uint32_t hash;
+
+    std::weak_ptr<UniformBufferAllocator> allocator;
+    std::optional<UniformBufferAllocator::Range> range;
 };
 
 /// Stores a collection of uniform buffers by name
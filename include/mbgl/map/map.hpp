@@ -123,6 +123,8 @@ public:
 
     AnnotationID addAnnotation(const Annotation&);
     void updateAnnotation(AnnotationID, const Annotation&);
+    // Updates many annotations with a single repaint
+    void updateAnnotations(const std::vector<std::pair<AnnotationID, Annotation>>&);
     void removeAnnotation(AnnotationID);
 
     // Tile prefetching
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <mbgl/gfx/rendering_stats.hpp>
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/annotation/annotation.hpp>
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/geojson.hpp>
 
@@ -107,6 +109,26 @@ public:
      */
     const std::vector<PlacedSymbolData>& getPlacedSymbolsData() const;
 
+    /**
+     * @brief In Continuous map mode, limits the time spent placing symbols in
+     * each frame. A placement that does not fit in the budget is continued on
+     * the following frames, and is shown once it is complete.
+     *
+     * Without a budget, which is the default, symbols are placed on a
+     * background thread and the result is shown on the next frame.
+     */
+    void setPlacementBudget(std::optional<Duration> budget);
+
+    /**
+     * @brief Returns the CPU time spent in each phase of the most recently
+     * rendered frame, and the time spent encoding each layer.
+     *
+     * Note: the returned timings get re-populated at every `render()` call.
+     *
+     * @return frame timings
+     */
+    const gfx::FrameTimings& getFrameTimings() const;
+
     // Memory
     void reduceMemoryUse();
     void clearData();
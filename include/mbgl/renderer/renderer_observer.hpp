@@ -9,7 +9,8 @@ namespace mbgl {
 
 namespace gfx {
 class ShaderRegistry;
-}
+struct FrameTimings;
+} // namespace gfx
 
 class RendererObserver {
 public:
@@ -40,6 +41,9 @@ public:
         onDidFinishRenderingFrame(mode, repaint, placementChanged);
     }
 
+    /// End of frame, CPU time spent in each phase of the frame and in each layer
+    virtual void onDidFinishRenderingFrameTimings(const gfx::FrameTimings&) {}
+
     /// Final frame
     virtual void onDidFinishRenderingMap() {}
 
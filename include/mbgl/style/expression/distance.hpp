@@ -15,6 +15,8 @@
 #include <mbgl/style/expression/expression.hpp>
 #include <mbgl/util/geojson.hpp>
 
+#include <memory>
+
 namespace mbgl {
 namespace style {
 namespace expression {
@@ -39,8 +41,12 @@ public:
     std::string getOperator() const override;
 
 private:
+    class ReferenceIndex;
+
     GeoJSON geoJSONSource;
     Feature::geometry_type geometries;
+    // Spatial index of the geometries, if they are points or lines
+    std::unique_ptr<const ReferenceIndex> index;
 };
 
 } // namespace expression
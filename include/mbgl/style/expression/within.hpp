@@ -3,6 +3,7 @@
 #include <mbgl/style/expression/expression.hpp>
 #include <mbgl/util/geojson.hpp>
 
+#include <memory>
 #include <optional>
 
 namespace mbgl {
@@ -29,8 +30,13 @@ public:
     std::string getOperator() const override;
 
 private:
+    class TilePolygonsCache;
+
     GeoJSON geoJSONSource;
     Feature::geometry_type geometries;
+    // The polygons projected into the tiles the expression was last
+    // evaluated in
+    std::unique_ptr<TilePolygonsCache> tilePolygons;
 };
 
 } // namespace expression
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <mbgl/style/source.hpp>
+#include <mbgl/style/sources/geojson_source.hpp>
+
+#include <memory>
+#include <string>
+
+namespace mbgl {
+
+class Scheduler;
+
+namespace style {
+
+// Features of a local FlatGeobuf file with a spatial index. The file is
+// mapped in memory, and each tile only decodes the features in its bounds,
+// then clips and simplifies them on a worker thread. Coordinates must be in
+// longitude and latitude. Tiles are made with the GeoJSON options, except
+// for clustering. Low zoom tiles read most of the file, so large files
+// should be shown from a minzoom.
+class FlatGeobufSource final : public Source {
+public:
+    FlatGeobufSource(std::string id,
+                     std::string path,
+                     Immutable<GeoJSONOptions> = GeoJSONOptions::defaultOptions());
+    ~FlatGeobufSource() final;
+
+    const std::string& getPath() const;
+    const GeoJSONOptions& getOptions() const;
+
+    class Impl;
+    const Impl& impl() const;
+
+    // Opens the file on a background thread
+    void loadDescription(FileSource&) final;
+
+    bool supportsLayerType(const mbgl::style::LayerTypeInfo*) const override;
+
+    mapbox::base::WeakPtr<Source> makeWeakPtr() override { return weakFactory.makeWeakPtr(); }
+
+protected:
+    Mutable<Source::Impl> createMutable() const noexcept final;
+
+private:
+    std::string path;
+    std::shared_ptr<Scheduler> threadPool;
+    bool opening = false;
+    mapbox::base::WeakPtrFactory<Source> weakFactory{this};
+};
+
+template <>
+inline bool Source::is<FlatGeobufSource>() const {
+    return getType() == SourceType::FlatGeobuf;
+}
+
+} // namespace style
+} // namespace mbgl
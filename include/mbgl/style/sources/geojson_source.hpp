@@ -4,11 +4,15 @@
 #include <mbgl/style/source.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/util/geojson.hpp>
 
+#include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -53,15 +57,41 @@ public:
     virtual std::uint8_t getClusterExpansionZoom(std::uint32_t) = 0;
 
     virtual std::shared_ptr<Scheduler> getScheduler() { return nullptr; }
+
+    // Whether the features of the tile may differ from the ones `previous`
+    // has for it. Data built after GeoJSONSource::updateFeatures() only
+    // report the tiles around the changed features.
+    virtual bool isTileChanged(const CanonicalTileID&, const GeoJSONData& /*previous*/) const { return true; }
 };
 
+class GeoJSONFeatureStore;
+
 class GeoJSONSource final : public Source {
 public:
     GeoJSONSource(std::string id, Immutable<GeoJSONOptions> = GeoJSONOptions::defaultOptions());
     ~GeoJSONSource() final;
 
     void setURL(const std::string& url);
+
+    // Indexes the data on a background thread. The source keeps its current
+    // data until the new ones are ready, and is not loaded in the meantime,
+    // so rendered features queried right after the call are the old ones.
     void setGeoJSON(const GeoJSON&);
+    void setGeoJSON(GeoJSON&&);
+
+    // Adds, replaces and removes features by ID in the data set with
+    // setGeoJSON() or loaded from the URL, on a background thread. Added
+    // features replace the ones with the same ID, updated features without
+    // a match are ignored. The features are indexed again in full, but tiles
+    // away from the changed features are kept.
+    // A source only keeps its features for updates from the first call on:
+    // data indexed before then are not kept, and updating them is ignored
+    // with a warning until new data are set. The same goes for data set with
+    // setGeoJSONData().
+    void updateFeatures(GeoJSONData::Features add,
+                        GeoJSONData::Features update,
+                        std::vector<FeatureIdentifier> remove);
+
     void setGeoJSONData(std::shared_ptr<GeoJSONData>);
 
     std::optional<std::string> getURL() const;
@@ -80,9 +110,17 @@ protected:
     Mutable<Source::Impl> createMutable() const noexcept final;
 
 private:
+    // Changes the features and indexes them on the background scheduler
+    void buildData(std::function<void(GeoJSONFeatureStore&)>);
+
     std::optional<std::string> url;
     std::unique_ptr<AsyncRequest> req;
     std::shared_ptr<Scheduler> threadPool;
+    // Null once data were set with setGeoJSONData()
+    std::shared_ptr<GeoJSONFeatureStore> features;
+    // Latest build, older ones are skipped
+    std::shared_ptr<std::atomic<std::uint64_t>> dataRequest;
+    bool building = false;
     mapbox::base::WeakPtrFactory<Source> weakFactory{this};
 };
 
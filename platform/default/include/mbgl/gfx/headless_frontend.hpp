@@ -21,6 +21,7 @@ public:
     struct RenderResult {
         PremultipliedImage image;
         gfx::RenderingStats stats;
+        gfx::FrameTimings timings;
     };
 
     HeadlessFrontend(float pixelRatio_,
@@ -151,6 +151,7 @@ HeadlessFrontend::RenderResult HeadlessFrontend::render(Map& map) {
         } else {
             result.image = backend->readStillImage();
             result.stats = getBackend()->getContext().renderingStats();
+            result.timings = renderer->getFrameTimings();
         }
     });
 
@@ -212,6 +212,7 @@ OfflineRegionStatus OfflineDownload::getStatus() const {
             case SourceType::Video:
             case SourceType::Annotations:
             case SourceType::CustomVector:
+            case SourceType::FlatGeobuf:
                 break;
         }
     }
@@ -325,6 +326,7 @@ void OfflineDownload::activateDownload() {
                 case SourceType::Video:
                 case SourceType::Annotations:
                 case SourceType::CustomVector:
+                case SourceType::FlatGeobuf:
                     break;
             }
         }
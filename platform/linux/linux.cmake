@@ -1,5 +1,6 @@
 option(MLN_WITH_X11 "Build with X11 Support" ON)
 option(MLN_WITH_WAYLAND "Build with Wayland Support" OFF)
+option(MLN_WITH_FREETYPE "Rasterize CJK glyphs locally with FreeType and Fontconfig" ON)
 
 find_package(CURL REQUIRED)
 find_package(ICU OPTIONAL_COMPONENTS i18n)
@@ -40,7 +41,6 @@ target_sources(
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/storage/online_file_source.cpp
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/storage/sqlite3.cpp
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/text/bidi.cpp
-        ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/text/local_glyph_rasterizer.cpp
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/util/async_task.cpp
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/util/compression.cpp
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/util/filesystem.cpp
@@ -60,6 +60,39 @@ target_sources(
         ${PROJECT_SOURCE_DIR}/platform/linux/src/gl_functions.cpp
 )
 
+if(MLN_WITH_FREETYPE)
+    find_package(Freetype)
+    pkg_search_module(FONTCONFIG fontconfig)
+    if(NOT FREETYPE_FOUND OR NOT FONTCONFIG_FOUND)
+        message(STATUS "FreeType or Fontconfig not found, local glyphs are disabled")
+    endif()
+endif()
+
+if(MLN_WITH_FREETYPE AND FREETYPE_FOUND AND FONTCONFIG_FOUND)
+    target_sources(
+        mbgl-core
+        PRIVATE
+            ${PROJECT_SOURCE_DIR}/platform/linux/src/local_glyph_rasterizer.cpp
+    )
+    target_include_directories(
+        mbgl-core
+        PRIVATE
+            ${FONTCONFIG_INCLUDE_DIRS}
+    )
+    target_link_libraries(
+        mbgl-core
+        PRIVATE
+            Freetype::Freetype
+            ${FONTCONFIG_LIBRARIES}
+    )
+else()
+    target_sources(
+        mbgl-core
+        PRIVATE
+            ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/text/local_glyph_rasterizer.cpp
+    )
+endif()
+
 if(MLN_WITH_EGL)
     find_package(OpenGL REQUIRED EGL)
     target_sources(
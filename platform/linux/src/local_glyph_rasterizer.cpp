@@ -0,0 +1,198 @@
+#include <mbgl/text/local_glyph_rasterizer.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/i18n.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <fontconfig/fontconfig.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace mbgl {
+
+namespace {
+
+// Offset GL JS applies to the top of locally generated glyphs, so that they
+// sit on the same baseline as glyphs from PBF ranges.
+constexpr int32_t topAdjustment = 27;
+
+bool containsWord(std::string name, const char* word) {
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+    return name.find(word) != std::string::npos;
+}
+
+// Same heuristic as GL JS, which picks the weight of local glyphs from the
+// names in the font stack.
+int getFontWeight(const FontStack& fontStack) {
+    for (const auto& name : fontStack) {
+        if (containsWord(name, "bold")) {
+            return FC_WEIGHT_BLACK;
+        }
+        if (containsWord(name, "medium")) {
+            return FC_WEIGHT_MEDIUM;
+        }
+        if (containsWord(name, "light")) {
+            return FC_WEIGHT_EXTRALIGHT;
+        }
+    }
+    return FC_WEIGHT_REGULAR;
+}
+
+} // namespace
+
+class LocalGlyphRasterizer::Impl {
+public:
+    struct Face {
+        FT_Face face = nullptr;
+    };
+
+    Impl(const std::optional<std::string>& fontFamily_);
+    ~Impl();
+
+    bool isConfigured() const { return fontFamily && library; }
+
+    // Returns the face matching the weight of the font stack, or nothing if
+    // no font could be loaded. Must be called with the mutex held.
+    const Face* getFace(const FontStack&);
+
+    // FreeType faces must not be used from several threads at once
+    std::mutex mutex;
+
+private:
+    std::optional<std::string> fontFamily;
+    FT_Library library = nullptr;
+    std::unordered_map<int, std::optional<Face>> faces;
+};
+
+LocalGlyphRasterizer::Impl::Impl(const std::optional<std::string>& fontFamily_)
+    : fontFamily(fontFamily_) {
+    if (fontFamily && FT_Init_FreeType(&library) != 0) {
+        Log::Error(Event::General, "Failed to initialize FreeType, local glyphs are disabled");
+        library = nullptr;
+    }
+}
+
+LocalGlyphRasterizer::Impl::~Impl() {
+    for (auto& entry : faces) {
+        if (entry.second) {
+            FT_Done_Face(entry.second->face);
+        }
+    }
+    if (library) {
+        FT_Done_FreeType(library);
+    }
+}
+
+const LocalGlyphRasterizer::Impl::Face* LocalGlyphRasterizer::Impl::getFace(const FontStack& fontStack) {
+    // A font file is used as is. A family name is resolved by Fontconfig,
+    // which may pick a different file for each weight.
+    const bool isFile = fontFamily->find('/') != std::string::npos;
+    const int weight = isFile ? FC_WEIGHT_REGULAR : getFontWeight(fontStack);
+
+    auto it = faces.find(weight);
+    if (it != faces.end()) {
+        return it->second ? &*it->second : nullptr;
+    }
+    auto& result = faces[weight];
+
+    std::string file = *fontFamily;
+    int index = 0;
+    if (!isFile) {
+        FcPattern* pattern = FcNameParse(reinterpret_cast<const FcChar8*>(fontFamily->c_str()));
+        if (!pattern) {
+            return nullptr;
+        }
+        FcPatternAddInteger(pattern, FC_WEIGHT, weight);
+        FcConfigSubstitute(nullptr, pattern, FcMatchPattern);
+        FcDefaultSubstitute(pattern);
+
+        FcResult matchResult;
+        FcPattern* match = FcFontMatch(nullptr, pattern, &matchResult);
+        FcPatternDestroy(pattern);
+        if (!match) {
+            return nullptr;
+        }
+        FcChar8* matchedFile = nullptr;
+        if (FcPatternGetString(match, FC_FILE, 0, &matchedFile) == FcResultMatch) {
+            file = reinterpret_cast<const char*>(matchedFile);
+        } else {
+            file.clear();
+        }
+        FcPatternGetInteger(match, FC_INDEX, 0, &index);
+        FcPatternDestroy(match);
+    }
+
+    FT_Face face = nullptr;
+    if (file.empty() || FT_New_Face(library, file.c_str(), index, &face) != 0) {
+        Log::Warning(Event::General, "Unable to load a font for local glyphs from " + *fontFamily);
+        return nullptr;
+    }
+    FT_Set_Pixel_Sizes(face, 0, util::ONE_EM);
+
+    result = Face{face};
+    return &*result;
+}
+
+LocalGlyphRasterizer::LocalGlyphRasterizer(const std::optional<std::string>& fontFamily)
+    : impl(std::make_unique<Impl>(fontFamily)) {}
+
+LocalGlyphRasterizer::~LocalGlyphRasterizer() = default;
+
+bool LocalGlyphRasterizer::canRasterizeGlyph(const FontStack& fontStack, GlyphID glyphID) {
+    if (!impl->isConfigured() || !util::i18n::allowsFixedWidthGlyphGeneration(glyphID)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    const auto* face = impl->getFace(fontStack);
+    return face && FT_Get_Char_Index(face->face, glyphID) != 0;
+}
+
+Glyph LocalGlyphRasterizer::rasterizeGlyph(const FontStack& fontStack, GlyphID glyphID) {
+    Glyph glyph;
+    glyph.id = glyphID;
+
+    if (!impl->isConfigured()) {
+        return glyph;
+    }
+
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    const auto* face = impl->getFace(fontStack);
+    if (!face) {
+        return glyph;
+    }
+
+    if (FT_Load_Char(face->face, glyphID, FT_LOAD_RENDER) != 0) {
+        return glyph;
+    }
+    const FT_GlyphSlot slot = face->face->glyph;
+    const FT_Bitmap& bitmap = slot->bitmap;
+    if (bitmap.pixel_mode != FT_PIXEL_MODE_GRAY) {
+        return glyph;
+    }
+
+    glyph.metrics.width = bitmap.width;
+    glyph.metrics.height = bitmap.rows;
+    glyph.metrics.left = slot->bitmap_left;
+    glyph.metrics.top = slot->bitmap_top - topAdjustment;
+    glyph.metrics.advance = static_cast<uint32_t>((slot->advance.x + 32) >> 6);
+
+    // Like glyphs from PBF ranges, the bitmap has a border for the SDF to
+    // spread into.
+    constexpr uint32_t border = Glyph::borderSize;
+    glyph.bitmap = AlphaImage({bitmap.width + 2 * border, bitmap.rows + 2 * border});
+    for (uint32_t row = 0; row < bitmap.rows; ++row) {
+        const uint8_t* source = bitmap.buffer + static_cast<std::ptrdiff_t>(row) * bitmap.pitch;
+        uint8_t* destination = glyph.bitmap.data.get() + (row + border) * glyph.bitmap.stride() + border;
+        std::memcpy(destination, source, bitmap.width);
+    }
+
+    return glyph;
+}
+
+} // namespace mbgl
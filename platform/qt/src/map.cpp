@@ -947,7 +947,7 @@ void Map::updateSource(const QString &id, const QVariantMap &params) {
         Error error;
         auto result = convert<mbgl::GeoJSON>(params["data"], error);
         if (result) {
-            sourceGeoJSON->setGeoJSON(*result);
+            sourceGeoJSON->setGeoJSON(std::move(*result));
         }
     }
 }
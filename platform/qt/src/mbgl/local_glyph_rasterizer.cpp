@@ -8,6 +8,8 @@
 #include <QtGui/QPainter>
 #include <qglobal.h>
 
+#include <mutex>
+
 namespace mbgl {
 
 class LocalGlyphRasterizer::Impl {
@@ -19,6 +21,9 @@ public:
     std::optional<std::string> fontFamily;
     QFont font;
     std::optional<QFontMetrics> metrics;
+
+    // QFont and QFontMetrics are not thread-safe
+    std::mutex mutex;
 };
 
 LocalGlyphRasterizer::Impl::Impl(const std::optional<std::string>& fontFamily_)
@@ -40,8 +45,11 @@ LocalGlyphRasterizer::LocalGlyphRasterizer(const std::optional<std::string>& fon
 LocalGlyphRasterizer::~LocalGlyphRasterizer() {}
 
 bool LocalGlyphRasterizer::canRasterizeGlyph(const FontStack&, GlyphID glyphID) {
-    return impl->isConfigured() && impl->metrics->inFont(glyphID) &&
-           util::i18n::allowsFixedWidthGlyphGeneration(glyphID);
+    if (!impl->isConfigured() || !util::i18n::allowsFixedWidthGlyphGeneration(glyphID)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    return impl->metrics->inFont(glyphID);
 }
 
 Glyph LocalGlyphRasterizer::rasterizeGlyph(const FontStack&, GlyphID glyphID) {
@@ -53,6 +61,8 @@ Glyph LocalGlyphRasterizer::rasterizeGlyph(const FontStack&, GlyphID glyphID) {
         return glyph;
     }
 
+    std::lock_guard<std::mutex> lock(impl->mutex);
+
 #if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
     glyph.metrics.width = impl->metrics->horizontalAdvance(glyphID);
 #else
@@ -96,6 +96,17 @@ struct FpsProbe {
     float tolerance = 0.0f;
 };
 
+// Average CPU time of the frames of an fps probe, in seconds. Recorded for
+// information only, it is not compared to expectations.
+struct FrameTimingsProbe {
+    double createRenderTree = 0.0;
+    double placement = 0.0;
+    double upload = 0.0;
+    double tweakers = 0.0;
+    double encoding = 0.0;
+    std::map<std::string, double> layers;
+};
+
 struct NetworkProbe {
     NetworkProbe() = default;
     NetworkProbe(size_t requests_, size_t transferred_)
@@ -132,12 +143,16 @@ struct GfxProbe {
 
 class TestMetrics {
 public:
-    bool isEmpty() const { return fileSize.empty() && memory.empty() && network.empty() && fps.empty() && gfx.empty(); }
+    bool isEmpty() const {
+        return fileSize.empty() && memory.empty() && network.empty() && fps.empty() && gfx.empty() &&
+               frameTimings.empty();
+    }
     std::map<std::string, FileSizeProbe> fileSize;
     std::map<std::string, MemoryProbe> memory;
     std::map<std::string, NetworkProbe> network;
     std::map<std::string, FpsProbe> fps;
     std::map<std::string, GfxProbe> gfx;
+    std::map<std::string, FrameTimingsProbe> frameTimings;
 };
 
 struct TestMetadata {
@@ -289,6 +289,32 @@ std::string serializeMetrics(const TestMetrics& metrics) {
         // End gfx section
     }
 
+    if (!metrics.frameTimings.empty()) {
+        // Start frame-timings section
+        writer.Key("frame-timings");
+        writer.StartArray();
+        for (const auto& timingsProbe : metrics.frameTimings) {
+            assert(!timingsProbe.first.empty());
+            const auto& timings = timingsProbe.second;
+            writer.StartArray();
+            writer.String(timingsProbe.first.c_str());
+            writer.Double(timings.createRenderTree);
+            writer.Double(timings.placement);
+            writer.Double(timings.upload);
+            writer.Double(timings.tweakers);
+            writer.Double(timings.encoding);
+            writer.StartObject();
+            for (const auto& layer : timings.layers) {
+                writer.Key(layer.first.c_str());
+                writer.Double(layer.second);
+            }
+            writer.EndObject();
+            writer.EndArray();
+        }
+        writer.EndArray();
+        // End frame-timings section
+    }
+
     writer.EndObject();
 
     return s.GetString();
@@ -1235,6 +1261,7 @@ TestOperations parseTestOperations(TestMetadata& metadata) {
 
                 map.flyTo(mbgl::CameraOptions().withCenter(endPos).withZoom(endZoom), animationOptions);
 
+                FrameTimingsProbe timings;
                 while (!transitionFinished) {
                     frames++;
                     frontend.renderOnce(map);
@@ -1242,6 +1269,16 @@ TestOperations parseTestOperations(TestMetadata& metadata) {
                     totalTime += frameTime;
 
                     samples.push_back(frameTime);
+
+                    const auto& frameTimings = frontend.getRenderer()->getFrameTimings();
+                    timings.createRenderTree += frameTimings.createRenderTree;
+                    timings.placement += frameTimings.placement;
+                    timings.upload += frameTimings.upload;
+                    timings.tweakers += frameTimings.tweakers;
+                    timings.encoding += frameTimings.encoding;
+                    for (const auto& layer : frameTimings.layers) {
+                        timings.layers[layer.id] += layer.encoding;
+                    }
                 }
 
                 float averageFps = totalTime > 0.0f ? frames / totalTime : 0.0f;
@@ -1256,6 +1293,21 @@ TestOperations parseTestOperations(TestMetadata& metadata) {
                 float minOnePcFps = sampleCount / minFrameTime;
 
                 ctx.getMetadata().metrics.fps.insert({mark, {averageFps, minOnePcFps, 0.0f}});
+
+                if (frames > 0) {
+                    const auto count = static_cast<double>(frames);
+                    for (auto* phase : {&timings.createRenderTree,
+                                        &timings.placement,
+                                        &timings.upload,
+                                        &timings.tweakers,
+                                        &timings.encoding}) {
+                        *phase /= count;
+                    }
+                    for (auto& layer : timings.layers) {
+                        layer.second /= count;
+                    }
+                    ctx.getMetadata().metrics.frameTimings.insert({mark, std::move(timings)});
+                }
                 return true;
             });
         } else if (operationArray[0].GetString() == gfxProbeStartOp) {
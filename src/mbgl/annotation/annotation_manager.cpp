@@ -14,6 +14,8 @@
 
 #include <boost/function_output_iterator.hpp>
 
+#include <algorithm>
+
 // Note: LayerManager::annotationsEnabled is defined
 // at compile time, so that linker (with LTO on) is able
 // to optimize out the unreachable code.
@@ -32,6 +34,21 @@ namespace mbgl {
 
 using namespace style;
 
+namespace {
+
+LatLngBounds symbolQueryBounds(const CanonicalTileID& tileID) {
+    LatLngBounds tileBounds(tileID);
+    // Hack for https://github.com/mapbox/mapbox-gl-native/issues/12472
+    // To handle precision issues, query a slightly larger area than the tile bounds
+    // Symbols at a border can be included in vector data for both tiles
+    // The rendering/querying logic will make sure the symbols show up in only one of the tiles
+    tileBounds.extend(LatLng(tileBounds.south() - 0.000000001, tileBounds.west() - 0.000000001));
+    tileBounds.extend(LatLng(tileBounds.north() + 0.000000001, tileBounds.east() + 0.000000001));
+    return tileBounds;
+}
+
+} // namespace
+
 const std::string AnnotationManager::SourceID = "com.mapbox.annotations";
 const std::string AnnotationManager::PointLayerID = "com.mapbox.annotations.points";
 const std::string AnnotationManager::ShapeLayerID = "com.mapbox.annotations.shape.";
@@ -67,6 +84,15 @@ bool AnnotationManager::updateAnnotation(const AnnotationID& id, const Annotatio
     return dirty;
 }
 
+bool AnnotationManager::updateAnnotations(const std::vector<std::pair<AnnotationID, Annotation>>& annotations) {
+    CHECK_ANNOTATIONS_ENABLED_AND_RETURN(true);
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& change : annotations) {
+        Annotation::visit(change.second, [&](const auto& annotation_) { this->update(change.first, annotation_); });
+    }
+    return dirty;
+}
+
 void AnnotationManager::removeAnnotation(const AnnotationID& id) {
     CHECK_ANNOTATIONS_ENABLED_AND_RETURN_NOARG();
     std::lock_guard<std::mutex> lock(mutex);
@@ -77,6 +103,7 @@ void AnnotationManager::removeAnnotation(const AnnotationID& id) {
 void AnnotationManager::add(const AnnotationID& id, const SymbolAnnotation& annotation) {
     auto impl = std::make_shared<SymbolAnnotationImpl>(id, annotation);
     symbolTree.insert(impl);
+    dirtySymbols.insert(impl);
     symbolAnnotations.emplace(id, impl);
 }
 
@@ -84,12 +111,14 @@ void AnnotationManager::add(const AnnotationID& id, const LineAnnotation& annota
     ShapeAnnotationImpl& impl =
         *shapeAnnotations.emplace(id, std::make_unique<LineAnnotationImpl>(id, annotation)).first->second;
     impl.updateStyle(*style.get().impl);
+    dirtyShapes.insert(id);
 }
 
 void AnnotationManager::add(const AnnotationID& id, const FillAnnotation& annotation) {
     ShapeAnnotationImpl& impl =
         *shapeAnnotations.emplace(id, std::make_unique<FillAnnotationImpl>(id, annotation)).first->second;
     impl.updateStyle(*style.get().impl);
+    dirtyShapes.insert(id);
 }
 
 void AnnotationManager::update(const AnnotationID& id, const SymbolAnnotation& annotation) {
@@ -116,6 +145,7 @@ void AnnotationManager::update(const AnnotationID& id, const LineAnnotation& ann
         return;
     }
 
+    invalidateShape(*it->second);
     shapeAnnotations.erase(it);
     add(id, annotation);
     dirty = true;
@@ -128,6 +158,7 @@ void AnnotationManager::update(const AnnotationID& id, const FillAnnotation& ann
         return;
     }
 
+    invalidateShape(*it->second);
     shapeAnnotations.erase(it);
     add(id, annotation);
     dirty = true;
@@ -137,16 +168,39 @@ void AnnotationManager::remove(const AnnotationID& id) {
     CHECK_ANNOTATIONS_ENABLED_AND_RETURN_NOARG();
     if (symbolAnnotations.find(id) != symbolAnnotations.end()) {
         symbolTree.remove(symbolAnnotations.at(id));
+        dirtySymbols.insert(symbolAnnotations.at(id));
         symbolAnnotations.erase(id);
     } else if (shapeAnnotations.find(id) != shapeAnnotations.end()) {
         auto it = shapeAnnotations.find(id);
         (void)*style.get().impl->removeLayer(it->second->layerID);
+        invalidateShape(*it->second);
         shapeAnnotations.erase(it);
     } else {
         assert(false); // Should never happen
     }
 }
 
+void AnnotationManager::invalidateShape(const ShapeAnnotationImpl& shape) {
+    for (const auto& tileID : shape.getTileIDs()) {
+        dirtyTiles.insert(tileID);
+    }
+}
+
+bool AnnotationManager::isTileDirty(const CanonicalTileID& tileID) {
+    if (dirtyTiles.count(tileID)) {
+        return true;
+    }
+
+    if (dirtySymbols.qbegin(boost::geometry::index::intersects(symbolQueryBounds(tileID))) != dirtySymbols.qend()) {
+        return true;
+    }
+
+    return std::any_of(dirtyShapes.begin(), dirtyShapes.end(), [&](const AnnotationID id) {
+        auto it = shapeAnnotations.find(id);
+        return it != shapeAnnotations.end() && it->second->hasTileData(tileID);
+    });
+}
+
 std::unique_ptr<AnnotationTileData> AnnotationManager::getTileData(const CanonicalTileID& tileID) {
     if (symbolAnnotations.empty() && shapeAnnotations.empty()) return nullptr;
 
@@ -154,16 +208,8 @@ std::unique_ptr<AnnotationTileData> AnnotationManager::getTileData(const Canonic
 
     auto pointLayer = tileData->addLayer(PointLayerID);
 
-    LatLngBounds tileBounds(tileID);
-    // Hack for https://github.com/mapbox/mapbox-gl-native/issues/12472
-    // To handle precision issues, query a slightly larger area than the tile bounds
-    // Symbols at a border can be included in vector data for both tiles
-    // The rendering/querying logic will make sure the symbols show up in only one of the tiles
-    tileBounds.extend(LatLng(tileBounds.south() - 0.000000001, tileBounds.west() - 0.000000001));
-    tileBounds.extend(LatLng(tileBounds.north() + 0.000000001, tileBounds.east() + 0.000000001));
-
     symbolTree.query(
-        boost::geometry::index::intersects(tileBounds),
+        boost::geometry::index::intersects(symbolQueryBounds(tileID)),
         boost::make_function_output_iterator([&](const auto& val) { val->updateLayer(tileID, *pointLayer); }));
 
     for (const auto& shape : shapeAnnotations) {
@@ -213,25 +259,54 @@ void AnnotationManager::updateStyle() {
 void AnnotationManager::updateData() {
     CHECK_ANNOTATIONS_ENABLED_AND_RETURN_NOARG();
     std::lock_guard<std::mutex> lock(mutex);
-    if (dirty) {
-        for (auto& tile : tiles) {
-            tile->setData(getTileData(tile->id.canonical));
+    if (!dirty) {
+        return;
+    }
+
+    // Tiles go from no data to data, or back, only when the first annotation
+    // is added or the last one removed
+    const bool empty = symbolAnnotations.empty() && shapeAnnotations.empty();
+    const bool updateAll = empty != tilesEmpty;
+
+    for (auto& tile : tiles) {
+        if (updateAll || isTileDirty(tile->id.canonical)) {
+            tile->setAnnotationData(getTileData(tile->id.canonical));
         }
-        dirty = false;
     }
+
+    dirtySymbols.clear();
+    dirtyShapes.clear();
+    dirtyTiles.clear();
+    tilesEmpty = empty;
+    dirty = false;
 }
 
 void AnnotationManager::addTile(AnnotationTile& tile) {
     CHECK_ANNOTATIONS_ENABLED_AND_RETURN_NOARG();
     std::lock_guard<std::mutex> lock(mutex);
     tiles.insert(&tile);
-    tile.setData(getTileData(tile.id.canonical));
+    tile.setAnnotationData(getTileData(tile.id.canonical));
 }
 
 void AnnotationManager::removeTile(AnnotationTile& tile) {
     CHECK_ANNOTATIONS_ENABLED_AND_RETURN_NOARG();
     std::lock_guard<std::mutex> lock(mutex);
     tiles.erase(&tile);
+
+    // Tiles of the same area in other world copies or at overscaled zoom
+    // levels share the cached shape features
+    const auto& tileID = tile.id.canonical;
+    if (std::none_of(tiles.begin(), tiles.end(), [&](const auto* other) { return other->id.canonical == tileID; })) {
+        for (const auto& shape : shapeAnnotations) {
+            shape.second->removeTileData(tileID);
+        }
+    }
+}
+
+std::vector<CanonicalTileID> AnnotationManager::getShapeTileIDs(const AnnotationID& id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = shapeAnnotations.find(id);
+    return it != shapeAnnotations.end() ? it->second->getTileIDs() : std::vector<CanonicalTileID>{};
 }
 
 // To ensure that annotation images do not collide with images from the style,
@@ -32,6 +32,9 @@ public:
 
     AnnotationID addAnnotation(const Annotation&);
     bool updateAnnotation(const AnnotationID&, const Annotation&);
+    // Applies all the updates at once, so that the tiles they touch are
+    // rebuilt only once
+    bool updateAnnotations(const std::vector<std::pair<AnnotationID, Annotation>>&);
     void removeAnnotation(const AnnotationID&);
 
     void addImage(std::unique_ptr<style::Image>);
@@ -52,6 +55,9 @@ public:
 
     mapbox::base::WeakPtr<AnnotationManager> makeWeakPtr() { return weakFactory.makeWeakPtr(); }
 
+    // For testing only. The tiles whose features of the shape are cached.
+    std::vector<CanonicalTileID> getShapeTileIDs(const AnnotationID&);
+
 private:
     void add(const AnnotationID&, const SymbolAnnotation&);
     void add(const AnnotationID&, const LineAnnotation&);
@@ -65,6 +71,9 @@ private:
 
     void updateStyle();
 
+    void invalidateShape(const ShapeAnnotationImpl&);
+    bool isTileDirty(const CanonicalTileID&);
+
     std::unique_ptr<AnnotationTileData> getTileData(const CanonicalTileID&);
 
     std::reference_wrapper<style::Style> style;
@@ -72,6 +81,8 @@ private:
     std::mutex mutex;
 
     bool dirty = false;
+    // Whether the tiles were last updated without any annotation
+    bool tilesEmpty = true;
 
     AnnotationID nextID = 0;
 
@@ -89,6 +100,13 @@ private:
     ShapeAnnotationMap shapeAnnotations;
     ImageMap images;
 
+    // What changed since the last updateData call: the symbols added and
+    // removed, the shapes added, and the tiles removed shapes were in. Only
+    // the tiles these touch are rebuilt.
+    SymbolAnnotationTree dirtySymbols;
+    std::unordered_set<AnnotationID> dirtyShapes;
+    std::unordered_set<CanonicalTileID> dirtyTiles;
+
     std::unordered_set<AnnotationTile*> tiles;
     mapbox::base::WeakPtrFactory<AnnotationManager> weakFactory{this};
 };
@@ -23,6 +23,11 @@ AnnotationTile::~AnnotationTile() {
     }
 }
 
+void AnnotationTile::setAnnotationData(std::unique_ptr<AnnotationTileData> data_) {
+    ++annotationDataUpdates;
+    setData(std::move(data_));
+}
+
 class AnnotationTileFeatureData {
 public:
     AnnotationTileFeatureData(const AnnotationID id_,
@@ -77,6 +82,9 @@ public:
 AnnotationTileLayer::AnnotationTileLayer(std::shared_ptr<AnnotationTileLayerData> layer_)
     : layer(std::move(layer_)) {}
 
+AnnotationTileLayer::AnnotationTileLayer(const std::string& name)
+    : layer(std::make_shared<AnnotationTileLayerData>(name)) {}
+
 std::size_t AnnotationTileLayer::featureCount() const {
     return layer->features.size();
 }
@@ -118,4 +126,8 @@ std::unique_ptr<AnnotationTileLayer> AnnotationTileData::addLayer(const std::str
     return std::make_unique<AnnotationTileLayer>(it->second);
 }
 
+void AnnotationTileData::addLayer(const AnnotationTileLayer& layer) {
+    layers[layer.layer->name] = layer.layer;
+}
+
 } // namespace mbgl
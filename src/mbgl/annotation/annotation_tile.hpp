@@ -7,6 +7,7 @@
 namespace mbgl {
 
 class AnnotationManager;
+class AnnotationTileData;
 class TileParameters;
 
 class AnnotationTile : public GeometryTile {
@@ -14,8 +15,15 @@ public:
     AnnotationTile(const OverscaledTileID&, const TileParameters&);
     ~AnnotationTile() override;
 
+    // Replaces the annotations of the tile, built by the manager
+    void setAnnotationData(std::unique_ptr<AnnotationTileData>);
+
+    // For testing only.
+    std::size_t getAnnotationDataUpdates() const { return annotationDataUpdates; }
+
 private:
     mapbox::base::WeakPtr<AnnotationManager> annotationManager;
+    std::size_t annotationDataUpdates = 0;
 };
 
 class AnnotationTileFeatureData;
@@ -39,6 +47,7 @@ class AnnotationTileLayerData;
 class AnnotationTileLayer : public GeometryTileLayer {
 public:
     AnnotationTileLayer(std::shared_ptr<AnnotationTileLayerData>);
+    explicit AnnotationTileLayer(const std::string& name);
 
     std::size_t featureCount() const override;
     std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override;
@@ -50,6 +59,7 @@ public:
                     std::unordered_map<std::string, std::string> properties = {{}});
 
 private:
+    friend class AnnotationTileData;
     std::shared_ptr<AnnotationTileLayerData> layer;
 };
 
@@ -59,6 +69,8 @@ public:
     std::unique_ptr<GeometryTileLayer> getLayer(const std::string&) const override;
 
     std::unique_ptr<AnnotationTileLayer> addLayer(const std::string&);
+    // Adds a layer built on its own, sharing its features rather than copying them
+    void addLayer(const AnnotationTileLayer&);
 
 private:
     std::unordered_map<std::string, std::shared_ptr<AnnotationTileLayerData>> layers;
@@ -16,9 +16,40 @@ ShapeAnnotationImpl::ShapeAnnotationImpl(const AnnotationID id_)
     : id(id_),
       layerID(AnnotationManager::ShapeLayerID + util::toString(id)) {}
 
+ShapeAnnotationImpl::~ShapeAnnotationImpl() = default;
+
 void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, AnnotationTileData& data) {
+    if (const auto* layer = getTileLayer(tileID)) {
+        data.addLayer(*layer);
+    }
+}
+
+bool ShapeAnnotationImpl::hasTileData(const CanonicalTileID& tileID) {
+    return getTileLayer(tileID) != nullptr;
+}
+
+std::vector<CanonicalTileID> ShapeAnnotationImpl::getTileIDs() const {
+    std::vector<CanonicalTileID> tileIDs;
+    for (const auto& tileLayer : tileLayers) {
+        if (tileLayer.second) {
+            tileIDs.push_back(tileLayer.first);
+        }
+    }
+    return tileIDs;
+}
+
+void ShapeAnnotationImpl::removeTileData(const CanonicalTileID& tileID) {
+    tileLayers.erase(tileID);
+}
+
+const AnnotationTileLayer* ShapeAnnotationImpl::getTileLayer(const CanonicalTileID& tileID) {
     static const double baseTolerance = 4;
 
+    auto it = tileLayers.find(tileID);
+    if (it != tileLayers.end()) {
+        return it->second.get();
+    }
+
     if (!shapeTiler) {
         mapbox::feature::feature_collection<double> features;
         features.emplace_back(ShapeAnnotationGeometry::visit(
@@ -33,10 +64,12 @@ void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, Annotati
         shapeTiler = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(features, options);
     }
 
+    auto& layer = tileLayers[tileID];
+
     const auto& shapeTile = shapeTiler->getTile(tileID.z, tileID.x, tileID.y);
-    if (shapeTile.features.empty()) return;
+    if (shapeTile.features.empty()) return nullptr;
 
-    auto layer = data.addLayer(layerID);
+    layer = std::make_unique<AnnotationTileLayer>(layerID);
 
     ToGeometryCollection toGeometryCollection;
     ToFeatureType toFeatureType;
@@ -53,6 +86,8 @@ void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, Annotati
 
         layer->addFeature(id, featureType, renderGeometry);
     }
+
+    return layer.get();
 }
 
 } // namespace mbgl
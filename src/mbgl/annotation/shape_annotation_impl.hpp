@@ -6,28 +6,44 @@
 #include <mbgl/annotation/annotation.hpp>
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/style/style.hpp>
+#include <mbgl/tile/tile_id.hpp>
 
 #include <string>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace mbgl {
 
 class AnnotationTileData;
-class CanonicalTileID;
+class AnnotationTileLayer;
 
 class ShapeAnnotationImpl {
 public:
     ShapeAnnotationImpl(AnnotationID);
-    virtual ~ShapeAnnotationImpl() = default;
+    virtual ~ShapeAnnotationImpl();
 
     virtual void updateStyle(style::Style::Impl &) const = 0;
     virtual const ShapeAnnotationGeometry &geometry() const = 0;
 
     void updateTileData(const CanonicalTileID &, AnnotationTileData &);
 
+    // Whether the shape has any features in the tile
+    bool hasTileData(const CanonicalTileID &);
+    // The tiles the shape has features in, among those it was clipped to
+    std::vector<CanonicalTileID> getTileIDs() const;
+    // Drops the cached features of a tile that is no longer in use
+    void removeTileData(const CanonicalTileID &);
+
     const AnnotationID id;
     const std::string layerID;
     std::unique_ptr<mapbox::geojsonvt::GeoJSONVT> shapeTiler;
+
+private:
+    const AnnotationTileLayer *getTileLayer(const CanonicalTileID &);
+
+    // Features of the shape clipped to each tile, or null if it has none there
+    std::unordered_map<CanonicalTileID, std::unique_ptr<AnnotationTileLayer>> tileLayers;
 };
 
 struct CloseShapeAnnotation {
@@ -56,6 +56,8 @@ public:
     }
 
     std::size_t elements() const { return v.size(); }
+    std::size_t capacity() const { return v.capacity(); }
+    void reserve(std::size_t n) { v.reserve(n); }
 
     std::size_t bytes() const { return v.size() * sizeof(uint16_t); }
 
@@ -1,22 +1,56 @@
 #include <mbgl/gfx/shader_group.hpp>
 #include <mbgl/gfx/shader.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <exception>
 
 namespace mbgl {
 namespace gfx {
 
 bool ShaderGroup::isShader(const std::string& shaderName) const noexcept {
     std::shared_lock<std::shared_mutex> readerLock(programLock);
-    return programs.find(shaderName) != programs.end();
+    return programs.find(shaderName) != programs.end() || factories.find(shaderName) != factories.end();
 }
 
-const std::shared_ptr<gfx::Shader> ShaderGroup::getShader(const std::string& shaderName) const noexcept {
+bool ShaderGroup::isShaderPending(const std::string& shaderName) const noexcept {
     std::shared_lock<std::shared_mutex> readerLock(programLock);
-    const auto it = programs.find(shaderName);
-    if (it == programs.end()) {
+    return factories.find(shaderName) != factories.end();
+}
+
+const std::shared_ptr<gfx::Shader> ShaderGroup::getShader(const std::string& shaderName) const noexcept {
+    {
+        std::shared_lock<std::shared_mutex> readerLock(programLock);
+        const auto it = programs.find(shaderName);
+        if (it != programs.end()) {
+            return it->second;
+        }
+        if (factories.find(shaderName) == factories.end()) {
+            return nullptr;
+        }
+    }
+
+    // Construct a deferred shader on first use. Another thread may have
+    // beaten us to it between releasing the reader lock and getting here.
+    std::unique_lock<std::shared_mutex> writerLock(programLock);
+    if (const auto it = programs.find(shaderName); it != programs.end()) {
+        return it->second;
+    }
+    const auto factory = factories.find(shaderName);
+    if (factory == factories.end()) {
         return nullptr;
     }
 
-    return it->second;
+    std::shared_ptr<gfx::Shader> shader;
+    try {
+        shader = factory->second();
+    } catch (const std::exception& e) {
+        Log::Error(Event::Shader, "Failed to create " + shaderName + ": " + e.what());
+    }
+    factories.erase(factory);
+    if (shader) {
+        programs.emplace(shaderName, shader);
+    }
+    return shader;
 }
 
 bool ShaderGroup::replaceShader(std::shared_ptr<gfx::Shader>&& shader) noexcept {
@@ -25,6 +59,12 @@ bool ShaderGroup::replaceShader(std::shared_ptr<gfx::Shader>&& shader) noexcept
 
 bool ShaderGroup::replaceShader(std::shared_ptr<Shader>&& shader, const std::string& shaderName) noexcept {
     std::unique_lock<std::shared_mutex> writerLock(programLock);
+    if (const auto factory = factories.find(shaderName); factory != factories.end()) {
+        // Replacing a shader which was never constructed, drop its factory
+        factories.erase(factory);
+        programs.emplace(shaderName, std::move(shader));
+        return true;
+    }
     if (programs.find(shaderName) == programs.end()) {
         return false;
     }
@@ -39,7 +79,7 @@ bool ShaderGroup::registerShader(std::shared_ptr<gfx::Shader>&& shader) noexcept
 
 bool ShaderGroup::registerShader(std::shared_ptr<Shader>&& shader, const std::string& shaderName) noexcept {
     std::unique_lock<std::shared_mutex> writerLock(programLock);
-    if (programs.find(shaderName) != programs.end()) {
+    if (programs.find(shaderName) != programs.end() || factories.find(shaderName) != factories.end()) {
         return false;
     }
 
@@ -47,5 +87,15 @@ bool ShaderGroup::registerShader(std::shared_ptr<Shader>&& shader, const std::st
     return true;
 }
 
+bool ShaderGroup::registerShaderFactory(ShaderFactory&& factory, const std::string& shaderName) noexcept {
+    std::unique_lock<std::shared_mutex> writerLock(programLock);
+    if (!factory || programs.find(shaderName) != programs.end() || factories.find(shaderName) != factories.end()) {
+        return false;
+    }
+
+    factories.emplace(shaderName, std::move(factory));
+    return true;
+}
+
 } // namespace gfx
 } // namespace mbgl
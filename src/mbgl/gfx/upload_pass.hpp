@@ -58,10 +58,11 @@ public:
         return {v.elements(), createVertexBufferResource(v.data(), v.bytes(), usage)};
     }
 
+    // Uploads the vertices changed since the last upload, see updateVertexBufferRanges
     template <class Vertex>
     void updateVertexBuffer(VertexBuffer<Vertex>& buffer, const VertexVector<Vertex>& v) {
         assert(v.elements() == buffer.elements);
-        updateVertexBufferResource(buffer.getResource(), v.data(), v.bytes());
+        updateVertexBufferRanges(buffer.getResource(), v);
     }
 
     template <class DrawMode>
@@ -92,7 +93,25 @@ protected:
     virtual std::unique_ptr<VertexBufferResource> createVertexBufferResource(const void* data,
                                                                              std::size_t size,
                                                                              BufferUsageType) = 0;
-    virtual void updateVertexBufferResource(VertexBufferResource&, const void* data, std::size_t size) = 0;
+    // Writes `size` bytes of `data` at `offset` bytes into the buffer
+    virtual void updateVertexBufferResource(VertexBufferResource&,
+                                            const void* data,
+                                            std::size_t size,
+                                            std::size_t offset) = 0;
+
+    // Uploads the dirty ranges of the vector, or all of it if it has none
+    void updateVertexBufferRanges(VertexBufferResource& resource, const VertexVectorBase& v) {
+        const auto* data = static_cast<const std::uint8_t*>(v.getRawData());
+        const std::size_t stride = v.getRawSize();
+        if (v.getDirtyRanges().empty()) {
+            updateVertexBufferResource(resource, data, v.getRawCount() * stride, 0);
+            return;
+        }
+        for (const auto& [start, end] : v.getDirtyRanges()) {
+            assert(end <= v.getRawCount());
+            updateVertexBufferResource(resource, data + start * stride, (end - start) * stride, start * stride);
+        }
+    }
 
 public:
     virtual std::unique_ptr<IndexBufferResource> createIndexBufferResource(const void* data,
@@ -2,7 +2,10 @@
 
 #include <mbgl/util/ignore.hpp>
 
+#include <algorithm>
+#include <cassert>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace mbgl {
@@ -19,6 +22,7 @@ public:
     VertexVectorBase(VertexVectorBase&& other)
         : buffer(std::move(other.buffer)),
           dirty(other.dirty),
+          dirtyRanges(std::move(other.dirtyRanges)),
           released(other.released) {}
     virtual ~VertexVectorBase() = default;
 
@@ -30,13 +34,51 @@ public:
     void setBuffer(std::unique_ptr<VertexBufferBase>&& value) { buffer = std::move(value); }
 
     bool getDirty() const { return dirty; }
-    void setDirty(bool value = true) { dirty = value; }
+    void setDirty(bool value = true) {
+        dirty = value;
+        dirtyRanges.clear();
+    }
+
+    // Marks the elements in [start, end) as changed. As long as the rest of
+    // the vector is unchanged since it was last uploaded, only the changed
+    // ranges need to be uploaded.
+    void setDirtyRange(std::size_t start, std::size_t end) {
+        if (start == end || (dirty && dirtyRanges.empty())) {
+            // The whole vector is to be uploaded already
+            return;
+        }
+        dirty = true;
+
+        for (auto& range : dirtyRanges) {
+            if (start <= range.second && range.first <= end) {
+                range = {std::min(start, range.first), std::max(end, range.second)};
+                return;
+            }
+        }
+        dirtyRanges.emplace_back(start, end);
+
+        // Past a few ranges, one larger upload is cheaper than many small ones
+        if (dirtyRanges.size() > maxDirtyRanges) {
+            auto all = dirtyRanges.front();
+            for (const auto& range : dirtyRanges) {
+                all = {std::min(all.first, range.first), std::max(all.second, range.second)};
+            }
+            dirtyRanges = {all};
+        }
+    }
+
+    // The ranges of elements changed since the last upload, or none if the
+    // whole vector is to be uploaded
+    const std::vector<std::pair<std::size_t, std::size_t>>& getDirtyRanges() const { return dirtyRanges; }
 
     bool isReleased() const { return released; }
 
 protected:
+    static constexpr std::size_t maxDirtyRanges = 16;
+
     std::unique_ptr<VertexBufferBase> buffer;
     bool dirty = true;
+    std::vector<std::pair<std::size_t, std::size_t>> dirtyRanges;
     bool released = false;
 };
 using VertexVectorBasePtr = std::shared_ptr<VertexVectorBase>;
@@ -62,12 +104,19 @@ public:
 
     void extend(std::size_t n, const Vertex& val) {
         v.resize(v.size() + n, val);
-        dirty = true;
+        setDirty();
+    }
+
+    // Sets the vertices in [start, end), marking only them as changed
+    void fill(std::size_t start, std::size_t end, const Vertex& vertex) {
+        assert(start <= end && end <= v.size());
+        std::fill(v.begin() + start, v.begin() + end, vertex);
+        setDirtyRange(start, end);
     }
 
     Vertex& at(std::size_t n) {
         assert(n < v.size());
-        dirty = true;
+        setDirty();
         return v.at(n);
     }
     const Vertex& at(std::size_t n) const {
@@ -76,13 +125,15 @@ public:
     }
 
     std::size_t elements() const { return v.size(); }
+    std::size_t capacity() const { return v.capacity(); }
+    void reserve(std::size_t n) { v.reserve(n); }
 
     std::size_t bytes() const { return v.size() * sizeof(Vertex); }
 
     bool empty() const { return v.empty(); }
 
     void clear() {
-        dirty = true;
+        setDirty();
         v.clear();
     }
 
@@ -73,6 +73,14 @@ Context::Context(RendererBackend& backend_)
       stats() {}
 
 Context::~Context() noexcept {
+#if MLN_DRAWABLE_RENDERER
+    if (uniformBufferAllocator && !cleanupOnDestruction) {
+        uniformBufferAllocator->abandon();
+    }
+    // Uniform buffers that outlive the context no longer reach the allocator
+    uniformBufferAllocator.reset();
+#endif
+
     if (cleanupOnDestruction) {
         reset();
         assert(stats.isZero());
@@ -485,7 +493,10 @@ gfx::UniqueDrawableBuilder Context::createDrawableBuilder(std::string name) {
 }
 
 gfx::UniformBufferPtr Context::createUniformBuffer(const void* data, std::size_t size) {
-    return std::make_shared<gl::UniformBufferGL>(data, size);
+    if (!uniformBufferAllocator) {
+        uniformBufferAllocator = std::make_shared<UniformBufferAllocator>();
+    }
+    return std::make_shared<gl::UniformBufferGL>(data, size, uniformBufferAllocator);
 }
 
 gfx::ShaderProgramBasePtr Context::getGenericShader(gfx::ShaderRegistry& shaders, const std::string& name) {
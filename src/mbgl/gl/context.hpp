@@ -29,6 +29,7 @@ namespace gl {
 constexpr size_t TextureMax = 64;
 using ProcAddress = void (*)();
 class RendererBackend;
+class UniformBufferAllocator;
 
 namespace extension {
 class VertexArray;
@@ -134,6 +135,10 @@ private:
     gfx::RenderingStats stats;
     std::unique_ptr<extension::Debugging> debugging;
 
+#if MLN_DRAWABLE_RENDERER
+    std::shared_ptr<UniformBufferAllocator> uniformBufferAllocator;
+#endif
+
 public:
     State<value::ActiveTextureUnit> activeTextureUnit;
     State<value::BindFramebuffer> bindFramebuffer;
@@ -27,6 +27,19 @@ void DrawableGL::draw(PaintParameters& parameters) const {
         return;
     }
 
+    drawBatched(parameters, nullptr);
+    endBatch(parameters);
+}
+
+bool DrawableGL::isBatchCompatible(const DrawableGL& other) const {
+    return !isCustom && !other.isCustom && shader && shader == other.shader && textures == other.textures;
+}
+
+void DrawableGL::drawBatched(PaintParameters& parameters, const DrawableGL* previous) const {
+    if (isCustom) {
+        return;
+    }
+
     auto& context = static_cast<gl::Context&>(parameters.context);
 
     if (shader) {
@@ -60,7 +73,9 @@ void DrawableGL::draw(PaintParameters& parameters) const {
     context.setCullFaceMode(getCullFaceMode());
 
     bindUniformBuffers();
-    bindTextures();
+    if (!previous || !isBatchCompatible(*previous)) {
+        bindTextures();
+    }
 
     for (const auto& seg : impl->segments) {
         const auto& glSeg = static_cast<DrawSegmentGL&>(*seg);
@@ -70,7 +85,14 @@ void DrawableGL::draw(PaintParameters& parameters) const {
             context.draw(glSeg.getMode(), mlSeg.indexOffset, mlSeg.indexLength);
         }
     }
+}
 
+void DrawableGL::endBatch(PaintParameters& parameters) const {
+    if (isCustom) {
+        return;
+    }
+
+    auto& context = static_cast<gl::Context&>(parameters.context);
     context.bindVertexArray = value::BindVertexArray::Default;
 
     unbindTextures();
@@ -95,6 +95,8 @@ void TileLayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters)
     const auto debugGroupRender = parameters.encoder->createDebugGroup(label_render.c_str());
 #endif
 
+    // Consecutive drawables with the same program and textures keep the texture bindings
+    const DrawableGL* previous = nullptr;
     visitDrawables([&](gfx::Drawable& drawable) {
         if (!drawable.getEnabled() || !drawable.hasRenderPass(parameters.pass)) {
             return;
@@ -113,6 +115,12 @@ void TileLayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters)
             tweaker->execute(drawable, parameters);
         }
 
+        const auto& drawableGL = static_cast<const DrawableGL&>(drawable);
+        if (previous && !drawableGL.isBatchCompatible(*previous)) {
+            previous->endBatch(parameters);
+            previous = nullptr;
+        }
+
         // For layer groups with 3D features, enable either the single-value
         // stencil mode for features with stencil enabled or disable stenciling.
         // 2D drawables will set their own stencil mode within `draw`.
@@ -120,8 +128,13 @@ void TileLayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters)
             context.setStencilMode(drawable.getEnableStencil() ? stencilMode3d : gfx::StencilMode::disabled());
         }
 
-        drawable.draw(parameters);
+        drawableGL.drawBatched(parameters, previous);
+        previous = &drawableGL;
     });
+
+    if (previous) {
+        previous->endBatch(parameters);
+    }
 }
 
 LayerGroupGL::LayerGroupGL(int32_t layerIndex_, std::size_t initialCapacity, std::string name_)
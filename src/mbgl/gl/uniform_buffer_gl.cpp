@@ -4,13 +4,179 @@
 #include <mbgl/util/compression.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 namespace mbgl {
 namespace gl {
 
 using namespace platform;
 
+namespace {
+// Size of each shared buffer object
+constexpr std::size_t chunkSize = 256 * 1024;
+// Larger uniform buffers get their own buffer object
+constexpr std::size_t maxSuballocationSize = 4 * 1024;
+// Past this many disjoint dirty ranges, a chunk is uploaded in one span covering them
+constexpr std::size_t maxDirtyRanges = 8;
+// Dirty ranges closer than this are uploaded together, the gap being cheaper than another call
+constexpr std::size_t dirtyRangeGap = 256;
+} // namespace
+
+UniformBufferAllocator::~UniformBufferAllocator() {
+    for (auto& chunk : chunks) {
+        deleteChunk(chunk);
+    }
+}
+
+std::size_t UniformBufferAllocator::getAlignment() {
+    if (!alignment) {
+        GLint value = 0;
+        MBGL_CHECK_ERROR(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &value));
+        alignment = static_cast<std::size_t>(std::max<GLint>(value, 16));
+    }
+    return alignment;
+}
+
+std::size_t UniformBufferAllocator::getBufferCount() const {
+    return std::count_if(chunks.begin(), chunks.end(), [](const auto& chunk) { return chunk.id != 0; });
+}
+
+void UniformBufferAllocator::createChunk(Chunk& chunk) {
+    chunk.shadow.assign(chunkSize, 0);
+    MBGL_CHECK_ERROR(glGenBuffers(1, &chunk.id));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, chunk.id));
+    MBGL_CHECK_ERROR(glBufferData(GL_UNIFORM_BUFFER, chunkSize, chunk.shadow.data(), GL_DYNAMIC_DRAW));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+}
+
+void UniformBufferAllocator::deleteChunk(Chunk& chunk) {
+    if (chunk.id) {
+        MBGL_CHECK_ERROR(glDeleteBuffers(1, &chunk.id));
+    }
+    chunk = {};
+}
+
+void UniformBufferAllocator::abandon() {
+    chunks.clear();
+    freeRanges.clear();
+    current = 0;
+}
+
+std::optional<UniformBufferAllocator::Range> UniformBufferAllocator::allocate(std::size_t size) {
+    if (size == 0 || size > maxSuballocationSize) {
+        return std::nullopt;
+    }
+
+    const auto align = getAlignment();
+    const auto alignedSize = (size + align - 1) / align * align;
+
+    if (auto it = freeRanges.find(alignedSize); it != freeRanges.end() && !it->second.empty()) {
+        auto result = it->second.back();
+        it->second.pop_back();
+        result.size = size;
+        chunks[result.chunk].live++;
+        return result;
+    }
+
+    if (chunks.empty() || chunks[current].used + alignedSize > chunkSize) {
+        // Reuse the slot of a deleted chunk, if any, so that indices stay stable
+        const auto slot = std::find_if(chunks.begin(), chunks.end(), [](const auto& chunk) { return !chunk.id; });
+        current = static_cast<std::size_t>(slot - chunks.begin());
+        if (slot == chunks.end()) {
+            chunks.emplace_back();
+        }
+        createChunk(chunks[current]);
+    }
+
+    auto& chunk = chunks[current];
+    const Range result{current, chunk.used, size};
+    chunk.used += alignedSize;
+    chunk.live++;
+    return result;
+}
+
+void UniformBufferAllocator::release(const Range& range) {
+    assert(range.chunk < chunks.size() && chunks[range.chunk].live > 0);
+    auto& chunk = chunks[range.chunk];
+    if (--chunk.live > 0) {
+        const auto align = getAlignment();
+        const auto alignedSize = (range.size + align - 1) / align * align;
+        freeRanges[alignedSize].push_back(range);
+        return;
+    }
+
+    // The chunk is empty: forget its free ranges, and either start over in it
+    // or give it back if ranges are being carved from another one
+    for (auto& free : freeRanges) {
+        auto& ranges = free.second;
+        ranges.erase(std::remove_if(
+                         ranges.begin(), ranges.end(), [&](const auto& other) { return other.chunk == range.chunk; }),
+                     ranges.end());
+    }
+    if (range.chunk == current) {
+        chunk.used = 0;
+    } else {
+        deleteChunk(chunk);
+    }
+}
+
+bool UniformBufferAllocator::write(const Range& range, const void* data, std::size_t size) {
+    assert(range.chunk < chunks.size() && size <= range.size);
+    auto& chunk = chunks[range.chunk];
+    auto* dest = chunk.shadow.data() + range.offset;
+    if (std::memcmp(dest, data, size) == 0) {
+        return false;
+    }
+    std::memcpy(dest, data, size);
+    markDirty(chunk, range.offset, range.offset + size);
+    return true;
+}
+
+void UniformBufferAllocator::markDirty(Chunk& chunk, std::size_t begin, std::size_t end) {
+    auto& ranges = chunk.dirtyRanges;
+    for (auto& range : ranges) {
+        if (begin <= range.second + dirtyRangeGap && range.first <= end + dirtyRangeGap) {
+            range = {std::min(begin, range.first), std::max(end, range.second)};
+            return;
+        }
+    }
+    ranges.emplace_back(begin, end);
+
+    if (ranges.size() > maxDirtyRanges) {
+        auto all = ranges.front();
+        for (const auto& range : ranges) {
+            all = {std::min(all.first, range.first), std::max(all.second, range.second)};
+        }
+        ranges = {all};
+    }
+}
+
+std::size_t UniformBufferAllocator::getDirtyRangeCount(std::size_t chunk) const {
+    return chunk < chunks.size() ? chunks[chunk].dirtyRanges.size() : 0;
+}
+
+void UniformBufferAllocator::copy(const Range& from, const Range& to) {
+    assert(from.size == to.size);
+    write(to, chunks[from.chunk].shadow.data() + from.offset, from.size);
+}
+
+void UniformBufferAllocator::bind(const Range& range, int32_t binding) {
+    assert(range.chunk < chunks.size());
+    auto& chunk = chunks[range.chunk];
+    if (!chunk.dirtyRanges.empty()) {
+        MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, chunk.id));
+        for (const auto& [begin, end] : chunk.dirtyRanges) {
+            MBGL_CHECK_ERROR(glBufferSubData(GL_UNIFORM_BUFFER, begin, end - begin, chunk.shadow.data() + begin));
+        }
+        MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+        chunk.dirtyRanges.clear();
+    }
+    MBGL_CHECK_ERROR(
+        glBindBufferRange(GL_UNIFORM_BUFFER, static_cast<GLuint>(binding), chunk.id, range.offset, range.size));
+}
+
 UniformBufferGL::UniformBufferGL(const void* data_, std::size_t size_)
     : UniformBuffer(size_),
       hash(util::crc32(data_, size_)) {
@@ -20,7 +186,50 @@ UniformBufferGL::UniformBufferGL(const void* data_, std::size_t size_)
     MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
 }
 
+UniformBufferGL::UniformBufferGL(const void* data_,
+                                 std::size_t size_,
+                                 const std::shared_ptr<UniformBufferAllocator>& allocator_)
+    : UniformBuffer(size_),
+      hash(0),
+      range(allocator_->allocate(size_)) {
+    if (range) {
+        allocator = allocator_;
+        allocator_->write(*range, data_, size_);
+    } else {
+        hash = util::crc32(data_, size_);
+        MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+        MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, id));
+        MBGL_CHECK_ERROR(glBufferData(GL_UNIFORM_BUFFER, size, data_, GL_DYNAMIC_DRAW));
+        MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+    }
+}
+
+UniformBufferGL::UniformBufferGL(const UniformBufferGL& other)
+    : UniformBuffer(other),
+      hash(other.hash),
+      allocator(other.allocator) {
+    if (auto shared = allocator.lock(); shared && other.range) {
+        range = shared->allocate(size);
+        assert(range);
+        shared->copy(*other.range, *range);
+    }
+}
+
+UniformBufferGL::UniformBufferGL(UniformBufferGL&& other)
+    : UniformBuffer(std::move(other)),
+      id(other.id),
+      hash(other.hash),
+      allocator(std::move(other.allocator)),
+      range(std::move(other.range)) {
+    other.id = 0;
+    other.range.reset();
+}
+
 UniformBufferGL::~UniformBufferGL() {
+    if (auto shared = allocator.lock(); shared && range) {
+        shared->release(*range);
+    }
+    range.reset();
     if (id) {
         MBGL_CHECK_ERROR(glDeleteBuffers(1, &id));
         id = 0;
@@ -36,6 +245,13 @@ void UniformBufferGL::update(const void* data_, std::size_t size_) {
         return;
     }
 
+    if (range) {
+        if (auto shared = allocator.lock()) {
+            shared->write(*range, data_, size_);
+        }
+        return;
+    }
+
     const uint32_t newHash = util::crc32(data_, size_);
     if (newHash != hash) {
         hash = newHash;
@@ -45,5 +261,15 @@ void UniformBufferGL::update(const void* data_, std::size_t size_) {
     }
 }
 
+void UniformBufferGL::bind(int32_t binding) const {
+    if (range) {
+        if (auto shared = allocator.lock()) {
+            shared->bind(*range, binding);
+        }
+    } else {
+        MBGL_CHECK_ERROR(glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(binding), id));
+    }
+}
+
 } // namespace gl
 } // namespace mbgl
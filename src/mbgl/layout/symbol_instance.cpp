@@ -1,5 +1,8 @@
 #include <mbgl/layout/symbol_instance.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
+
+#include <cassert>
+#include <limits>
 #include <utility>
 
 namespace mbgl {
@@ -99,7 +102,6 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
                                const SymbolContent iconType)
     : sharedData(std::move(sharedData_)),
       anchor(anchor_),
-      symbolContent(iconType),
       // Create the collision features that will be used to check whether this
       // symbol instance can be placed As a collision approximation, we can use
       // either the vertical or any of the horizontal versions of the feature
@@ -114,20 +116,24 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
                            textRotation),
       iconCollisionFeature(
           sharedData->line, anchor, shapedIcon, iconBoxScale, iconPadding, indexedFeature, iconRotation),
-      writingModes(WritingModeType::None),
-      layoutFeatureIndex(layoutFeatureIndex_),
-      dataFeatureIndex(dataFeatureIndex_),
+      key(std::move(key_)),
+      keyHash(std::hash<std::u16string>()(key)),
       textOffset(textOffset_),
       iconOffset(iconOffset_),
-      key(std::move(key_)),
-      textBoxScale(textBoxScale_),
       variableTextOffset(variableTextOffset_),
+      layoutFeatureIndex(static_cast<uint32_t>(layoutFeatureIndex_)),
+      dataFeatureIndex(static_cast<uint32_t>(dataFeatureIndex_)),
+      textBoxScale(textBoxScale_),
+      symbolContent(iconType),
+      writingModes(WritingModeType::None),
       singleLine(shapedTextOrientations.singleLine) {
+    assert(layoutFeatureIndex_ <= std::numeric_limits<uint32_t>::max());
+    assert(dataFeatureIndex_ <= std::numeric_limits<uint32_t>::max());
     // 'hasText' depends on finding at least one glyph in the shaping that's also in the GlyphPositionMap
     if (!sharedData->empty()) symbolContent |= SymbolContent::Text;
     if (allowVerticalPlacement && shapedTextOrientations.vertical) {
         const float verticalPointLabelAngle = 90.0f;
-        verticalTextCollisionFeature = CollisionFeature(line(),
+        verticalTextCollisionFeature = std::make_unique<CollisionFeature>(line(),
                                                         anchor,
                                                         shapedTextOrientations.vertical,
                                                         textBoxScale_,
@@ -137,7 +143,7 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
                                                         overscaling,
                                                         textRotation + verticalPointLabelAngle);
         if (verticallyShapedIcon) {
-            verticalIconCollisionFeature = CollisionFeature(sharedData->line,
+            verticalIconCollisionFeature = std::make_unique<CollisionFeature>(sharedData->line,
                                                             anchor,
                                                             verticallyShapedIcon,
                                                             iconBoxScale,
@@ -147,11 +153,11 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
         }
     }
 
-    rightJustifiedGlyphQuadsSize = sharedData->rightJustifiedGlyphQuads.size();
-    centerJustifiedGlyphQuadsSize = sharedData->centerJustifiedGlyphQuads.size();
-    leftJustifiedGlyphQuadsSize = sharedData->leftJustifiedGlyphQuads.size();
-    verticalGlyphQuadsSize = sharedData->verticalGlyphQuads.size();
-    iconQuadsSize = sharedData->iconQuads ? sharedData->iconQuads->size() : 0;
+    rightJustifiedGlyphQuadsSize = static_cast<uint32_t>(sharedData->rightJustifiedGlyphQuads.size());
+    centerJustifiedGlyphQuadsSize = static_cast<uint32_t>(sharedData->centerJustifiedGlyphQuads.size());
+    leftJustifiedGlyphQuadsSize = static_cast<uint32_t>(sharedData->leftJustifiedGlyphQuads.size());
+    verticalGlyphQuadsSize = static_cast<uint32_t>(sharedData->verticalGlyphQuads.size());
+    iconQuadsSize = sharedData->iconQuads ? static_cast<uint32_t>(sharedData->iconQuads->size()) : 0u;
 
     if (rightJustifiedGlyphQuadsSize || centerJustifiedGlyphQuadsSize || leftJustifiedGlyphQuadsSize) {
         writingModes |= WritingModeType::Horizontal;
@@ -213,10 +219,29 @@ void SymbolInstance::releaseSharedData() {
     sharedData.reset();
 }
 
-std::optional<size_t> SymbolInstance::getDefaultHorizontalPlacedTextIndex() const {
+std::optional<uint32_t> SymbolInstance::getDefaultHorizontalPlacedTextIndex() const {
     if (placedRightTextIndex) return placedRightTextIndex;
     if (placedCenterTextIndex) return placedCenterTextIndex;
     if (placedLeftTextIndex) return placedLeftTextIndex;
     return std::nullopt;
 }
+
+std::size_t SymbolInstance::getMemoryUsage() const {
+    const auto featureUsage = [](const CollisionFeature& feature) {
+        return feature.boxes.capacity() * sizeof(CollisionBox);
+    };
+    std::size_t usage = sizeof(SymbolInstance) + featureUsage(textCollisionFeature) +
+                        featureUsage(iconCollisionFeature);
+    if (verticalTextCollisionFeature) {
+        usage += sizeof(CollisionFeature) + featureUsage(*verticalTextCollisionFeature);
+    }
+    if (verticalIconCollisionFeature) {
+        usage += sizeof(CollisionFeature) + featureUsage(*verticalIconCollisionFeature);
+    }
+    // Keys short enough for the small string buffer have no heap allocation
+    if (key.capacity() > std::u16string().capacity()) {
+        usage += (key.capacity() + 1) * sizeof(char16_t);
+    }
+    return usage;
+}
 } // namespace mbgl
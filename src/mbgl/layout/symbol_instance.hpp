@@ -6,6 +6,8 @@
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 #include <mbgl/util/bitmask_operations.hpp>
 
+#include <memory>
+
 namespace mbgl {
 
 class Anchor;
@@ -77,7 +79,7 @@ public:
                    bool allowVerticalPlacement,
                    SymbolContent iconType = SymbolContent::None);
 
-    std::optional<size_t> getDefaultHorizontalPlacedTextIndex() const;
+    std::optional<uint32_t> getDefaultHorizontalPlacedTextIndex() const;
     const GeometryCoordinates& line() const;
     const SymbolQuads& rightJustifiedGlyphQuads() const;
     const SymbolQuads& leftJustifiedGlyphQuads() const;
@@ -94,36 +96,43 @@ private:
     std::shared_ptr<SymbolInstanceSharedData> sharedData;
 
 public:
+    // Members are ordered by size to avoid padding, and indices and counts
+    // are 32-bit: a bucket holds far fewer than 2^32 symbols or quads.
     Anchor anchor;
-    SymbolContent symbolContent;
-
-    std::size_t rightJustifiedGlyphQuadsSize;
-    std::size_t centerJustifiedGlyphQuadsSize;
-    std::size_t leftJustifiedGlyphQuadsSize;
-    std::size_t verticalGlyphQuadsSize;
-    std::size_t iconQuadsSize;
-
     CollisionFeature textCollisionFeature;
     CollisionFeature iconCollisionFeature;
-    std::optional<CollisionFeature> verticalTextCollisionFeature = std::nullopt;
-    std::optional<CollisionFeature> verticalIconCollisionFeature = std::nullopt;
-    WritingModeType writingModes;
-    std::size_t layoutFeatureIndex; // Index into the set of features included at layout time
-    std::size_t dataFeatureIndex;   // Index into the underlying tile data feature set
+    // Only set for symbols that can be placed vertically, so kept out of line
+    std::unique_ptr<CollisionFeature> verticalTextCollisionFeature;
+    std::unique_ptr<CollisionFeature> verticalIconCollisionFeature;
+    std::u16string key;
+    // Hash of `key`, computed once at layout time for cross-tile matching
+    std::size_t keyHash;
     std::array<float, 2> textOffset;
     std::array<float, 2> iconOffset;
-    std::u16string key;
-    bool isDuplicate;
-    std::optional<size_t> placedRightTextIndex;
-    std::optional<size_t> placedCenterTextIndex;
-    std::optional<size_t> placedLeftTextIndex;
-    std::optional<size_t> placedVerticalTextIndex;
-    std::optional<size_t> placedIconIndex;
-    std::optional<size_t> placedVerticalIconIndex;
-    float textBoxScale;
     std::array<float, 2> variableTextOffset;
-    bool singleLine;
+    std::optional<uint32_t> placedRightTextIndex;
+    std::optional<uint32_t> placedCenterTextIndex;
+    std::optional<uint32_t> placedLeftTextIndex;
+    std::optional<uint32_t> placedVerticalTextIndex;
+    std::optional<uint32_t> placedIconIndex;
+    std::optional<uint32_t> placedVerticalIconIndex;
+
+    uint32_t rightJustifiedGlyphQuadsSize;
+    uint32_t centerJustifiedGlyphQuadsSize;
+    uint32_t leftJustifiedGlyphQuadsSize;
+    uint32_t verticalGlyphQuadsSize;
+    uint32_t iconQuadsSize;
+
+    uint32_t layoutFeatureIndex; // Index into the set of features included at layout time
+    uint32_t dataFeatureIndex;   // Index into the underlying tile data feature set
     uint32_t crossTileID = 0;
+    float textBoxScale;
+    SymbolContent symbolContent;
+    WritingModeType writingModes;
+    bool singleLine;
+
+    // Approximate memory held by this instance, including its out of line data
+    std::size_t getMemoryUsage() const;
 
     static constexpr uint32_t invalidCrossTileID() { return std::numeric_limits<uint32_t>::max(); }
 };
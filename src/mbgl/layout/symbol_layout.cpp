@@ -7,6 +7,7 @@
 #include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/text/get_anchors.hpp>
 #include <mbgl/text/shaping.hpp>
+#include <mbgl/text/shaping_cache.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/util/utf.hpp>
@@ -374,7 +375,7 @@ void SymbolLayout::prepareSymbols(const GlyphMap& glyphMap,
                                     WritingModeType writingMode,
                                     SymbolAnchorType textAnchor,
                                     TextJustifyType textJustify) {
-                Shaping result = getShaping(
+                Shaping result = ShapingCache::get().getShaping(
                     /* string */ formattedText,
                     /* maxWidth: ems */
                     isPointPlacement ? layout->evaluate<TextMaxWidth>(zoom, feature, canonicalID) * util::ONE_EM : 0.0f,
@@ -826,7 +827,7 @@ void SymbolLayout::createBucket(const ImagePositions&,
                                                       writingMode,
                                                       symbolInstance.line(),
                                                       std::vector<float>());
-                index = iconBuffer.placedSymbols.size() - 1;
+                index = static_cast<uint32_t>(iconBuffer.placedSymbols.size() - 1);
                 PlacedSymbol& iconSymbol = iconBuffer.placedSymbols.back();
                 iconSymbol.angle = (allowVerticalPlacement && writingMode == WritingModeType::Vertical)
                                        ? static_cast<float>(M_PI_2)
@@ -851,7 +852,7 @@ void SymbolLayout::createBucket(const ImagePositions&,
         if (hasText && feature.formattedText) {
             std::optional<std::size_t> lastAddedSection;
             if (singleLine) {
-                std::optional<std::size_t> placedTextIndex;
+                std::optional<uint32_t> placedTextIndex;
                 lastAddedSection = addSymbolGlyphQuads(*bucket,
                                                        symbolInstance,
                                                        feature,
@@ -940,7 +941,7 @@ std::size_t SymbolLayout::addSymbolGlyphQuads(SymbolBucket& bucket,
                                               SymbolInstance& symbolInstance,
                                               const SymbolFeature& feature,
                                               WritingModeType writingMode,
-                                              std::optional<size_t>& placedIndex,
+                                              std::optional<uint32_t>& placedIndex,
                                               const SymbolQuads& glyphQuads,
                                               const CanonicalTileID& canonical,
                                               std::optional<std::size_t> lastAddedSection) {
@@ -957,7 +958,7 @@ std::size_t SymbolLayout::addSymbolGlyphQuads(SymbolBucket& bucket,
                                            symbolInstance.line(),
                                            calculateTileDistances(symbolInstance.line(), symbolInstance.anchor),
                                            placedIconIndex);
-    placedIndex = bucket.text.placedSymbols.size() - 1;
+    placedIndex = static_cast<uint32_t>(bucket.text.placedSymbols.size() - 1);
     PlacedSymbol& placedSymbol = bucket.text.placedSymbols.back();
     placedSymbol.angle = (allowVerticalPlacement && writingMode == WritingModeType::Vertical)
                              ? static_cast<float>(M_PI_2)
@@ -1096,11 +1097,7 @@ size_t SymbolLayout::addSymbols(SymbolBucket::Buffer& buffer,
 }
 
 void SymbolLayout::addToDebugBuffers(SymbolBucket& bucket) {
-    if (!hasSymbolInstances()) {
-        return;
-    }
-
-    for (const SymbolInstance& symbolInstance : symbolInstances) {
+    for (const SymbolInstance& symbolInstance : bucket.symbolInstances) {
         auto populateCollisionBox = [&](const auto& feature, bool isText) {
             SymbolBucket::CollisionBuffer& collisionBuffer =
                 feature.alongLine
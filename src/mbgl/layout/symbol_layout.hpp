@@ -101,7 +101,7 @@ private:
                                     SymbolInstance&,
                                     const SymbolFeature&,
                                     WritingModeType,
-                                    std::optional<size_t>& placedIndex,
+                                    std::optional<uint32_t>& placedIndex,
                                     const SymbolQuads&,
                                     const CanonicalTileID& canonical,
                                     std::optional<std::size_t> lastAddedSection = std::nullopt);
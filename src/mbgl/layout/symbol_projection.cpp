@@ -114,6 +114,40 @@ PointAndCameraDistance project(const Point<float>& point, const mat4& matrix) {
     return {{static_cast<float>(pos[0] / pos[3]), static_cast<float>(pos[1] / pos[3])}, static_cast<float>(pos[3])};
 }
 
+void LineProjectionCache::reset(const GeometryCoordinates& line_, const mat4& matrix) {
+    line = &line_;
+    rows = {{matrix[0], matrix[4], matrix[12], matrix[1], matrix[5], matrix[13], matrix[3], matrix[7], matrix[15]}};
+    projected.resize(line->size());
+    projectedBlocks.assign((line->size() + blockSize - 1) / blockSize, false);
+    projectedCount = 0;
+}
+
+const PointAndCameraDistance& LineProjectionCache::at(std::size_t index) {
+    assert(line && index < line->size());
+    const std::size_t block = index / blockSize;
+    if (!projectedBlocks[block]) {
+        projectBlock(block);
+    }
+    return projected[index];
+}
+
+void LineProjectionCache::projectBlock(std::size_t block) {
+    const std::size_t begin = block * blockSize;
+    const std::size_t end = std::min(begin + blockSize, line->size());
+    const GeometryCoordinate* points = line->data();
+    // Same arithmetic as project(), without the terms multiplied by z = 0
+    for (std::size_t i = begin; i < end; ++i) {
+        const double x = static_cast<float>(points[i].x);
+        const double y = static_cast<float>(points[i].y);
+        const double w = rows[6] * x + rows[7] * y + rows[8];
+        projected[i] = {{static_cast<float>((rows[0] * x + rows[1] * y + rows[2]) / w),
+                         static_cast<float>((rows[3] * x + rows[4] * y + rows[5]) / w)},
+                        static_cast<float>(w)};
+    }
+    projectedBlocks[block] = true;
+    projectedCount += end - begin;
+}
+
 float evaluateSizeForFeature(const ZoomEvaluatedSize& zoomEvaluatedSize, const PlacedSymbol& placedSymbol) {
     if (zoomEvaluatedSize.isFeatureConstant) {
         return zoomEvaluatedSize.size;
@@ -185,6 +219,7 @@ std::optional<PlacedGlyph> placeGlyphAlongLine(const float offsetX,
                                                const GeometryCoordinates& line,
                                                const std::vector<float>& tileDistances,
                                                const mat4& labelPlaneMatrix,
+                                               LineProjectionCache& projectionCache,
                                                const bool returnTileDistance) {
     const float combinedOffsetX = flip ? offsetX - lineOffsetX : offsetX + lineOffsetX;
 
@@ -218,7 +253,7 @@ std::optional<PlacedGlyph> placeGlyphAlongLine(const float offsetX,
         }
 
         prev = current;
-        PointAndCameraDistance projection = project(convertPoint<float>(line.at(currentIndex)), labelPlaneMatrix);
+        const PointAndCameraDistance& projection = projectionCache.at(currentIndex);
         if (projection.second > 0) {
             current = projection.first;
         } else {
@@ -262,6 +297,7 @@ std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(const
                                                                           const Point<float>& tileAnchorPoint,
                                                                           const PlacedSymbol& symbol,
                                                                           const mat4& labelPlaneMatrix,
+                                                                          LineProjectionCache& projectionCache,
                                                                           const bool returnTileDistance) {
     if (symbol.glyphOffsets.empty()) {
         assert(false);
@@ -282,6 +318,7 @@ std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(const
                                                                       symbol.line,
                                                                       symbol.tileDistances,
                                                                       labelPlaneMatrix,
+                                                                      projectionCache,
                                                                       returnTileDistance);
     if (!firstPlacedGlyph) return {};
 
@@ -295,6 +332,7 @@ std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(const
                                                                      symbol.line,
                                                                      symbol.tileDistances,
                                                                      labelPlaneMatrix,
+                                                                     projectionCache,
                                                                      returnTileDistance);
     if (!lastPlacedGlyph) return {};
 
@@ -332,6 +370,7 @@ PlacementResult placeGlyphsAlongLine(const PlacedSymbol& symbol,
                                      const mat4& posMatrix,
                                      const mat4& labelPlaneMatrix,
                                      const mat4& glCoordMatrix,
+                                     LineProjectionCache& projectionCache,
                                      gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttributes>>& dynamicVertexArray,
                                      const Point<float>& projectedAnchorPoint,
                                      const float aspectRatio) {
@@ -350,6 +389,7 @@ PlacementResult placeGlyphsAlongLine(const PlacedSymbol& symbol,
             symbol.anchorPoint,
             symbol,
             labelPlaneMatrix,
+            projectionCache,
             false);
         if (!firstAndLastGlyph) {
             return PlacementResult::NotEnoughRoom;
@@ -380,6 +420,7 @@ PlacementResult placeGlyphsAlongLine(const PlacedSymbol& symbol,
                                                    symbol.line,
                                                    symbol.tileDistances,
                                                    labelPlaneMatrix,
+                                                   projectionCache,
                                                    false);
             if (placedGlyph) {
                 placedGlyphs.push_back(*placedGlyph);
@@ -420,6 +461,7 @@ PlacementResult placeGlyphsAlongLine(const PlacedSymbol& symbol,
                                                                      symbol.line,
                                                                      symbol.tileDistances,
                                                                      labelPlaneMatrix,
+                                                                     projectionCache,
                                                                      false);
         if (!singleGlyph) return PlacementResult::NotEnoughRoom;
 
@@ -458,6 +500,7 @@ void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttrib
 
     dynamicVertexArray.clear();
 
+    LineProjectionCache projectionCache;
     bool useVertical = false;
 
     for (auto& placedSymbol : placedSymbols) {
@@ -489,6 +532,7 @@ void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttrib
         const float pitchScaledFontSize = pitchWithMap ? fontSize * perspectiveRatio : fontSize / perspectiveRatio;
 
         const Point<float> anchorPoint = project(placedSymbol.anchorPoint, labelPlaneMatrix).first;
+        projectionCache.reset(placedSymbol.line, labelPlaneMatrix);
 
         PlacementResult placeUnflipped = placeGlyphsAlongLine(placedSymbol,
                                                               pitchScaledFontSize,
@@ -497,6 +541,7 @@ void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttrib
                                                               posMatrix,
                                                               labelPlaneMatrix,
                                                               glCoordMatrix,
+                                                              projectionCache,
                                                               dynamicVertexArray,
                                                               anchorPoint,
                                                               state.getSize().aspectRatio());
@@ -512,6 +557,7 @@ void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttrib
                                   posMatrix,
                                   labelPlaneMatrix,
                                   glCoordMatrix,
+                                  projectionCache,
                                   dynamicVertexArray,
                                   anchorPoint,
                                   state.getSize().aspectRatio()) == PlacementResult::NotEnoughRoom)) {
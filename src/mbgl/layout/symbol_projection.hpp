@@ -3,6 +3,7 @@
 #include <mbgl/util/mat4.hpp>
 #include <mbgl/gfx/vertex_buffer.hpp>
 #include <mbgl/programs/symbol_program.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
 
 namespace mbgl {
 
@@ -48,6 +49,34 @@ mat4 getGlCoordMatrix(
 using PointAndCameraDistance = std::pair<Point<float>, float>;
 PointAndCameraDistance project(const Point<float>& point, const mat4& matrix);
 
+// Vertices of a label's line projected into the label plane. All glyphs of a
+// label walk over the same vertices, so each vertex is projected once per
+// label rather than once per glyph. Vertices are projected lazily, in blocks
+// of consecutive points.
+class LineProjectionCache {
+public:
+    static constexpr std::size_t blockSize = 4;
+
+    // Drops the projections of the previous label, keeping the storage
+    void reset(const GeometryCoordinates& line, const mat4& matrix);
+
+    // Returns the projection of the vertex at `index` of the line
+    const PointAndCameraDistance& at(std::size_t index);
+
+    // Number of vertices projected since the last reset
+    std::size_t projectedVertices() const { return projectedCount; }
+
+private:
+    void projectBlock(std::size_t block);
+
+    const GeometryCoordinates* line = nullptr;
+    // Rows of the matrix producing x, y and w, for z = 0 and w = 1
+    std::array<double, 9> rows{};
+    std::vector<PointAndCameraDistance> projected;
+    std::vector<bool> projectedBlocks;
+    std::size_t projectedCount = 0;
+};
+
 void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttributes>>&,
                          const std::vector<PlacedSymbol>&,
                          const mat4& posMatrix,
@@ -58,6 +87,8 @@ void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttrib
                          const SymbolSizeBinder& sizeBinder,
                          const TransformState&);
 
+// `projectionCache` must have been reset to the line of the symbol and the
+// label plane matrix.
 std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(float fontScale,
                                                                           float lineOffsetX,
                                                                           float lineOffsetY,
@@ -66,6 +97,7 @@ std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(float
                                                                           const Point<float>& tileAnchorPoint,
                                                                           const PlacedSymbol& symbol,
                                                                           const mat4& labelPlaneMatrix,
+                                                                          LineProjectionCache& projectionCache,
                                                                           bool returnTileDistance);
 
 void hideGlyphs(std::size_t numGlyphs,
@@ -477,6 +477,14 @@ void Map::updateAnnotation(AnnotationID id, const Annotation& annotation) {
     }
 }
 
+void Map::updateAnnotations(const std::vector<std::pair<AnnotationID, Annotation>>& annotations) {
+    if (LayerManager::annotationsEnabled) {
+        if (impl->annotationManager.updateAnnotations(annotations)) {
+            impl->onUpdate();
+        }
+    }
+}
+
 void Map::removeAnnotation(AnnotationID annotation) {
     if (LayerManager::annotationsEnabled) {
         impl->annotationManager.removeAnnotation(annotation);
@@ -64,8 +64,11 @@ std::unique_ptr<gfx::VertexBufferResource> UploadPass::createVertexBufferResourc
     return std::make_unique<VertexBufferResource>(commandEncoder.context.createBuffer(data, size, usage));
 }
 
-void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource, const void* data, std::size_t size) {
-    static_cast<VertexBufferResource&>(resource).get().update(data, size, /*offset=*/0);
+void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource,
+                                            const void* data,
+                                            std::size_t size,
+                                            std::size_t offset) {
+    static_cast<VertexBufferResource&>(resource).get().update(data, size, offset);
 }
 
 std::unique_ptr<gfx::IndexBufferResource> UploadPass::createIndexBufferResource(const void* data,
@@ -128,7 +131,7 @@ const gfx::UniqueVertexBufferResource& UploadPass::getBuffer(const gfx::VertexVe
             // If it's changed, update it
             if (rawBufSize <= resource.getSizeInBytes()) {
                 if (vec->getDirty()) {
-                    updateVertexBufferResource(resource, rawBufPtr, rawBufSize);
+                    updateVertexBufferRanges(resource, *vec);
                     vec->setDirty(false);
                 }
                 return rawData->resource;
@@ -24,8 +24,10 @@ Programs::~Programs() = default;
 /// programParameters_ ProgramParameters used to initialize each instance
 template <typename... T>
 void registerTypes(gfx::ShaderRegistry& registry, const ProgramParameters& programParameters_) {
-    /// The following fold expression will create a shared_ptr for every type
-    /// in the parameter pack and register it with the shader registry.
+    /// The following fold expression will register a factory for every type
+    /// in the parameter pack with the shader registry. Programs are only
+    /// constructed when first requested, so permutations that the style never
+    /// uses cost nothing.
 
     /// Registration calls are wrapped in a lambda that throws on registration
     /// failure, we shouldn't expect registration to faill unless the shader
@@ -35,7 +37,9 @@ void registerTypes(gfx::ShaderRegistry& registry, const ProgramParameters& progr
             if (!expr) {
                 throw std::runtime_error("Failed to register " + std::string(T::Name) + " with shader registry!");
             }
-        }(registry.getLegacyGroup().registerShader(std::make_shared<T>(programParameters_))),
+        }(registry.getLegacyGroup().registerShaderFactory(
+            [programParameters_]() -> std::shared_ptr<gfx::Shader> { return std::make_shared<T>(programParameters_); },
+            std::string(T::Name))),
         ...);
 }
 
@@ -16,7 +16,10 @@
 #pragma warning(pop)
 #endif
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <limits>
 
 namespace mapbox {
 namespace util {
@@ -36,7 +39,27 @@ namespace mbgl {
 
 using namespace style;
 
-struct GeometryTooLongException : std::exception {};
+namespace {
+
+// Vertices a segment can index
+constexpr std::size_t maxSegmentVertices = std::numeric_limits<uint16_t>::max();
+constexpr uint32_t noIndex = std::numeric_limits<uint32_t>::max();
+
+// Scratch buffers of the worker thread for polygons split across segments,
+// kept across polygons and tiles so that they are not reallocated for each
+// polygon
+struct SplitPolygonBuffers {
+    // Vertices of the polygon, and their index in the current segment
+    std::vector<GeometryCoordinate> points;
+    std::vector<uint32_t> segmentIndices;
+};
+
+SplitPolygonBuffers& getSplitPolygonBuffers() {
+    thread_local SplitPolygonBuffers buffers;
+    return buffers;
+}
+
+} // namespace
 
 FillBucket::FillBucket(const FillBucket::PossiblyEvaluatedLayoutProperties&,
                        const std::map<std::string, Immutable<style::LayerProperties>>& layerPaintProperties,
@@ -67,7 +90,15 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
 
         for (const auto& ring : polygon) {
             totalVertices += ring.size();
-            if (totalVertices > std::numeric_limits<uint16_t>::max()) throw GeometryTooLongException();
+        }
+
+        const std::vector<uint32_t> indices = mapbox::earcut(polygon);
+        assert(indices.size() % 3 == 0);
+
+        if (totalVertices > maxSegmentVertices) {
+            auto& buffers = getSplitPolygonBuffers();
+            addSplitPolygon(polygon, indices, buffers.points, buffers.segmentIndices);
+            continue;
         }
 
         std::size_t startVertices = vertices.elements();
@@ -77,8 +108,7 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
 
             if (nVertices == 0) continue;
 
-            if (lineSegments.empty() ||
-                lineSegments.back().vertexLength + nVertices > std::numeric_limits<uint16_t>::max()) {
+            if (!canAppend(lineSegments, nVertices)) {
                 lineSegments.emplace_back(vertices.elements(), lines.elements());
             }
 
@@ -98,13 +128,9 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
             lineSegment.indexLength += nVertices * 2;
         }
 
-        std::vector<uint32_t> indices = mapbox::earcut(polygon);
-
         std::size_t nIndicies = indices.size();
-        assert(nIndicies % 3 == 0);
 
-        if (triangleSegments.empty() ||
-            triangleSegments.back().vertexLength + totalVertices > std::numeric_limits<uint16_t>::max()) {
+        if (!canAppend(triangleSegments, totalVertices, startVertices)) {
             triangleSegments.emplace_back(startVertices, triangles.elements());
         }
 
@@ -132,6 +158,85 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
     }
 }
 
+bool FillBucket::canAppend(const SegmentVector<FillAttributes>& segments,
+                           std::size_t count,
+                           std::optional<std::size_t> start) const {
+    if (segments.empty()) {
+        return false;
+    }
+    // The vertices of a segment are contiguous, which split polygons break
+    const auto& segment = segments.back();
+    return segment.vertexOffset + segment.vertexLength == start.value_or(vertices.elements()) &&
+           segment.vertexLength + count <= maxSegmentVertices;
+}
+
+void FillBucket::addSplitPolygon(const GeometryCollection& polygon,
+                                 const std::vector<uint32_t>& indices,
+                                 std::vector<GeometryCoordinate>& points,
+                                 std::vector<uint32_t>& segmentIndices) {
+    // The outline, in pieces that fit a segment and share their end vertex
+    for (const auto& ring : polygon) {
+        const std::size_t nVertices = ring.size();
+
+        if (nVertices == 0) continue;
+
+        // Position nVertices closes the ring
+        for (std::size_t start = 0;; start += maxSegmentVertices - 1) {
+            const std::size_t end = std::min(start + maxSegmentVertices, nVertices + 1);
+            const std::size_t count = end - start;
+
+            if (!canAppend(lineSegments, count)) {
+                lineSegments.emplace_back(vertices.elements(), lines.elements());
+            }
+
+            auto& lineSegment = lineSegments.back();
+            const auto lineIndex = static_cast<uint16_t>(lineSegment.vertexLength);
+
+            vertices.emplace_back(FillProgram::layoutVertex(ring[start]));
+            for (std::size_t i = 1; i < count; i++) {
+                vertices.emplace_back(FillProgram::layoutVertex(ring[(start + i) % nVertices]));
+                lines.emplace_back(static_cast<uint16_t>(lineIndex + i - 1), static_cast<uint16_t>(lineIndex + i));
+            }
+
+            lineSegment.vertexLength += count;
+            lineSegment.indexLength += (count - 1) * 2;
+
+            if (end == nVertices + 1) break;
+        }
+    }
+
+    // The triangles, each segment with a copy of the vertices it uses
+    points.clear();
+    for (const auto& ring : polygon) {
+        points.insert(points.end(), ring.begin(), ring.end());
+    }
+    segmentIndices.assign(points.size(), noIndex);
+
+    std::size_t segmentVertices = maxSegmentVertices;
+    for (std::size_t i = 0; i < indices.size(); i += 3) {
+        if (segmentVertices + 3 > maxSegmentVertices) {
+            triangleSegments.emplace_back(vertices.elements(), triangles.elements());
+            std::fill(segmentIndices.begin(), segmentIndices.end(), noIndex);
+            segmentVertices = 0;
+        }
+
+        std::array<uint16_t, 3> corners;
+        for (std::size_t j = 0; j < 3; j++) {
+            auto& segmentIndex = segmentIndices[indices[i + j]];
+            if (segmentIndex == noIndex) {
+                segmentIndex = static_cast<uint32_t>(segmentVertices++);
+                vertices.emplace_back(FillProgram::layoutVertex(points[indices[i + j]]));
+            }
+            corners[j] = static_cast<uint16_t>(segmentIndex);
+        }
+        triangles.emplace_back(corners[0], corners[1], corners[2]);
+
+        auto& triangleSegment = triangleSegments.back();
+        triangleSegment.vertexLength = segmentVertices;
+        triangleSegment.indexLength += 3;
+    }
+}
+
 void FillBucket::upload([[maybe_unused]] gfx::UploadPass& uploadPass) {
 #if MLN_LEGACY_RENDERER
     if (!uploaded) {
@@ -8,6 +8,7 @@
 #include <mbgl/programs/fill_program.hpp>
 #include <mbgl/style/layers/fill_layer_properties.hpp>
 
+#include <optional>
 #include <vector>
 
 namespace mbgl {
@@ -62,6 +63,21 @@ public:
 #endif // MLN_LEGACY_RENDERER
 
     std::map<std::string, FillProgram::Binders> paintPropertyBinders;
+
+private:
+    // Whether the last segment can take `count` vertices added from `start`,
+    // by default the end of the vertices
+    bool canAppend(const SegmentVector<FillAttributes>&,
+                   std::size_t count,
+                   std::optional<std::size_t> start = std::nullopt) const;
+
+    // Adds a polygon with more vertices than a segment can index. Its outline
+    // and triangles are split across segments, which duplicates the vertices
+    // they share.
+    void addSplitPolygon(const GeometryCollection& polygon,
+                         const std::vector<uint32_t>& indices,
+                         std::vector<GeometryCoordinate>& points,
+                         std::vector<uint32_t>& segmentIndices);
 };
 
 } // namespace mbgl
@@ -4,7 +4,9 @@
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/constants.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 #include <utility>
 
 namespace mbgl {
@@ -101,6 +103,230 @@ private:
     double total;
 };
 
+namespace {
+
+// Resolves the join of a middle vertex from the join of the layer and the
+// miter length.
+LineJoinType resolveJoin(LineJoinType join, double miterLength, float miterLimit, float roundLimit) {
+    if (join == LineJoinType::Round) {
+        if (miterLength < roundLimit) {
+            join = LineJoinType::Miter;
+        } else if (miterLength <= 2) {
+            join = LineJoinType::FakeRound;
+        }
+    }
+
+    if (join == LineJoinType::Miter && miterLength > miterLimit) {
+        join = LineJoinType::Bevel;
+    }
+
+    if (join == LineJoinType::Bevel) {
+        // The maximum extrude length is 128 / 63 = 2 times the width of
+        // the line so if miterLength >= 2 we need to draw a different
+        // type of bevel here.
+        if (miterLength > 2) {
+            join = LineJoinType::FlipBevel;
+        }
+
+        // If the miterLength is really small and the line bevel wouldn't be visible,
+        // just draw a miter join to save a triangle.
+        if (miterLength < miterLimit) {
+            join = LineJoinType::Miter;
+        }
+    }
+
+    return join;
+}
+
+// Pick the number of triangles for approximating round join by based on the
+// angle between normals.
+unsigned roundJoinTriangles(double cosHalfAngle) {
+    // Approximate angle from cosine.
+    const double approxAngle = 2 * std::sqrt(2 - 2 * cosHalfAngle);
+    return static_cast<unsigned>(::round((approxAngle * 180 / M_PI) / DEG_PER_TRIANGLE));
+}
+
+// Reserves room for `count` more elements while keeping the geometric growth
+// of the vector, so that reserving for each line stays amortized.
+template <class Vector>
+void reserveMore(Vector& vector, std::size_t count) {
+    const std::size_t size = vector.elements() + count;
+    if (size > vector.capacity()) {
+        vector.reserve(std::max(size, 2 * vector.capacity()));
+    }
+}
+
+} // namespace
+
+// The normals and joins of the vertices of a line. They are computed for the
+// whole line up front over flat arrays, which the compiler can vectorize, with
+// the same operations as one vertex at a time so that the results are equal.
+// Kept for each worker thread along with the triangle store, so that adding a
+// line does not allocate.
+class LineBucket::Extrusion {
+public:
+    void computeJoins(const GeometryCoordinates& coordinates, std::size_t first, std::size_t len, bool closed) {
+        // Index of the next vertex, where a closed line continues with its
+        // second vertex and an open line ends.
+        const auto nextIndex = [&](std::size_t i) {
+            return closed && i == len - 1 ? first + 1 : i + 1;
+        };
+
+        indices.clear();
+        for (std::size_t i = first; i < len; ++i) {
+            // if two consecutive vertices exist, skip the current one
+            const std::size_t next = nextIndex(i);
+            if (next < len && coordinates[i] == coordinates[next]) {
+                continue;
+            }
+            indices.push_back(i);
+        }
+
+        const std::size_t count = indices.size();
+        for (auto* values : {&prevX, &prevY, &nextX, &nextY, &joinX, &joinY, &cosAngle, &cosHalfAngle, &miterLength}) {
+            values->resize(count);
+        }
+
+        // Calculate the normal towards the next vertex in this line. The last
+        // vertex of an open line has none.
+        const std::size_t normals = closed ? count : count - 1;
+        for (std::size_t k = 0; k < normals; ++k) {
+            const std::size_t i = indices[k];
+            const auto normal = util::perp(
+                util::unit(convertPoint<double>(coordinates[nextIndex(i)] - coordinates[i])));
+            nextX[k] = normal.x;
+            nextY[k] = normal.y;
+        }
+
+        // In case there is no next vertex, pretend that the line is continuing
+        // straight, meaning that we are just using the previous normal.
+        if (!closed) {
+            nextX[count - 1] = nextX[count - 2];
+            nextY[count - 1] = nextY[count - 2];
+        }
+
+        // A closed line starts from its last segment. Otherwise, this is the
+        // beginning of a non-closed line, so we're doing a straight "join".
+        if (closed) {
+            const auto normal = util::perp(
+                util::unit(convertPoint<double>(coordinates[first] - coordinates[len - 2])));
+            prevX[0] = normal.x;
+            prevY[0] = normal.y;
+        } else {
+            prevX[0] = nextX[0];
+            prevY[0] = nextY[0];
+        }
+        std::copy(nextX.begin(), nextX.end() - 1, prevX.begin() + 1);
+        std::copy(nextY.begin(), nextY.end() - 1, prevY.begin() + 1);
+
+        // Determine the normal of the join extrusion. It is the angle bisector
+        // of the segments between the previous line and the next line.
+        // In the case of 180° angles, the prev and next normals cancel each
+        // other out: prevNormal + nextNormal = (0, 0), its magnitude is 0, so
+        // the unit vector would be undefined. In that case, we're keeping the
+        // joinNormal at (0, 0), so that the cosHalfAngle below will also become
+        // 0 and miterLength will become Infinity.
+        for (std::size_t k = 0; k < count; ++k) {
+            const auto joinNormal = util::unit(Point<double>(prevX[k], prevY[k]) + Point<double>(nextX[k], nextY[k]));
+            joinX[k] = joinNormal.x;
+            joinY[k] = joinNormal.y;
+        }
+
+        /*  joinNormal     prevNormal
+         *             ↖      ↑
+         *                .________. prevVertex
+         *                |
+         * nextNormal  ←  |  currentVertex
+         *                |
+         *     nextVertex !
+         *
+         */
+
+        // Calculate cosines of the angle (and its half) using dot product.
+        // Calculate the length of the miter (the ratio of the miter to the width)
+        // as the inverse of cosine of the angle between next and join normals.
+        for (std::size_t k = 0; k < count; ++k) {
+            cosAngle[k] = prevX[k] * nextX[k] + prevY[k] * nextY[k];
+            cosHalfAngle[k] = joinX[k] * nextX[k] + joinY[k] * nextY[k];
+            miterLength[k] = cosHalfAngle[k] != 0 ? 1 / cosHalfAngle[k] : std::numeric_limits<double>::infinity();
+        }
+    }
+
+    // The number of vertices the joins and caps add, so that the buffers can
+    // be reserved once for the line. Restarts of the line distance are not
+    // counted, and the segment before a sharp corner is measured before the
+    // previous corner shortened it.
+    std::size_t countVertices(const GeometryCoordinates& coordinates,
+                              std::size_t len,
+                              bool closed,
+                              LineJoinType joinType,
+                              float miterLimit,
+                              float roundLimit,
+                              LineCapType beginCap,
+                              LineCapType endCap,
+                              double sharpCornerOffset) const {
+        std::size_t vertices = 0;
+        const std::size_t last = indices.size() - 1;
+        for (std::size_t k = 0; k <= last; ++k) {
+            const bool startOfLine = k == 0;
+            const bool hasNext = closed || k < last;
+            const bool middleVertex = (closed || !startOfLine) && hasNext;
+
+            if (middleVertex && cosHalfAngle[k] < COS_HALF_SHARP_CORNER) {
+                const std::size_t i = indices[k];
+                if (!startOfLine &&
+                    util::dist<double>(coordinates[i], coordinates[indices[k - 1]]) > 2.0 * sharpCornerOffset) {
+                    vertices += 2;
+                }
+                if (i < len - 1 && util::dist<double>(coordinates[i], coordinates[i + 1]) > 2 * sharpCornerOffset) {
+                    vertices += 2;
+                }
+            }
+
+            // A butt closes and starts a segment with a pair of vertices, and a
+            // round cap or join adds another pair on each side.
+            const std::size_t pairs = (startOfLine ? 0 : 2) + (hasNext ? 2 : 0);
+            if (middleVertex) {
+                switch (resolveJoin(joinType, miterLength[k], miterLimit, roundLimit)) {
+                    case LineJoinType::Miter:
+                        vertices += 2;
+                        break;
+                    case LineJoinType::FlipBevel:
+                        vertices += 4;
+                        break;
+                    case LineJoinType::FakeRound:
+                        vertices += std::max(roundJoinTriangles(cosHalfAngle[k]), 1u) - 1 + pairs;
+                        break;
+                    case LineJoinType::Bevel:
+                        vertices += pairs;
+                        break;
+                    case LineJoinType::Round:
+                        vertices += 2 * pairs;
+                        break;
+                }
+            } else {
+                vertices += (hasNext ? beginCap : endCap) == LineCapType::Round ? 2 * pairs : pairs;
+            }
+        }
+        return vertices;
+    }
+
+    // Index of the coordinates that are extruded, without the duplicates
+    std::vector<std::size_t> indices;
+    // Normals of the segments before and after each vertex, and of their join
+    std::vector<double> prevX, prevY, nextX, nextY, joinX, joinY;
+    std::vector<double> cosAngle;
+    std::vector<double> cosHalfAngle;
+    std::vector<double> miterLength;
+
+    std::vector<TriangleElement> triangleStore;
+};
+
+LineBucket::Extrusion& LineBucket::getExtrusion() {
+    thread_local Extrusion extrusion;
+    return extrusion;
+}
+
 void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
                              const GeometryTileFeature& feature,
                              const CanonicalTileID& canonical) {
@@ -146,36 +372,55 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
     const LineJoinType joinType = layout.evaluate<LineJoin>(zoom, feature, canonical);
 
     const float miterLimit = joinType == LineJoinType::Bevel ? 1.05f : static_cast<float>(layout.get<LineMiterLimit>());
+    const float roundLimit = layout.get<LineRoundLimit>();
 
     const double sharpCornerOffset =
         overscaling == 0
             ? SHARP_CORNER_OFFSET * (util::EXTENT / util::tileSize_D)
             : (overscaling <= 16.0 ? SHARP_CORNER_OFFSET * (util::EXTENT / (util::tileSize_D * overscaling)) : 0.0);
 
-    const GeometryCoordinate firstCoordinate = coordinates[first];
     const LineCapType beginCap = layout.get<LineCap>();
     const LineCapType endCap = type == FeatureType::Polygon ? LineCapType::Butt : LineCapType(layout.get<LineCap>());
 
+    // First pass: the normals and joins of all vertices, and the size of the
+    // buffers.
+    auto& extrusion = getExtrusion();
+    extrusion.computeJoins(coordinates, first, len, type == FeatureType::Polygon);
+    const std::size_t vertexCount = extrusion.countVertices(coordinates,
+                                                            len,
+                                                            type == FeatureType::Polygon,
+                                                            joinType,
+                                                            miterLimit,
+                                                            roundLimit,
+                                                            beginCap,
+                                                            endCap,
+                                                            sharpCornerOffset);
+
+    auto& triangleStore = extrusion.triangleStore;
+    triangleStore.clear();
+    triangleStore.reserve(vertexCount);
+    reserveMore(vertices, vertexCount);
+    reserveMore(triangles, vertexCount * 3);
+
     double distance = 0.0;
-    bool startOfLine = true;
     std::optional<GeometryCoordinate> currentCoordinate;
     std::optional<GeometryCoordinate> prevCoordinate;
     std::optional<GeometryCoordinate> nextCoordinate;
-    std::optional<Point<double>> prevNormal;
-    std::optional<Point<double>> nextNormal;
 
     // the last three vertices added
     e1 = e2 = e3 = -1;
 
     if (type == FeatureType::Polygon) {
         currentCoordinate = coordinates[len - 2];
-        nextNormal = util::perp(util::unit(convertPoint<double>(firstCoordinate - *currentCoordinate)));
     }
 
     const std::size_t startVertex = vertices.elements();
-    std::vector<TriangleElement> triangleStore;
 
-    for (std::size_t i = first; i < len; ++i) {
+    // Second pass: the vertices and triangles
+    for (std::size_t k = 0; k < extrusion.indices.size(); ++k) {
+        const std::size_t i = extrusion.indices[k];
+        const bool startOfLine = k == 0;
+
         if (type == FeatureType::Polygon && i == len - 1) {
             // if the line is closed, we treat the last vertex like the first
             nextCoordinate = coordinates[first + 1];
@@ -187,64 +432,18 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
             nextCoordinate = {};
         }
 
-        // if two consecutive vertices exist, skip the current one
-        if (nextCoordinate && coordinates[i] == *nextCoordinate) {
-            continue;
-        }
-
-        if (nextNormal) {
-            prevNormal = *nextNormal;
-        }
         if (currentCoordinate) {
             prevCoordinate = *currentCoordinate;
         }
 
         currentCoordinate = coordinates[i];
 
-        // Calculate the normal towards the next vertex in this line. In case
-        // there is no next vertex, pretend that the line is continuing
-        // straight, meaning that we are just using the previous normal.
-        nextNormal = nextCoordinate ? util::perp(util::unit(convertPoint<double>(*nextCoordinate - *currentCoordinate)))
-                                    : prevNormal;
-
-        // If we still don't have a previous normal, this is the beginning of a
-        // non-closed line, so we're doing a straight "join".
-        if (!prevNormal) {
-            prevNormal = *nextNormal;
-        }
-
-        // Determine the normal of the join extrusion. It is the angle bisector
-        // of the segments between the previous line and the next line.
-        // In the case of 180° angles, the prev and next normals cancel each
-        // other out: prevNormal + nextNormal = (0, 0), its magnitude is 0, so
-        // the unit vector would be undefined. In that case, we're keeping the
-        // joinNormal at (0, 0), so that the cosHalfAngle below will also become
-        // 0 and miterLength will become Infinity.
-        Point<double> joinNormal = *prevNormal + *nextNormal;
-        if (joinNormal.x != 0 || joinNormal.y != 0) {
-            joinNormal = util::unit(joinNormal);
-        }
-
-        /*  joinNormal     prevNormal
-         *             ↖      ↑
-         *                .________. prevVertex
-         *                |
-         * nextNormal  ←  |  currentVertex
-         *                |
-         *     nextVertex !
-         *
-         */
-
-        // Calculate cosines of the angle (and its half) using dot product.
-        const double cosAngle = prevNormal->x * nextNormal->x + prevNormal->y * nextNormal->y;
-        const double cosHalfAngle = joinNormal.x * nextNormal->x + joinNormal.y * nextNormal->y;
-
-        // Calculate the length of the miter (the ratio of the miter to the width)
-        // as the inverse of cosine of the angle between next and join normals.
-        const double miterLength = cosHalfAngle != 0 ? 1 / cosHalfAngle : std::numeric_limits<double>::infinity();
-
-        // Approximate angle from cosine.
-        const double approxAngle = 2 * std::sqrt(2 - 2 * cosHalfAngle);
+        const Point<double> prevNormal{extrusion.prevX[k], extrusion.prevY[k]};
+        const Point<double> nextNormal{extrusion.nextX[k], extrusion.nextY[k]};
+        Point<double> joinNormal{extrusion.joinX[k], extrusion.joinY[k]};
+        const double cosAngle = extrusion.cosAngle[k];
+        const double cosHalfAngle = extrusion.cosHalfAngle[k];
+        const double miterLength = extrusion.miterLength[k];
 
         const bool isSharpCorner = cosHalfAngle < COS_HALF_SHARP_CORNER && prevCoordinate && nextCoordinate;
 
@@ -257,45 +456,17 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
                                                        (sharpCornerOffset / prevSegmentLength)));
                 distance += util::dist<double>(newPrevVertex, *prevCoordinate);
                 addCurrentVertex(
-                    newPrevVertex, distance, *prevNormal, 0, 0, false, startVertex, triangleStore, lineDistances);
+                    newPrevVertex, distance, prevNormal, 0, 0, false, startVertex, triangleStore, lineDistances);
                 prevCoordinate = newPrevVertex;
             }
         }
 
         // The join if a middle vertex, otherwise the cap
         const bool middleVertex = prevCoordinate && nextCoordinate;
-        LineJoinType currentJoin = joinType;
+        const LineJoinType currentJoin = middleVertex ? resolveJoin(joinType, miterLength, miterLimit, roundLimit)
+                                                      : joinType;
         const LineCapType currentCap = nextCoordinate ? beginCap : endCap;
 
-        if (middleVertex) {
-            if (currentJoin == LineJoinType::Round) {
-                if (miterLength < layout.get<LineRoundLimit>()) {
-                    currentJoin = LineJoinType::Miter;
-                } else if (miterLength <= 2) {
-                    currentJoin = LineJoinType::FakeRound;
-                }
-            }
-
-            if (currentJoin == LineJoinType::Miter && miterLength > miterLimit) {
-                currentJoin = LineJoinType::Bevel;
-            }
-
-            if (currentJoin == LineJoinType::Bevel) {
-                // The maximum extrude length is 128 / 63 = 2 times the width of
-                // the line so if miterLength >= 2 we need to draw a different
-                // type of bevel here.
-                if (miterLength > 2) {
-                    currentJoin = LineJoinType::FlipBevel;
-                }
-
-                // If the miterLength is really small and the line bevel wouldn't be visible,
-                // just draw a miter join to save a triangle.
-                if (miterLength < miterLimit) {
-                    currentJoin = LineJoinType::Miter;
-                }
-            }
-        }
-
         // Calculate how far along the line the currentVertex is
         if (prevCoordinate) distance += util::dist<double>(*currentCoordinate, *prevCoordinate);
 
@@ -309,11 +480,11 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
 
             if (miterLength > 100) {
                 // Almost parallel lines
-                joinNormal = *nextNormal * -1.0;
+                joinNormal = nextNormal * -1.0;
             } else {
-                const double direction = prevNormal->x * nextNormal->y - prevNormal->y * nextNormal->x > 0 ? -1 : 1;
-                const double bevelLength = miterLength * util::mag(*prevNormal + *nextNormal) /
-                                           util::mag(*prevNormal - *nextNormal);
+                const double direction = prevNormal.x * nextNormal.y - prevNormal.y * nextNormal.x > 0 ? -1 : 1;
+                const double bevelLength = miterLength * util::mag(prevNormal + nextNormal) /
+                                           util::mag(prevNormal - nextNormal);
                 joinNormal = util::perp(joinNormal) * bevelLength * direction;
             }
 
@@ -330,7 +501,7 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
                              triangleStore,
                              lineDistances);
         } else if (middleVertex && (currentJoin == LineJoinType::Bevel || currentJoin == LineJoinType::FakeRound)) {
-            const bool lineTurnsLeft = (prevNormal->x * nextNormal->y - prevNormal->y * nextNormal->x) > 0;
+            const bool lineTurnsLeft = (prevNormal.x * nextNormal.y - prevNormal.y * nextNormal.x) > 0;
             const auto offset = static_cast<float>(-std::sqrt(miterLength * miterLength - 1));
             float offsetA;
             float offsetB;
@@ -347,7 +518,7 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
             if (!startOfLine) {
                 addCurrentVertex(*currentCoordinate,
                                  distance,
-                                 *prevNormal,
+                                 prevNormal,
                                  offsetA,
                                  offsetB,
                                  false,
@@ -362,10 +533,7 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
                 // single pie slice triangle. Create a round join by adding
                 // multiple pie slices. The join isn't actually round, but it
                 // looks like it is at the sizes we render lines at.
-
-                // Pick the number of triangles for approximating round join by
-                // based on the angle between normals.
-                const auto n = static_cast<unsigned>(::round((approxAngle * 180 / M_PI) / DEG_PER_TRIANGLE));
+                const auto n = roundJoinTriangles(cosHalfAngle);
 
                 for (unsigned m = 1; m < n; ++m) {
                     double t = static_cast<double>(m) / n;
@@ -377,7 +545,7 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
                         const double B = 0.848013 + cosAngle * (-1.06021 + cosAngle * 0.215638);
                         t = t + t * t2 * (t - 1) * (A * t2 * t2 + B);
                     }
-                    auto approxFractionalNormal = util::unit(*prevNormal * (1.0 - t) + *nextNormal * t);
+                    auto approxFractionalNormal = util::unit(prevNormal * (1.0 - t) + nextNormal * t);
                     addPieSliceVertex(*currentCoordinate,
                                       distance,
                                       approxFractionalNormal,
@@ -392,7 +560,7 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
             if (nextCoordinate) {
                 addCurrentVertex(*currentCoordinate,
                                  distance,
-                                 *nextNormal,
+                                 nextNormal,
                                  -offsetA,
                                  -offsetB,
                                  false,
@@ -405,20 +573,20 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
             if (!startOfLine) {
                 // Close previous segment with a butt
                 addCurrentVertex(
-                    *currentCoordinate, distance, *prevNormal, 0, 0, false, startVertex, triangleStore, lineDistances);
+                    *currentCoordinate, distance, prevNormal, 0, 0, false, startVertex, triangleStore, lineDistances);
             }
 
             // Start next segment with a butt
             if (nextCoordinate) {
                 addCurrentVertex(
-                    *currentCoordinate, distance, *nextNormal, 0, 0, false, startVertex, triangleStore, lineDistances);
+                    *currentCoordinate, distance, nextNormal, 0, 0, false, startVertex, triangleStore, lineDistances);
             }
 
         } else if (!middleVertex && currentCap == LineCapType::Square) {
             if (!startOfLine) {
                 // Close previous segment with a square cap
                 addCurrentVertex(
-                    *currentCoordinate, distance, *prevNormal, 1, 1, false, startVertex, triangleStore, lineDistances);
+                    *currentCoordinate, distance, prevNormal, 1, 1, false, startVertex, triangleStore, lineDistances);
 
                 // The segment is done. Unset vertices to disconnect segments.
                 e1 = e2 = -1;
@@ -428,7 +596,7 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
             if (nextCoordinate) {
                 addCurrentVertex(*currentCoordinate,
                                  distance,
-                                 *nextNormal,
+                                 nextNormal,
                                  -1,
                                  -1,
                                  false,
@@ -441,11 +609,11 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
             if (!startOfLine) {
                 // Close previous segment with a butt
                 addCurrentVertex(
-                    *currentCoordinate, distance, *prevNormal, 0, 0, false, startVertex, triangleStore, lineDistances);
+                    *currentCoordinate, distance, prevNormal, 0, 0, false, startVertex, triangleStore, lineDistances);
 
                 // Add round cap or linejoin at end of segment
                 addCurrentVertex(
-                    *currentCoordinate, distance, *prevNormal, 1, 1, true, startVertex, triangleStore, lineDistances);
+                    *currentCoordinate, distance, prevNormal, 1, 1, true, startVertex, triangleStore, lineDistances);
 
                 // The segment is done. Unset vertices to disconnect segments.
                 e1 = e2 = -1;
@@ -455,10 +623,10 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
             if (nextCoordinate) {
                 // Add round cap before first segment
                 addCurrentVertex(
-                    *currentCoordinate, distance, *nextNormal, -1, -1, true, startVertex, triangleStore, lineDistances);
+                    *currentCoordinate, distance, nextNormal, -1, -1, true, startVertex, triangleStore, lineDistances);
 
                 addCurrentVertex(
-                    *currentCoordinate, distance, *nextNormal, 0, 0, false, startVertex, triangleStore, lineDistances);
+                    *currentCoordinate, distance, nextNormal, 0, 0, false, startVertex, triangleStore, lineDistances);
             }
         }
 
@@ -471,18 +639,16 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
                                                           (sharpCornerOffset / nextSegmentLength)));
                 distance += util::dist<double>(newCurrentVertex, *currentCoordinate);
                 addCurrentVertex(
-                    newCurrentVertex, distance, *nextNormal, 0, 0, false, startVertex, triangleStore, lineDistances);
+                    newCurrentVertex, distance, nextNormal, 0, 0, false, startVertex, triangleStore, lineDistances);
                 currentCoordinate = newCurrentVertex;
             }
         }
-
-        startOfLine = false;
     }
 
     const std::size_t endVertex = vertices.elements();
-    const std::size_t vertexCount = endVertex - startVertex;
+    const std::size_t addedVertices = endVertex - startVertex;
 
-    if (segments.empty() || segments.back().vertexLength + vertexCount > std::numeric_limits<uint16_t>::max()) {
+    if (segments.empty() || segments.back().vertexLength + addedVertices > std::numeric_limits<uint16_t>::max()) {
         segments.emplace_back(startVertex, triangles.elements());
     }
 
@@ -494,7 +660,7 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates,
         triangles.emplace_back(index + triangle.a, index + triangle.b, index + triangle.c);
     }
 
-    segment.vertexLength += vertexCount;
+    segment.vertexLength += addedVertices;
     segment.indexLength += triangleStore.size() * 3;
 }
 
@@ -71,6 +71,9 @@ private:
     };
 
     class Distances;
+    class Extrusion;
+    static Extrusion& getExtrusion();
+
     void addCurrentVertex(const GeometryCoordinate& currentCoordinate,
                           double& distance,
                           const Point<double>& normal,
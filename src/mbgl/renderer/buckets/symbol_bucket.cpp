@@ -24,8 +24,8 @@ SymbolBucket::SymbolBucket(Immutable<style::SymbolLayoutProperties::PossiblyEval
                            bool iconsNeedLinear_,
                            bool sortFeaturesByY_,
                            std::string bucketName_,
-                           const std::vector<SymbolInstance>&& symbolInstances_,
-                           const std::vector<SortKeyRange>&& sortKeyRanges_,
+                           std::vector<SymbolInstance>&& symbolInstances_,
+                           std::vector<SortKeyRange>&& sortKeyRanges_,
                            float tilePixelRatio_,
                            bool allowVerticalPlacement_,
                            std::vector<style::TextWritingModeType> placementModes_,
@@ -42,8 +42,8 @@ SymbolBucket::SymbolBucket(Immutable<style::SymbolLayoutProperties::PossiblyEval
       justReloaded(false),
       hasVariablePlacement(false),
       hasUninitializedSymbols(false),
-      symbolInstances(symbolInstances_),
-      sortKeyRanges(sortKeyRanges_),
+      symbolInstances(std::move(symbolInstances_)),
+      sortKeyRanges(std::move(sortKeyRanges_)),
       textSizeBinder(SymbolSizeBinder::create(zoom, textSize, TextSize::defaultValue())),
       iconSizeBinder(SymbolSizeBinder::create(zoom, iconSize, IconSize::defaultValue())),
       tilePixelRatio(tilePixelRatio_),
@@ -327,6 +327,14 @@ bool SymbolBucket::hasFormatSectionOverrides() const {
     return *hasFormatSectionOverrides_;
 }
 
+std::size_t SymbolBucket::getSymbolInstancesMemoryUsage() const {
+    std::size_t usage = (symbolInstances.capacity() - symbolInstances.size()) * sizeof(SymbolInstance);
+    for (const SymbolInstance& symbolInstance : symbolInstances) {
+        usage += symbolInstance.getMemoryUsage();
+    }
+    return usage;
+}
+
 std::pair<uint32_t, bool> SymbolBucket::registerAtCrossTileIndex(CrossTileSymbolLayerIndex& index,
                                                                  const RenderTile& renderTile) {
     bool firstTimeAdded = index.addBucket(renderTile.getOverscaledTileID(), renderTile.matrix, *this);
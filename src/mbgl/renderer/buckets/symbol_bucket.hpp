@@ -74,8 +74,8 @@ public:
                  bool iconsNeedLinear,
                  bool sortFeaturesByY,
                  std::string bucketName_,
-                 const std::vector<SymbolInstance>&&,
-                 const std::vector<SortKeyRange>&&,
+                 std::vector<SymbolInstance>&&,
+                 std::vector<SortKeyRange>&&,
                  float tilePixelRatio,
                  bool allowVerticalPlacement,
                  std::vector<style::TextWritingModeType> placementModes,
@@ -96,6 +96,8 @@ public:
     bool hasTextCollisionBoxData() const;
     bool hasTextCollisionCircleData() const;
     bool hasFormatSectionOverrides() const;
+    // Approximate memory held by the symbol instances
+    std::size_t getSymbolInstancesMemoryUsage() const;
 
     void sortFeatures(float angle);
     // Returns references to the `symbolInstances` items, sorted by viewport Y.
@@ -323,13 +323,21 @@ public:
         auto evaluated = expression.evaluate(EvaluationContext(&feature).withFeatureState(&state), defaultValue);
         this->statistics.add(evaluated);
         auto value = attributeValue(evaluated);
-        for (std::size_t i = start; i < end; ++i) {
-            vertexVector.at(i) = BaseVertex{value};
-        }
+        vertexVector.fill(start, end, BaseVertex{value});
     }
 
 #if MLN_LEGACY_RENDERER
-    void upload(gfx::UploadPass& uploadPass) override { vertexBuffer = uploadPass.createVertexBuffer(vertexVector); }
+    void upload(gfx::UploadPass& uploadPass) override {
+        // Feature state changes only the vertices of the features it applies to
+        if (vertexBuffer && vertexBuffer->elements == vertexVector.elements()) {
+            if (vertexVector.getDirty()) {
+                uploadPass.updateVertexBuffer(*vertexBuffer, vertexVector);
+            }
+        } else {
+            vertexBuffer = uploadPass.createVertexBuffer(vertexVector);
+        }
+        vertexVector.setDirty(false);
+    }
 
     std::tuple<std::optional<gfx::AttributeBinding>> attributeBinding(
         const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
@@ -453,14 +461,21 @@ public:
         this->statistics.add(range.min);
         this->statistics.add(range.max);
         AttributeValue value = zoomInterpolatedAttributeValue(attributeValue(range.min), attributeValue(range.max));
-
-        for (std::size_t i = start; i < end; ++i) {
-            vertexVector.at(i) = Vertex{value};
-        }
+        vertexVector.fill(start, end, Vertex{value});
     }
 
 #if MLN_LEGACY_RENDERER
-    void upload(gfx::UploadPass& uploadPass) override { vertexBuffer = uploadPass.createVertexBuffer(vertexVector); }
+    void upload(gfx::UploadPass& uploadPass) override {
+        // Feature state changes only the vertices of the features it applies to
+        if (vertexBuffer && vertexBuffer->elements == vertexVector.elements()) {
+            if (vertexVector.getDirty()) {
+                uploadPass.updateVertexBuffer(*vertexBuffer, vertexVector);
+            }
+        } else {
+            vertexBuffer = uploadPass.createVertexBuffer(vertexVector);
+        }
+        vertexVector.setDirty(false);
+    }
 
     std::tuple<std::optional<gfx::AttributeBinding>> attributeBinding(
         const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
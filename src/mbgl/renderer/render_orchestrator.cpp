@@ -1,4 +1,5 @@
 #include <mbgl/renderer/render_orchestrator.hpp>
+#include <mbgl/actor/scheduler.hpp>
 
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/layermanager/layer_manager.hpp>
@@ -120,12 +121,17 @@ RenderOrchestrator::RenderOrchestrator(bool backgroundLayerAsColor_, const std::
       sourceImpls(makeMutable<std::vector<Immutable<style::Source::Impl>>>()),
       layerImpls(makeMutable<std::vector<Immutable<style::Layer::Impl>>>()),
       renderLight(makeMutable<Light::Impl>()),
-      backgroundLayerAsColor(backgroundLayerAsColor_) {
+      backgroundLayerAsColor(backgroundLayerAsColor_),
+      placementScheduler(Scheduler::GetSequenced()) {
     glyphManager->setObserver(this);
     imageManager->setObserver(this);
 }
 
 RenderOrchestrator::~RenderOrchestrator() {
+    // The pending placement refers to tiles and buckets owned by the sources
+    if (pendingPlacementDone.valid()) {
+        pendingPlacementDone.wait();
+    }
     if (contextLost) {
         // Signal all RenderLayers that the context was lost
         // before cleaning up. At the moment, only CustomLayer is
@@ -145,6 +151,18 @@ void RenderOrchestrator::setObserver(RendererObserver* observer_) {
 std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
     const std::shared_ptr<UpdateParameters>& updateParameters) {
     const auto startTime = util::MonotonicTimer::now().count();
+    placementTime = 0.0;
+
+    // Swap in the placement computed since the last frame before anything it
+    // reads is updated.
+    const auto placementWaitStart = util::MonotonicTimer::now();
+    const bool pendingPlacementFinished = finishPendingPlacement();
+    if (pendingPlacementFinished) {
+        placementTime = (util::MonotonicTimer::now() - placementWaitStart).count();
+        for (const auto& entry : renderSources) {
+            entry.second->updateFadingTiles();
+        }
+    }
 
     const bool isMapModeContinuous = updateParameters->mode == MapMode::Continuous;
     if (!isMapModeContinuous) {
@@ -455,32 +473,47 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
             placementUpdatePeriodOverride = std::optional<Duration>(Milliseconds(30));
         }
 
-        renderTreeParameters->placementChanged = !placementController.placementIsRecent(
+        renderTreeParameters->placementChanged = pendingPlacementFinished;
+        const bool placementIsRecent = placementController.placementIsRecent(
             updateParameters->timePoint,
             static_cast<float>(updateParameters->transformState.getZoom()),
             placementUpdatePeriodOverride);
-        symbolBucketsChanged |= renderTreeParameters->placementChanged;
-        if (renderTreeParameters->placementChanged) {
-            Mutable<Placement> placement = Placement::create(updateParameters, placementController.getPlacement());
-            placement->placeLayers(layersNeedPlacement);
-            placementController.setPlacement(std::move(placement));
-            crossTileSymbolIndex.pruneUnusedLayers(usedSymbolLayers);
-            for (const auto& entry : renderSources) {
-                entry.second->updateFadingTiles();
+        if (placementBudget && (incrementalPlacement || !placementIsRecent)) {
+            if (!incrementalPlacement) {
+                incrementalPlacement = Placement::create(updateParameters, placementController.getPlacement());
+                crossTileSymbolIndex.pruneUnusedLayers(usedSymbolLayers);
             }
+            if (continueIncrementalPlacement(updateParameters)) {
+                renderTreeParameters->placementChanged = true;
+                for (const auto& entry : renderSources) {
+                    entry.second->updateFadingTiles();
+                }
+            } else {
+                placementController.setPlacementStale();
+            }
+        } else if (!placementIsRecent) {
+            const auto placementStart = util::MonotonicTimer::now();
+            startPlacement(Placement::create(updateParameters, placementController.getPlacement()));
+            placementTime += (util::MonotonicTimer::now() - placementStart).count();
+            crossTileSymbolIndex.pruneUnusedLayers(usedSymbolLayers);
         } else {
             placementController.setPlacementStale();
         }
+        symbolBucketsChanged |= renderTreeParameters->placementChanged;
         renderTreeParameters->symbolFadeChange = placementController.getPlacement()->symbolFadeChange(
             updateParameters->timePoint);
-        renderTreeParameters->needsRepaint = hasTransitions(updateParameters->timePoint);
+        // Keep rendering until the pending placement is swapped in
+        renderTreeParameters->needsRepaint = hasTransitions(updateParameters->timePoint) ||
+                                             pendingPlacement.has_value() || incrementalPlacement.has_value();
     } else {
         renderTreeParameters->placementChanged = symbolBucketsChanged = !layersNeedPlacement.empty();
         if (renderTreeParameters->placementChanged) {
+            const auto placementStart = util::MonotonicTimer::now();
             Mutable<Placement> placement = Placement::create(updateParameters);
             placement->collectPlacedSymbolData(placedSymbolDataCollected);
             placement->placeLayers(layersNeedPlacement);
             placementController.setPlacement(std::move(placement));
+            placementTime = (util::MonotonicTimer::now() - placementStart).count();
         }
         crossTileSymbolIndex.reset();
         renderTreeParameters->symbolFadeChange = 1.0f;
@@ -511,6 +544,57 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
                                             startTime);
 }
 
+void RenderOrchestrator::startPlacement(Mutable<Placement> placement) {
+    assert(!pendingPlacement);
+    auto done = std::make_shared<std::promise<void>>();
+    pendingPlacementDone = done->get_future();
+    pendingPlacement = std::move(placement);
+
+    // Frames keep being drawn from the buckets being placed: the render thread
+    // updates their vertices, the visibility and orientation of their placed
+    // symbols and their upload flags, none of which placement reads. The one
+    // piece of that state placement depends on, whether a bucket was just
+    // reloaded, shares storage with the upload flags and is copied here.
+    // Tiles, buckets and the cross-tile index are only replaced by the next
+    // call to `createRenderTree`, which waits for the placement first.
+    (*pendingPlacement)->snapshotBucketState(layersNeedPlacement);
+    placementScheduler->schedule([&placement_ = **pendingPlacement, layers = layersNeedPlacement, done] {
+        try {
+            placement_.placeLayers(layers);
+            done->set_value();
+        } catch (...) {
+            done->set_exception(std::current_exception());
+        }
+    });
+}
+
+bool RenderOrchestrator::finishPendingPlacement() {
+    if (!pendingPlacement) {
+        return false;
+    }
+
+    Mutable<Placement> placement = std::move(*pendingPlacement);
+    pendingPlacement.reset();
+    auto done = std::move(pendingPlacementDone);
+    done.get();
+
+    placementController.setPlacement(std::move(placement));
+    return true;
+}
+
+bool RenderOrchestrator::continueIncrementalPlacement(const std::shared_ptr<UpdateParameters>& updateParameters) {
+    assert(incrementalPlacement && placementBudget);
+    const auto placementStart = util::MonotonicTimer::now();
+    Placement& placement = **incrementalPlacement;
+    const bool finished = placement.placeLayers(layersNeedPlacement, *placementBudget, updateParameters->timePoint);
+    if (finished) {
+        placementController.setPlacement(std::move(*incrementalPlacement));
+        incrementalPlacement.reset();
+    }
+    placementTime += (util::MonotonicTimer::now() - placementStart).count();
+    return finished;
+}
+
 std::vector<Feature> RenderOrchestrator::queryRenderedFeatures(const ScreenLineString& geometry,
                                                                const RenderedQueryOptions& options) const {
     std::unordered_map<std::string, const RenderLayer*> layers;
@@ -716,6 +800,13 @@ void RenderOrchestrator::collectPlacedSymbolData(bool enable) {
     placedSymbolDataCollected = enable;
 }
 
+void RenderOrchestrator::setPlacementBudget(std::optional<Duration> budget) {
+    placementBudget = budget;
+    if (!placementBudget) {
+        incrementalPlacement.reset();
+    }
+}
+
 const std::vector<PlacedSymbolData>& RenderOrchestrator::getPlacedSymbolsData() const {
     return placementController.getPlacement()->getPlacedSymbolsData();
 }
@@ -775,6 +866,14 @@ bool RenderOrchestrator::isLoaded() const {
 }
 
 void RenderOrchestrator::clearData() {
+    // Drop any placement of the data being cleared
+    if (pendingPlacementDone.valid()) {
+        pendingPlacementDone.wait();
+        pendingPlacementDone = {};
+    }
+    pendingPlacement.reset();
+    incrementalPlacement.reset();
+
     if (!sourceImpls->empty()) sourceImpls = makeMutable<std::vector<Immutable<style::Source::Impl>>>();
     if (!layerImpls->empty()) layerImpls = makeMutable<std::vector<Immutable<style::Layer::Impl>>>();
     if (!imageImpls->empty()) imageImpls = makeMutable<std::vector<Immutable<style::Image::Impl>>>();
@@ -16,8 +16,10 @@
 #include <mbgl/text/placement.hpp>
 #include <mbgl/renderer/render_tree.hpp>
 
+#include <future>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -38,6 +40,7 @@ class LineAtlas;
 class PatternAtlas;
 class CrossTileSymbolIndex;
 class RenderTree;
+class Scheduler;
 
 namespace gfx {
 class ShaderRegistry;
@@ -93,6 +96,7 @@ public:
     void dumpDebugLogs();
     void collectPlacedSymbolData(bool);
     const std::vector<PlacedSymbolData>& getPlacedSymbolsData() const;
+    void setPlacementBudget(std::optional<Duration>);
     void clearData();
 
     void update(const std::shared_ptr<UpdateParameters>&);
@@ -126,6 +130,9 @@ public:
 
     const ZoomHistory& getZoomHistory() const { return zoomHistory; }
 
+    /// CPU time, in seconds, spent placing symbols in the last `createRenderTree` call
+    double getPlacementTime() const { return placementTime; }
+
 private:
     bool isLoaded() const;
     bool hasTransitions(TimePoint) const;
@@ -160,6 +167,16 @@ private:
     void addChanges(UniqueChangeRequestVec&);
 #endif
 
+    /// Start placing symbols on a background thread. The current placement
+    /// stays in use until the next frame swaps the new one in.
+    void startPlacement(Mutable<Placement>);
+    /// Wait for the placement started on the previous frame and make it
+    /// current. Returns false if there was none.
+    bool finishPendingPlacement();
+    /// Continue the placement spread over several frames for at most the
+    /// placement budget. Returns true once it is complete and made current.
+    bool continueIncrementalPlacement(const std::shared_ptr<UpdateParameters>&);
+
     RendererObserver* observer;
 
     ZoomHistory zoomHistory;
@@ -191,6 +208,15 @@ private:
     RenderLayerReferences orderedLayers;
     RenderLayerReferences layersNeedPlacement;
 
+    double placementTime = 0.0;
+
+    std::shared_ptr<Scheduler> placementScheduler;
+    std::optional<Mutable<Placement>> pendingPlacement;
+    std::future<void> pendingPlacementDone;
+
+    std::optional<Duration> placementBudget;
+    std::optional<Mutable<Placement>> incrementalPlacement;
+
 #if MLN_DRAWABLE_RENDERER
     std::vector<std::unique_ptr<ChangeRequest>> pendingChanges;
 
@@ -8,6 +8,7 @@
 #include <mbgl/annotation/render_annotation_source.hpp>
 #include <mbgl/renderer/sources/render_image_source.hpp>
 #include <mbgl/renderer/sources/render_custom_geometry_source.hpp>
+#include <mbgl/renderer/sources/render_flatgeobuf_source.hpp>
 #include <mbgl/tile/tile.hpp>
 
 #include <mbgl/layermanager/layer_manager.hpp>
@@ -42,6 +43,8 @@ std::unique_ptr<RenderSource> RenderSource::create(const Immutable<Source::Impl>
             return std::make_unique<RenderImageSource>(staticImmutableCast<ImageSource::Impl>(impl));
         case SourceType::CustomVector:
             return std::make_unique<RenderCustomGeometrySource>(staticImmutableCast<CustomGeometrySource::Impl>(impl));
+        case SourceType::FlatGeobuf:
+            return std::make_unique<RenderFlatGeobufSource>(staticImmutableCast<FlatGeobufSource::Impl>(impl));
     }
 
     // Not reachable, but placate GCC.
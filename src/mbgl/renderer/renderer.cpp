@@ -8,6 +8,7 @@
 #include <mbgl/renderer/render_static_data.hpp>
 #include <mbgl/renderer/render_tree.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
+#include <mbgl/util/monotonic_timer.hpp>
 
 namespace mbgl {
 
@@ -30,8 +31,15 @@ void Renderer::setObserver(RendererObserver* observer) {
 
 void Renderer::render(const std::shared_ptr<UpdateParameters>& updateParameters) {
     assert(updateParameters);
+    const auto startTime = util::MonotonicTimer::now();
     if (auto renderTree = impl->orchestrator.createRenderTree(updateParameters)) {
         renderTree->prepare();
+
+        // The per-layer entries are kept, and updated in place, to avoid reallocating them every frame
+        auto& timings = impl->frameTimings;
+        timings.createRenderTree = (util::MonotonicTimer::now() - startTime).count();
+        timings.placement = impl->orchestrator.getPlacementTime();
+        timings.upload = timings.tweakers = timings.encoding = 0.0;
         impl->render(*renderTree, updateParameters);
     }
 }
@@ -128,10 +136,18 @@ void Renderer::collectPlacedSymbolData(bool enable) {
     impl->orchestrator.collectPlacedSymbolData(enable);
 }
 
+void Renderer::setPlacementBudget(std::optional<Duration> budget) {
+    impl->orchestrator.setPlacementBudget(budget);
+}
+
 const std::vector<PlacedSymbolData>& Renderer::getPlacedSymbolsData() const {
     return impl->orchestrator.getPlacedSymbolsData();
 }
 
+const gfx::FrameTimings& Renderer::getFrameTimings() const {
+    return impl->frameTimings;
+}
+
 void Renderer::reduceMemoryUse() {
     gfx::BackendScope guard{impl->backend};
     impl->reduceMemoryUse();
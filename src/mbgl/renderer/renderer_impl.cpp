@@ -14,6 +14,7 @@
 #include <mbgl/renderer/render_static_data.hpp>
 #include <mbgl/renderer/render_tree.hpp>
 #include <mbgl/util/convert.hpp>
+#include <mbgl/util/monotonic_timer.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
 
@@ -22,6 +23,7 @@
 #include <mbgl/renderer/layer_tweaker.hpp>
 #include <mbgl/renderer/render_target.hpp>
 
+#include <algorithm>
 #include <limits>
 #endif // MLN_DRAWABLE_RENDERER
 
@@ -43,6 +45,12 @@ RendererObserver& nullObserver() {
     return observer;
 }
 
+/// Run `func` and add its duration to `total`
+template <typename F>
+void addTime(double& total, F&& func) {
+    total += util::MonotonicTimer::duration(std::forward<F>(func)).count();
+}
+
 } // namespace
 
 Renderer::Impl::Impl(gfx::RendererBackend& backend_,
@@ -61,6 +69,16 @@ void Renderer::Impl::setObserver(RendererObserver* observer_) {
     observer = observer_ ? observer_ : &nullObserver();
 }
 
+double& Renderer::Impl::layerTime(int32_t layerIndex, const std::string& id) {
+    const auto index = static_cast<std::size_t>(std::max(layerIndex, 0));
+    if (index >= layerTimes.size()) {
+        layerTimes.resize(index + 1);
+    }
+    auto& entry = layerTimes[index];
+    entry.id = &id;
+    return entry.encoding;
+}
+
 void Renderer::Impl::render(const RenderTree& renderTree,
                             [[maybe_unused]] const std::shared_ptr<UpdateParameters>& updateParameters) {
     auto& context = backend.getContext();
@@ -114,7 +132,7 @@ void Renderer::Impl::render(const RenderTree& renderTree,
 
     // - UPLOAD PASS -------------------------------------------------------------------------------
     // Uploads all required buffers and images before we do any actual rendering.
-    {
+    addTime(frameTimings.upload, [&] {
         const auto uploadPass = parameters.encoder->createUploadPass("upload",
                                                                      parameters.backend.getDefaultRenderable());
 #if !defined(NDEBUG)
@@ -131,7 +149,7 @@ void Renderer::Impl::render(const RenderTree& renderTree,
         staticData->upload(*uploadPass);
         renderTree.getLineAtlas().upload(*uploadPass);
         renderTree.getPatternAtlas().upload(*uploadPass);
-    }
+    });
 
 #if MLN_DRAWABLE_RENDERER
     // - LAYER GROUP UPDATE ------------------------------------------------------------------------
@@ -144,7 +162,7 @@ void Renderer::Impl::render(const RenderTree& renderTree,
     orchestrator.processChanges();
 
     // Upload layer groups
-    {
+    addTime(frameTimings.tweakers, [&] {
         const auto uploadPass = parameters.encoder->createUploadPass("layerGroup-upload",
                                                                      parameters.backend.getDefaultRenderable());
 #if !defined(NDEBUG)
@@ -157,7 +175,7 @@ void Renderer::Impl::render(const RenderTree& renderTree,
                 layerGroup.getLayerTweaker()->execute(layerGroup, renderTree, parameters);
             }
         });
-    }
+    });
 
     // Update the debug layer groups
     orchestrator.updateDebugLayerGroups(renderTree, parameters);
@@ -167,7 +185,7 @@ void Renderer::Impl::render(const RenderTree& renderTree,
     // });
 
     // Upload layer groups
-    {
+    addTime(frameTimings.upload, [&] {
         const auto uploadPass = parameters.encoder->createUploadPass("layerGroup-upload",
                                                                      parameters.backend.getDefaultRenderable());
 
@@ -179,7 +197,7 @@ void Renderer::Impl::render(const RenderTree& renderTree,
 
         // Upload the Debug layer group
         orchestrator.visitDebugLayerGroups([&](LayerGroupBase& layerGroup) { layerGroup.upload(*uploadPass); });
-    }
+    });
 #endif
 
     // - 3D PASS
@@ -211,7 +229,8 @@ void Renderer::Impl::render(const RenderTree& renderTree,
         // draw layer groups, 3D pass
         const auto maxLayerIndex = orchestrator.maxLayerIndex();
         orchestrator.visitLayerGroups([&](LayerGroupBase& layerGroup) {
-            layerGroup.render(orchestrator, parameters);
+            addTime(layerTime(layerGroup.getLayerIndex(), layerGroup.getName()),
+                    [&] { layerGroup.render(orchestrator, parameters); });
             parameters.currentLayer = maxLayerIndex - layerGroup.getLayerIndex();
         });
     };
@@ -226,7 +245,9 @@ void Renderer::Impl::render(const RenderTree& renderTree,
             const RenderItem& renderItem = it->get();
             if (renderItem.hasRenderPass(parameters.pass)) {
                 const auto layerDebugGroup(parameters.encoder->createDebugGroup(renderItem.getName().c_str()));
-                renderItem.render(parameters);
+                addTime(layerTime(static_cast<int32_t>(layerRenderItems.size()) - 1 - static_cast<int32_t>(i),
+                                  renderItem.getName()),
+                        [&] { renderItem.render(parameters); });
             }
         }
     };
@@ -270,7 +291,8 @@ void Renderer::Impl::render(const RenderTree& renderTree,
         // draw layer groups, opaque pass
         orchestrator.visitLayerGroups([&](LayerGroupBase& layerGroup) {
             parameters.currentLayer = layerGroup.getLayerIndex();
-            layerGroup.render(orchestrator, parameters);
+            addTime(layerTime(layerGroup.getLayerIndex(), layerGroup.getName()),
+                    [&] { layerGroup.render(orchestrator, parameters); });
         });
     };
 
@@ -283,7 +305,8 @@ void Renderer::Impl::render(const RenderTree& renderTree,
         // draw layer groups, translucent pass
         orchestrator.visitLayerGroups([&](LayerGroupBase& layerGroup) {
             parameters.currentLayer = maxLayerIndex - layerGroup.getLayerIndex();
-            layerGroup.render(orchestrator, parameters);
+            addTime(layerTime(layerGroup.getLayerIndex(), layerGroup.getName()),
+                    [&] { layerGroup.render(orchestrator, parameters); });
         });
     };
 #endif
@@ -302,7 +325,9 @@ void Renderer::Impl::render(const RenderTree& renderTree,
             const RenderItem& renderItem = it->get();
             if (renderItem.hasRenderPass(parameters.pass)) {
                 const auto layerDebugGroup(parameters.renderPass->createDebugGroup(renderItem.getName().c_str()));
-                renderItem.render(parameters);
+                addTime(layerTime(static_cast<int32_t>(layerRenderItems.size()) - 1 - static_cast<int32_t>(i),
+                                  renderItem.getName()),
+                        [&] { renderItem.render(parameters); });
             }
         }
     };
@@ -320,7 +345,9 @@ void Renderer::Impl::render(const RenderTree& renderTree,
             const RenderItem& renderItem = it->get();
             if (renderItem.hasRenderPass(parameters.pass)) {
                 const auto layerDebugGroup(parameters.renderPass->createDebugGroup(renderItem.getName().c_str()));
-                renderItem.render(parameters);
+                addTime(layerTime(static_cast<int32_t>(layerRenderItems.size()) - 1 - static_cast<int32_t>(i),
+                                  renderItem.getName()),
+                        [&] { renderItem.render(parameters); });
             }
         }
     };
@@ -365,6 +392,9 @@ void Renderer::Impl::render(const RenderTree& renderTree,
     };
 #endif // MLN_LEGACY_RENDERER
 
+    const auto encodingStart = util::MonotonicTimer::now();
+    layerTimes.assign(layerRenderItems.size(), {});
+
 #if (MLN_DRAWABLE_RENDERER && !MLN_LEGACY_RENDERER)
     if (parameters.staticData.has3D) {
         common3DPass();
@@ -403,6 +433,24 @@ void Renderer::Impl::render(const RenderTree& renderTree,
     // CommandEncoder destructor submits render commands.
     parameters.encoder.reset();
 
+    frameTimings.encoding = (util::MonotonicTimer::now() - encodingStart).count();
+
+    // Reuse the entries, and their strings, of the previous frame
+    std::size_t layerCount = 0;
+    for (const auto& entry : layerTimes) {
+        if (!entry.id) {
+            continue;
+        }
+        if (layerCount == frameTimings.layers.size()) {
+            frameTimings.layers.emplace_back();
+        }
+        auto& layer = frameTimings.layers[layerCount++];
+        layer.id = *entry.id;
+        layer.encoding = entry.encoding;
+    }
+    frameTimings.layers.resize(layerCount);
+    observer->onDidFinishRenderingFrameTimings(frameTimings);
+
     observer->onDidFinishRenderingFrame(
         renderTreeParameters.loaded ? RendererObserver::RenderMode::Full : RendererObserver::RenderMode::Partial,
         renderTreeParameters.needsRepaint,
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <mbgl/gfx/rendering_stats.hpp>
 #include <mbgl/renderer/render_orchestrator.hpp>
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace mbgl {
 
@@ -49,6 +51,17 @@ private:
     RenderState renderState = RenderState::Never;
 
     uint64_t frameCount = 0;
+
+    gfx::FrameTimings frameTimings;
+
+    double& layerTime(int32_t layerIndex, const std::string& id);
+
+    // Encoding time of each layer in the current frame, by layer index
+    struct LayerTime {
+        const std::string* id = nullptr;
+        double encoding = 0.0;
+    };
+    std::vector<LayerTime> layerTimes;
 };
 
 } // namespace mbgl
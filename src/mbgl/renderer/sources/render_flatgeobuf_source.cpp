@@ -0,0 +1,47 @@
+#include <mbgl/renderer/sources/render_flatgeobuf_source.hpp>
+#include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/tile/geojson_tile.hpp>
+
+namespace mbgl {
+
+using namespace style;
+
+RenderFlatGeobufSource::RenderFlatGeobufSource(Immutable<style::FlatGeobufSource::Impl> impl_)
+    : RenderTileSource(std::move(impl_)) {}
+
+const style::FlatGeobufSource::Impl& RenderFlatGeobufSource::impl() const {
+    return static_cast<const style::FlatGeobufSource::Impl&>(*baseImpl);
+}
+
+void RenderFlatGeobufSource::update(Immutable<style::Source::Impl> baseImpl_,
+                                    const std::vector<Immutable<LayerProperties>>& layers,
+                                    const bool needsRendering,
+                                    const bool needsRelayout,
+                                    const TileParameters& parameters) {
+    std::swap(baseImpl, baseImpl_);
+
+    enabled = needsRendering;
+
+    auto data_ = impl().getData().lock();
+    if (data.lock() != data_) {
+        // The file is only opened once, so tiles of older data are dropped
+        data = data_;
+        tilePyramid.clearAll();
+    }
+
+    if (!data_) return;
+
+    tilePyramid.update(layers,
+                       needsRendering,
+                       needsRelayout,
+                       parameters,
+                       *baseImpl,
+                       util::tileSize_I,
+                       impl().getZoomRange(),
+                       std::optional<LatLngBounds>{},
+                       [&, data_](const OverscaledTileID& tileID) {
+                           return std::make_unique<GeoJSONTile>(tileID, impl().id, parameters, data_);
+                       });
+}
+
+} // namespace mbgl
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <mbgl/renderer/sources/render_tile_source.hpp>
+#include <mbgl/style/sources/flatgeobuf_source_impl.hpp>
+
+namespace mbgl {
+
+class RenderFlatGeobufSource final : public RenderTileSource {
+public:
+    explicit RenderFlatGeobufSource(Immutable<style::FlatGeobufSource::Impl>);
+
+    void update(Immutable<style::Source::Impl>,
+                const std::vector<Immutable<style::LayerProperties>>&,
+                bool needsRendering,
+                bool needsRelayout,
+                const TileParameters&) override;
+
+private:
+    const style::FlatGeobufSource::Impl& impl() const;
+
+    std::weak_ptr<style::GeoJSONData> data;
+};
+
+} // namespace mbgl
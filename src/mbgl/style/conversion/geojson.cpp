@@ -1,6 +1,11 @@
 #include <mbgl/style/conversion/geojson.hpp>
-#include <mbgl/style/conversion/json.hpp>
 #include <mbgl/style/conversion_impl.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <rapidjson/error/en.h>
+#include <rapidjson/reader.h>
+
+#include <stdexcept>
 
 namespace mbgl {
 namespace style {
@@ -10,8 +15,469 @@ std::optional<GeoJSON> Converter<GeoJSON>::operator()(const Convertible& value,
     return toGeoJSON(value, error);
 }
 
+namespace {
+
+using Geometry = mapbox::geometry::geometry<double>;
+
+// Nested coordinate arrays, which may come before the type of their
+// geometry. The numbers are kept flat, with the element counts of the arrays
+// at each depth, in order.
+struct Coordinates {
+    std::vector<double> numbers;
+    std::vector<std::vector<std::size_t>> counts;
+    std::optional<std::size_t> numberDepth;
+};
+
+// Makes the geometry of a type out of its coordinates
+class CoordinatesReader {
+public:
+    CoordinatesReader(const std::string& type_, const Coordinates& coordinates_, std::size_t depth)
+        : type(type_),
+          coordinates(coordinates_),
+          next(coordinates.counts.size(), 0) {
+        if (coordinates.counts.size() > depth || (coordinates.numberDepth && *coordinates.numberDepth != depth - 1)) {
+            throw std::runtime_error(type + " geometry has invalid coordinates");
+        }
+    }
+
+    std::size_t size(std::size_t depth) { return coordinates.counts[depth][next[depth]++]; }
+
+    mapbox::geometry::point<double> point(std::size_t depth) {
+        const std::size_t count = size(depth);
+        if (count < 2) {
+            throw std::runtime_error(type + " geometry coordinates must have at least 2 numbers");
+        }
+        mapbox::geometry::point<double> result{coordinates.numbers[number], coordinates.numbers[number + 1]};
+        number += count;
+        return result;
+    }
+
+    template <typename Points>
+    Points points(std::size_t depth) {
+        Points result;
+        const std::size_t count = size(depth);
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            result.push_back(point(depth + 1));
+        }
+        return result;
+    }
+
+    template <typename Lines>
+    Lines lines(std::size_t depth) {
+        Lines result;
+        const std::size_t count = size(depth);
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            result.push_back(points<typename Lines::value_type>(depth + 1));
+        }
+        return result;
+    }
+
+    mapbox::geometry::multi_polygon<double> polygons() {
+        mapbox::geometry::multi_polygon<double> result;
+        const std::size_t count = size(0);
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            result.push_back(lines<mapbox::geometry::polygon<double>>(1));
+        }
+        return result;
+    }
+
+private:
+    const std::string& type;
+    const Coordinates& coordinates;
+    // Next array at each depth
+    std::vector<std::size_t> next;
+    // Next number
+    std::size_t number = 0;
+};
+
+// GeoJSON object being read, which turns into a geometry or a feature once
+// all its members are known
+struct Object {
+    std::optional<std::string> type;
+    std::optional<Coordinates> coordinates;
+    std::optional<mapbox::geometry::geometry_collection<double>> geometries;
+    std::optional<mapbox::feature::feature_collection<double>> features;
+    std::optional<Geometry> geometry;
+    PropertyMap properties;
+    std::optional<FeatureIdentifier> id;
+
+    Geometry toGeometry() {
+        if (!type) {
+            throw std::runtime_error("Geometry must have a type property");
+        }
+        if (*type == "GeometryCollection") {
+            if (!geometries) {
+                throw std::runtime_error("GeometryCollection must have a geometries property");
+            }
+            return std::move(*geometries);
+        }
+        if (!coordinates) {
+            throw std::runtime_error(*type + " geometry must have a coordinates property");
+        }
+        if (*type == "Point") {
+            return CoordinatesReader(*type, *coordinates, 1).point(0);
+        } else if (*type == "MultiPoint") {
+            return CoordinatesReader(*type, *coordinates, 2).points<mapbox::geometry::multi_point<double>>(0);
+        } else if (*type == "LineString") {
+            return CoordinatesReader(*type, *coordinates, 2).points<mapbox::geometry::line_string<double>>(0);
+        } else if (*type == "MultiLineString") {
+            return CoordinatesReader(*type, *coordinates, 3).lines<mapbox::geometry::multi_line_string<double>>(0);
+        } else if (*type == "Polygon") {
+            return CoordinatesReader(*type, *coordinates, 3).lines<mapbox::geometry::polygon<double>>(0);
+        } else if (*type == "MultiPolygon") {
+            return CoordinatesReader(*type, *coordinates, 4).polygons();
+        }
+        throw std::runtime_error(*type + " geometry type not supported");
+    }
+
+    GeoJSONFeature toFeature() {
+        if (!type || *type != "Feature") {
+            throw std::runtime_error("Expected Feature type");
+        }
+        if (!geometry) {
+            throw std::runtime_error("Feature must have a geometry property");
+        }
+        GeoJSONFeature feature{std::move(*geometry)};
+        feature.properties = std::move(properties);
+        if (id) {
+            feature.id = std::move(*id);
+        }
+        return feature;
+    }
+
+    GeoJSON toGeoJSON() {
+        if (!type) {
+            throw std::runtime_error("GeoJSON must have a type property");
+        }
+        if (*type == "Feature") {
+            return toFeature();
+        }
+        if (*type == "FeatureCollection") {
+            if (!features) {
+                throw std::runtime_error("FeatureCollection must have features property");
+            }
+            return std::move(*features);
+        }
+        return toGeometry();
+    }
+};
+
+// SAX handler turning GeoJSON text into geometries and features as it is
+// read, without a document holding all of it. Members of the objects may
+// come in any order, so each object is kept until its end. Feature
+// collections only grow by the features read so far.
+class GeoJSONReader {
+public:
+    std::optional<GeoJSON> result;
+
+    bool Null() { return scalar(NullValue()); }
+    bool Bool(bool value) { return scalar(value); }
+    bool Int(int value) { return scalar(static_cast<int64_t>(value)); }
+    bool Uint(unsigned value) { return scalar(static_cast<uint64_t>(value)); }
+    bool Int64(int64_t value) { return scalar(value); }
+    bool Uint64(uint64_t value) { return scalar(value); }
+    bool Double(double value) { return scalar(value); }
+    bool RawNumber(const char*, rapidjson::SizeType, bool) { return false; }
+    bool String(const char* value, rapidjson::SizeType length, bool) { return scalar(std::string(value, length)); }
+
+    bool StartObject() {
+        if (frames.empty()) {
+            frames.emplace_back(Frame::Object);
+            return true;
+        }
+        Frame& top = frames.back();
+        switch (top.kind) {
+            case Frame::Object:
+                if (top.key == "properties") {
+                    frames.emplace_back(Frame::Value).containers.emplace_back(PropertyMap(), std::string());
+                } else if (top.key == "geometry") {
+                    frames.emplace_back(Frame::Object);
+                } else if (isMemberOfType(top.key)) {
+                    throw std::runtime_error(top.key + " must be an array");
+                } else if (top.key == "id") {
+                    throw std::runtime_error("Feature id must be a string or number");
+                } else {
+                    frames.emplace_back(Frame::Skip).depth = 1;
+                }
+                return true;
+            case Frame::Features:
+            case Frame::Geometries:
+                frames.emplace_back(Frame::Object);
+                return true;
+            case Frame::Coordinates:
+                throw std::runtime_error("coordinates must be arrays of numbers");
+            case Frame::Value:
+                top.containers.emplace_back(PropertyMap(), std::string());
+                return true;
+            case Frame::Skip:
+                ++top.depth;
+                return true;
+        }
+        return false;
+    }
+
+    bool Key(const char* key, rapidjson::SizeType length, bool) {
+        Frame& top = frames.back();
+        if (top.kind == Frame::Object) {
+            top.key.assign(key, length);
+        } else if (top.kind == Frame::Value) {
+            top.containers.back().second.assign(key, length);
+        }
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType) {
+        Frame& top = frames.back();
+        if (top.kind == Frame::Value) {
+            Value value = std::move(top.containers.back().first);
+            top.containers.pop_back();
+            if (top.containers.empty()) {
+                // End of the properties
+                PropertyMap properties = std::move(value.get<PropertyMap>());
+                frames.pop_back();
+                frames.back().object.properties = std::move(properties);
+            } else {
+                addValue(top, std::move(value));
+            }
+        } else if (top.kind == Frame::Skip) {
+            if (--top.depth == 0) {
+                frames.pop_back();
+            }
+        } else {
+            Object object = std::move(top.object);
+            frames.pop_back();
+            endObject(std::move(object));
+        }
+        return true;
+    }
+
+    bool StartArray() {
+        if (frames.empty()) {
+            throw std::runtime_error("GeoJSON must be an object");
+        }
+        Frame& top = frames.back();
+        switch (top.kind) {
+            case Frame::Object:
+                if (top.key == "coordinates") {
+                    auto& frame = frames.emplace_back(Frame::Coordinates);
+                    frame.open.push_back(0);
+                    frame.coordinates.counts.emplace_back();
+                } else if (top.key == "features") {
+                    top.object.features.emplace();
+                    frames.emplace_back(Frame::Features);
+                } else if (top.key == "geometries") {
+                    top.object.geometries.emplace();
+                    frames.emplace_back(Frame::Geometries);
+                } else if (top.key == "properties") {
+                    throw std::runtime_error("Feature properties must be an object");
+                } else if (top.key == "id") {
+                    throw std::runtime_error("Feature id must be a string or number");
+                } else if (top.key == "geometry" || top.key == "type") {
+                    throw std::runtime_error("invalid " + top.key + " member");
+                } else {
+                    frames.emplace_back(Frame::Skip).depth = 1;
+                }
+                return true;
+            case Frame::Features:
+            case Frame::Geometries:
+                throw std::runtime_error("features and geometries must be objects");
+            case Frame::Coordinates: {
+                auto& coordinates = top.coordinates;
+                const std::size_t depth = top.open.size();
+                if (coordinates.numberDepth && depth > *coordinates.numberDepth) {
+                    throw std::runtime_error("coordinates must be arrays of numbers");
+                }
+                ++top.open.back();
+                top.open.push_back(0);
+                if (coordinates.counts.size() <= depth) {
+                    coordinates.counts.emplace_back();
+                }
+                return true;
+            }
+            case Frame::Value:
+                top.containers.emplace_back(std::vector<Value>(), std::string());
+                return true;
+            case Frame::Skip:
+                ++top.depth;
+                return true;
+        }
+        return false;
+    }
+
+    bool EndArray(rapidjson::SizeType) {
+        Frame& top = frames.back();
+        switch (top.kind) {
+            case Frame::Coordinates:
+                top.coordinates.counts[top.open.size() - 1].push_back(top.open.back());
+                top.open.pop_back();
+                if (top.open.empty()) {
+                    Coordinates coordinates = std::move(top.coordinates);
+                    frames.pop_back();
+                    frames.back().object.coordinates = std::move(coordinates);
+                }
+                return true;
+            case Frame::Value: {
+                Value value = std::move(top.containers.back().first);
+                top.containers.pop_back();
+                addValue(top, std::move(value));
+                return true;
+            }
+            case Frame::Skip:
+                if (--top.depth == 0) {
+                    frames.pop_back();
+                }
+                return true;
+            default:
+                frames.pop_back();
+                return true;
+        }
+    }
+
+private:
+    struct Frame {
+        enum Kind : uint8_t {
+            Object,
+            Features,
+            Geometries,
+            Coordinates,
+            Value,
+            Skip
+        };
+
+        explicit Frame(Kind kind_)
+            : kind(kind_) {}
+
+        Kind kind;
+        // Object
+        conversion::Object object;
+        std::string key;
+        // Coordinates, with the element counts of the open arrays
+        conversion::Coordinates coordinates;
+        std::vector<std::size_t> open;
+        // Value, with the arrays and objects being read and their last key
+        std::vector<std::pair<mbgl::Value, std::string>> containers;
+        // Skip, with the number of open arrays and objects
+        std::size_t depth = 0;
+    };
+
+    static bool isMemberOfType(const std::string& key) {
+        return key == "coordinates" || key == "features" || key == "geometries";
+    }
+
+    static void addValue(Frame& frame, Value value) {
+        auto& container = frame.containers.back();
+        if (container.first.is<std::vector<Value>>()) {
+            container.first.get<std::vector<Value>>().push_back(std::move(value));
+        } else {
+            container.first.get<PropertyMap>()[container.second] = std::move(value);
+        }
+    }
+
+    bool scalar(Value value) {
+        if (frames.empty()) {
+            throw std::runtime_error("GeoJSON must be an object");
+        }
+        Frame& top = frames.back();
+        switch (top.kind) {
+            case Frame::Object:
+                member(top, std::move(value));
+                return true;
+            case Frame::Features:
+            case Frame::Geometries:
+                throw std::runtime_error("features and geometries must be objects");
+            case Frame::Coordinates: {
+                auto number = numericValue<double>(value);
+                const std::size_t depth = top.open.size() - 1;
+                if (!number || (top.coordinates.numberDepth && *top.coordinates.numberDepth != depth) ||
+                    top.coordinates.counts.size() > depth + 1) {
+                    throw std::runtime_error("coordinates must be arrays of numbers");
+                }
+                top.coordinates.numberDepth = depth;
+                top.coordinates.numbers.push_back(*number);
+                ++top.open.back();
+                return true;
+            }
+            case Frame::Value:
+                addValue(top, std::move(value));
+                return true;
+            case Frame::Skip:
+                return true;
+        }
+        return false;
+    }
+
+    static void member(Frame& frame, Value value) {
+        auto& object = frame.object;
+        if (frame.key == "type") {
+            if (!value.is<std::string>()) {
+                throw std::runtime_error("type must be a string");
+            }
+            object.type = std::move(value.get<std::string>());
+        } else if (frame.key == "id") {
+            value.match([&](uint64_t id) { object.id = id; },
+                        [&](int64_t id) { object.id = id; },
+                        [&](double id) { object.id = id; },
+                        [&](std::string& id) { object.id = std::move(id); },
+                        [&](const auto&) {
+                            throw std::runtime_error("Feature id must be a string or number");
+                        });
+        } else if (frame.key == "properties") {
+            if (!value.is<NullValue>()) {
+                throw std::runtime_error("Feature properties must be an object");
+            }
+        } else if (frame.key == "geometry") {
+            if (!value.is<NullValue>()) {
+                throw std::runtime_error("Feature geometry must be an object");
+            }
+            object.geometry = mapbox::geometry::empty();
+        } else if (isMemberOfType(frame.key)) {
+            throw std::runtime_error(frame.key + " must be an array");
+        }
+    }
+
+    void endObject(Object object) {
+        if (frames.empty()) {
+            result = object.toGeoJSON();
+            return;
+        }
+        Frame& parent = frames.back();
+        if (parent.kind == Frame::Features) {
+            frames[frames.size() - 2].object.features->push_back(object.toFeature());
+        } else if (parent.kind == Frame::Geometries) {
+            frames[frames.size() - 2].object.geometries->push_back(object.toGeometry());
+        } else {
+            // The geometry of a feature
+            parent.object.geometry = object.toGeometry();
+        }
+    }
+
+    std::vector<Frame> frames;
+};
+
+} // namespace
+
 std::optional<GeoJSON> parseGeoJSON(const std::string& value, Error& error) {
-    return convertJSON<GeoJSON>(value, error);
+    GeoJSONReader reader;
+    rapidjson::Reader parser;
+    rapidjson::StringStream stream(value.c_str());
+    try {
+        const rapidjson::ParseResult parsed = parser.Parse(stream, reader);
+        if (parsed.IsError()) {
+            error = {std::string{rapidjson::GetParseError_En(parsed.Code())} + " at offset " +
+                     util::toString(parsed.Offset())};
+            return std::nullopt;
+        }
+    } catch (const std::exception& ex) {
+        error = {ex.what()};
+        return std::nullopt;
+    }
+    if (!reader.result) {
+        error = {"GeoJSON must be an object"};
+    }
+    return std::move(reader.result);
 }
 
 } // namespace conversion
@@ -128,7 +128,7 @@ static std::optional<std::unique_ptr<Source>> convertGeoJSONSource(const std::st
         if (!geoJSON) {
             return std::nullopt;
         }
-        result->setGeoJSON(*geoJSON);
+        result->setGeoJSON(std::move(*geoJSON));
     } else if (toString(*dataValue)) {
         result->setURL(*toString(*dataValue));
     } else {
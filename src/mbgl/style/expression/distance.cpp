@@ -12,7 +12,9 @@
 #include <rapidjson/document.h>
 
 #include <algorithm>
+#include <cmath>
 #include <deque>
+#include <functional>
 #include <limits>
 #include <queue>
 #include <tuple>
@@ -769,10 +771,243 @@ std::optional<Feature::geometry_type> getGeometry(const Feature& feature,
 namespace style {
 namespace expression {
 
+// Points or line segments of the reference geometry in a packed R-tree, so
+// that a feature is only compared with the parts of the reference near it.
+// Distances are computed in geographic coordinates, so the index is built
+// once and shared by all tiles evaluating the expression.
+class Distance::ReferenceIndex {
+public:
+    static constexpr std::size_t nodeSize = 16;
+
+    // Returns nothing for polygons and invalid geometries, which are handled
+    // without an index
+    static std::unique_ptr<const ReferenceIndex> create(const Feature::geometry_type& geometry) {
+        std::vector<Item> items;
+        const bool indexed = geometry.match(
+            [&](const mapbox::geometry::point<double>& p) {
+                items.push_back({p, p});
+                return true;
+            },
+            [&](const mapbox::geometry::multi_point<double>& points) {
+                for (const auto& p : points) {
+                    items.push_back({p, p});
+                }
+                return !items.empty();
+            },
+            [&](const mapbox::geometry::line_string<double>& line) { return addLine(items, line); },
+            [&](const mapbox::geometry::multi_line_string<double>& lines) {
+                const bool valid = std::all_of(
+                    lines.begin(), lines.end(), [&](const auto& line) { return addLine(items, line); });
+                return valid && !items.empty();
+            },
+            [](const auto&) { return false; });
+        if (!indexed) {
+            return {};
+        }
+        return std::unique_ptr<const ReferenceIndex>(new ReferenceIndex(std::move(items)));
+    }
+
+    // Same result as calculateDistance()
+    double distance(const Feature::geometry_type& geometry) const {
+        return geometry.match(
+            [&](const mapbox::geometry::point<double>& point) {
+                return pointsDistance(mapbox::geometry::multi_point<double>{point});
+            },
+            [&](const mapbox::geometry::multi_point<double>& points) {
+                if (!isMultiPointValid(points)) return InvalidDistance;
+                return pointsDistance(points);
+            },
+            [&](const mapbox::geometry::line_string<double>& line) {
+                if (!isLineStringValid(line)) return InvalidDistance;
+                return lineDistance(line);
+            },
+            [&](const mapbox::geometry::multi_line_string<double>& lines) {
+                double dist = InfiniteDistance;
+                for (const auto& line : lines) {
+                    if (!isLineStringValid(line)) return InvalidDistance;
+                    dist = std::min(dist, lineDistance(line));
+                    if (dist == 0.0) return dist;
+                }
+                return dist;
+            },
+            [&](const mapbox::geometry::polygon<double>& polygon) {
+                if (!isPolygonValid(polygon)) return InvalidDistance;
+                return polygonDistance(polygon);
+            },
+            [&](const mapbox::geometry::multi_polygon<double>& polygons) {
+                double dist = InfiniteDistance;
+                for (const auto& polygon : polygons) {
+                    if (!isPolygonValid(polygon)) return InvalidDistance;
+                    dist = std::min(dist, polygonDistance(polygon));
+                    if (dist == 0.0) return dist;
+                }
+                return dist;
+            },
+            [](const auto&) { return InvalidDistance; });
+    }
+
+private:
+    // A reference point has both ends at the same place
+    struct Item {
+        mapbox::geometry::point<double> a;
+        mapbox::geometry::point<double> b;
+
+        bool isPoint() const { return a == b; }
+    };
+
+    struct Node {
+        DistanceBBox bbox = DefaultDistanceBBox;
+        // Children are items for leaves, and nodes otherwise
+        std::size_t begin;
+        std::size_t end;
+        bool leaf;
+    };
+
+    static bool addLine(std::vector<Item>& items, const mapbox::geometry::line_string<double>& line) {
+        if (!isLineStringValid(line)) return false;
+        for (std::size_t i = 0; i + 1 < line.size(); ++i) {
+            items.push_back({line[i], line[i + 1]});
+        }
+        return true;
+    }
+
+    explicit ReferenceIndex(std::vector<Item> items_)
+        : items(std::move(items_)) {
+        // Sort-Tile-Recursive packing: vertical slabs sorted by x, each of
+        // them sorted by y
+        const auto centerX = [](const Item& item) {
+            return item.a.x + item.b.x;
+        };
+        const auto centerY = [](const Item& item) {
+            return item.a.y + item.b.y;
+        };
+        const std::size_t leafCount = (items.size() + nodeSize - 1) / nodeSize;
+        const auto slabCount = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(leafCount))));
+        const std::size_t slabSize = slabCount * nodeSize;
+        std::sort(items.begin(), items.end(), [&](const Item& lhs, const Item& rhs) {
+            return centerX(lhs) < centerX(rhs);
+        });
+        for (std::size_t begin = 0; begin < items.size(); begin += slabSize) {
+            const auto end = items.begin() + std::min(begin + slabSize, items.size());
+            std::sort(items.begin() + begin, end, [&](const Item& lhs, const Item& rhs) {
+                return centerY(lhs) < centerY(rhs);
+            });
+        }
+
+        for (std::size_t begin = 0; begin < items.size(); begin += nodeSize) {
+            Node node{DefaultDistanceBBox, begin, std::min(begin + nodeSize, items.size()), true};
+            for (std::size_t i = node.begin; i < node.end; ++i) {
+                updateBBox(node.bbox, items[i].a);
+                updateBBox(node.bbox, items[i].b);
+            }
+            nodes.push_back(node);
+        }
+        for (std::size_t levelBegin = 0, levelEnd = nodes.size(); levelEnd - levelBegin > 1;) {
+            for (std::size_t begin = levelBegin; begin < levelEnd; begin += nodeSize) {
+                Node node{DefaultDistanceBBox, begin, std::min(begin + nodeSize, levelEnd), false};
+                for (std::size_t i = node.begin; i < node.end; ++i) {
+                    updateBBox(node.bbox, Point<double>(nodes[i].bbox[0], nodes[i].bbox[1]));
+                    updateBBox(node.bbox, Point<double>(nodes[i].bbox[2], nodes[i].bbox[3]));
+                }
+                nodes.push_back(node);
+            }
+            levelBegin = levelEnd;
+            levelEnd = nodes.size();
+        }
+    }
+
+    // Best first search of the items nearest to a feature with the given
+    // bounding box. Nodes farther than the nearest item found so far are
+    // skipped.
+    template <typename ItemDistance>
+    double nearest(const DistanceBBox& bbox,
+                   mapbox::cheap_ruler::CheapRuler& ruler,
+                   const ItemDistance& itemDistance) const {
+        using Entry = std::pair<double, std::size_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+        queue.emplace(bboxToBBoxDistance(bbox, nodes.back().bbox, ruler), nodes.size() - 1);
+
+        double miniDist = InfiniteDistance;
+        while (!queue.empty()) {
+            const auto entry = queue.top();
+            queue.pop();
+            if (entry.first >= miniDist) break;
+
+            const Node& node = nodes[entry.second];
+            for (std::size_t i = node.begin; i < node.end; ++i) {
+                if (node.leaf) {
+                    miniDist = std::min(miniDist, itemDistance(items[i]));
+                    if (miniDist == 0.0) return 0.0;
+                } else {
+                    const auto dist = bboxToBBoxDistance(bbox, nodes[i].bbox, ruler);
+                    if (dist < miniDist) queue.emplace(dist, i);
+                }
+            }
+        }
+        return miniDist;
+    }
+
+    double pointsDistance(const mapbox::geometry::multi_point<double>& points) const {
+        mapbox::cheap_ruler::CheapRuler ruler(points.front().y, UnitInMeters);
+        return nearest(getBBox(points, IndexRange(0, points.size() - 1)), ruler, [&](const Item& item) {
+            double dist = InfiniteDistance;
+            for (const auto& p : points) {
+                dist = std::min(dist,
+                                item.isPoint() ? ruler.distance(p, item.a)
+                                               : pointToLineDistance(
+                                                     p, mapbox::geometry::line_string<double>{item.a, item.b}, ruler));
+                if (dist == 0.0) break;
+            }
+            return dist;
+        });
+    }
+
+    double lineDistance(const mapbox::geometry::line_string<double>& line) const {
+        mapbox::cheap_ruler::CheapRuler ruler(line.front().y, UnitInMeters);
+        return nearest(getBBox(line, IndexRange(0, line.size() - 1)), ruler, [&](const Item& item) {
+            if (item.isPoint()) {
+                return pointToLineDistance(item.a, line, ruler);
+            }
+            double dist = InfiniteDistance;
+            for (std::size_t i = 0; i + 1 < line.size(); ++i) {
+                if (segmentIntersectSegment(line[i], line[i + 1], item.a, item.b)) return 0.0;
+                dist = std::min(dist, segmentToSegmentDistance(line[i], line[i + 1], item.a, item.b, ruler));
+            }
+            return dist;
+        });
+    }
+
+    double polygonDistance(const mapbox::geometry::polygon<double>& polygon) const {
+        mapbox::cheap_ruler::CheapRuler ruler(polygon.front().front().y, UnitInMeters);
+        return nearest(getBBox(polygon), ruler, [&](const Item& item) {
+            if (item.isPoint()) {
+                return pointToPolygonDistance(item.a, polygon, ruler);
+            }
+            if (pointWithinPolygon(item.a, polygon, true /*trueOnBoundary*/) ||
+                pointWithinPolygon(item.b, polygon, true /*trueOnBoundary*/)) {
+                return 0.0;
+            }
+            double dist = InfiniteDistance;
+            for (const auto& ring : polygon) {
+                for (std::size_t j = 0, len = ring.size(), k = len - 1; j < len; k = j++) {
+                    if (segmentIntersectSegment(item.a, item.b, ring[k], ring[j])) return 0.0;
+                    dist = std::min(dist, segmentToSegmentDistance(item.a, item.b, ring[k], ring[j], ruler));
+                }
+            }
+            return dist;
+        });
+    }
+
+    std::vector<Item> items;
+    // Leaves first, the root last
+    std::vector<Node> nodes;
+};
+
 Distance::Distance(GeoJSON geojson, Feature::geometry_type geometries_)
     : Expression(Kind::Distance, type::Number),
       geoJSONSource(std::move(geojson)),
-      geometries(std::move(geometries_)) {}
+      geometries(std::move(geometries_)),
+      index(ReferenceIndex::create(geometries)) {}
 
 Distance::~Distance() = default;
 
@@ -787,7 +1022,8 @@ EvaluationResult Distance::evaluate(const EvaluationContext& params) const {
     auto geometryType = params.feature->getType();
     if (geometryType == FeatureType::Point || geometryType == FeatureType::LineString ||
         geometryType == FeatureType::Polygon) {
-        auto distance = calculateDistance(*params.feature, *params.canonical, geometries);
+        auto distance = index ? index->distance(convertGeometry(*params.feature, *params.canonical))
+                              : calculateDistance(*params.feature, *params.canonical, geometries);
         if (!std::isnan(distance)) {
             assert(distance >= 0.0);
             return distance;
@@ -13,6 +13,10 @@
 #include <mbgl/math/angles.hpp>
 #include <mbgl/math/clamp.hpp>
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
 namespace mbgl {
 namespace {
 
@@ -52,24 +56,28 @@ Polygon<int64_t> getTilePolygon(const Polygon<double>& polygon,
     return result;
 }
 
-MultiPolygon<int64_t> getTilePolygons(const Feature::geometry_type& polygonGeoSet,
-                                      const mbgl::CanonicalTileID& canonical,
-                                      WithinBBox& bbox) {
-    return polygonGeoSet.match(
-        [&canonical, &bbox](const mapbox::geometry::multi_polygon<double>& polygons) {
-            MultiPolygon<int64_t> result;
-            result.reserve(polygons.size());
+// Polygons of a `within` expression in the coordinates of one tile
+struct TilePolygons {
+    WithinBBox bbox = DefaultWithinBBox;
+    std::vector<IndexedPolygon<int64_t>> polygons;
+};
+
+std::shared_ptr<const TilePolygons> getTilePolygons(const Feature::geometry_type& polygonGeoSet,
+                                                    const mbgl::CanonicalTileID& canonical) {
+    auto result = std::make_shared<TilePolygons>();
+    const auto addPolygon = [&](const mapbox::geometry::polygon<double>& polygon) {
+        result->polygons.emplace_back(getTilePolygon(polygon, canonical, result->bbox));
+    };
+    polygonGeoSet.match(
+        [&](const mapbox::geometry::multi_polygon<double>& polygons) {
+            result->polygons.reserve(polygons.size());
             for (const auto& pg : polygons) {
-                result.push_back(getTilePolygon(pg, canonical, bbox));
+                addPolygon(pg);
             }
-            return result;
         },
-        [&canonical, &bbox](const mapbox::geometry::polygon<double>& polygon) {
-            MultiPolygon<int64_t> result;
-            result.push_back(getTilePolygon(polygon, canonical, bbox));
-            return result;
-        },
-        [](const auto&) { return MultiPolygon<int64_t>(); });
+        [&](const mapbox::geometry::polygon<double>& polygon) { addPolygon(polygon); },
+        [](const auto&) {});
+    return result;
 }
 
 void updatePoint(Point<int64_t>& p, WithinBBox& bbox, const WithinBBox& polyBBox, const int64_t worldSize) {
@@ -142,9 +150,9 @@ MultiLineString<int64_t> getTileLines(const GeometryCollection& lines,
 
 bool featureWithinPolygons(const GeometryTileFeature& feature,
                            const CanonicalTileID& canonical,
-                           const Feature::geometry_type& polygonGeoSet) {
-    WithinBBox polyBBox = DefaultWithinBBox;
-    const auto polygons = getTilePolygons(polygonGeoSet, canonical, polyBBox);
+                           const TilePolygons& tilePolygons) {
+    const WithinBBox& polyBBox = tilePolygons.bbox;
+    const auto& polygons = tilePolygons.polygons;
     assert(!polygons.empty());
     const GeometryCollection& geometries = feature.getGeometries();
     switch (feature.getType()) {
@@ -205,10 +213,56 @@ std::optional<Feature::geometry_type> getPolygonInfo(const Feature& polyFeature,
 namespace style {
 namespace expression {
 
+// Features of a tile are evaluated one after the other, so the polygons only
+// need projecting once per tile. Workers evaluate different tiles at the same
+// time, and the least recently used tiles are dropped past the capacity.
+class Within::TilePolygonsCache {
+public:
+    static constexpr std::size_t capacity = 16;
+
+    std::shared_ptr<const TilePolygons> get(const Feature::geometry_type& polygonGeoSet,
+                                            const CanonicalTileID& canonical) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (auto it = tiles.find(canonical); it != tiles.end()) {
+                order.splice(order.begin(), order, it->second.second);
+                return it->second.first;
+            }
+        }
+
+        auto polygons = getTilePolygons(polygonGeoSet, canonical);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto result = tiles.try_emplace(canonical);
+        auto& item = result.first->second;
+        if (!result.second) {
+            // Another worker projected them in the meantime
+            return item.first;
+        }
+        item.first = polygons;
+        order.push_front(canonical);
+        item.second = order.begin();
+        if (tiles.size() > capacity) {
+            tiles.erase(order.back());
+            order.pop_back();
+        }
+        return polygons;
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<CanonicalTileID,
+                       std::pair<std::shared_ptr<const TilePolygons>, std::list<CanonicalTileID>::iterator>>
+        tiles;
+    // Most recently used first
+    std::list<CanonicalTileID> order;
+};
+
 Within::Within(GeoJSON geojson, Feature::geometry_type geometries_)
     : Expression(Kind::Within, type::Boolean),
       geoJSONSource(std::move(geojson)),
-      geometries(std::move(geometries_)) {}
+      geometries(std::move(geometries_)),
+      tilePolygons(std::make_unique<TilePolygonsCache>()) {}
 
 Within::~Within() = default;
 
@@ -221,7 +275,8 @@ EvaluationResult Within::evaluate(const EvaluationContext& params) const {
     auto geometryType = params.feature->getType();
     // Currently only support Point and LineString types in Polygon/Polygons
     if (geometryType == FeatureType::Point || geometryType == FeatureType::LineString) {
-        return featureWithinPolygons(*params.feature, *params.canonical, geometries);
+        return featureWithinPolygons(
+            *params.feature, *params.canonical, *tilePolygons->get(geometries, *params.canonical));
     }
     mbgl::Log::Warning(mbgl::Event::General,
                        "within expression currently only support Point/LineString geometry "
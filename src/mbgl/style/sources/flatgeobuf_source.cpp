@@ -0,0 +1,70 @@
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/style/layer.hpp>
+#include <mbgl/style/source_observer.hpp>
+#include <mbgl/style/sources/flatgeobuf_source.hpp>
+#include <mbgl/style/sources/flatgeobuf_source_impl.hpp>
+#include <mbgl/tile/tile.hpp>
+
+#include <exception>
+#include <utility>
+
+namespace mbgl {
+namespace style {
+
+FlatGeobufSource::FlatGeobufSource(std::string id, std::string path_, Immutable<GeoJSONOptions> options)
+    : Source(makeMutable<Impl>(std::move(id), std::move(options))),
+      path(std::move(path_)),
+      threadPool(Scheduler::GetBackground()) {}
+
+FlatGeobufSource::~FlatGeobufSource() = default;
+
+const FlatGeobufSource::Impl& FlatGeobufSource::impl() const {
+    return static_cast<const Impl&>(*baseImpl);
+}
+
+const std::string& FlatGeobufSource::getPath() const {
+    return path;
+}
+
+const GeoJSONOptions& FlatGeobufSource::getOptions() const {
+    return *impl().getOptions();
+}
+
+void FlatGeobufSource::loadDescription(FileSource&) {
+    if (loaded || opening) {
+        return;
+    }
+    opening = true;
+
+    using Result = std::pair<std::shared_ptr<GeoJSONData>, std::exception_ptr>;
+    auto openInBackground = [path_ = path, options = impl().getOptions(), tileScheduler = threadPool]() -> Result {
+        try {
+            return {Impl::createData(path_, *options, tileScheduler), nullptr};
+        } catch (...) {
+            return {nullptr, std::current_exception()};
+        }
+    };
+    auto onOpened = [this, self = makeWeakPtr()](const Result& result) {
+        if (!self) return; // This source has been deleted.
+        opening = false;
+        if (result.second) {
+            observer->onSourceError(*this, result.second);
+            return;
+        }
+        baseImpl = makeMutable<Impl>(impl(), result.first);
+        loaded = true;
+        observer->onSourceLoaded(*this);
+    };
+    threadPool->scheduleAndReplyValue(openInBackground, onOpened);
+}
+
+bool FlatGeobufSource::supportsLayerType(const mbgl::style::LayerTypeInfo* info) const {
+    return mbgl::underlying_type(Tile::Kind::Geometry) == mbgl::underlying_type(info->tileKind);
+}
+
+Mutable<Source::Impl> FlatGeobufSource::createMutable() const noexcept {
+    return staticMutableCast<Source::Impl>(makeMutable<Impl>(impl()));
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,183 @@
+#include <mbgl/style/sources/flatgeobuf_source_impl.hpp>
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/math/angles.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/flatgeobuf.hpp>
+#include <mbgl/util/logging.hpp>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4244)
+#endif
+
+#include <mapbox/geojsonvt.hpp>
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <exception>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace mbgl {
+namespace style {
+
+namespace {
+
+// Features of the most recently made tiles. Tiles at low zooms cover most of
+// the file, so making them again when they are reloaded or revisited would
+// decode most of it again.
+class FlatGeobufTileCache {
+public:
+    static constexpr std::size_t capacity = 64;
+
+    std::shared_ptr<const GeoJSONData::TileFeatures> find(const CanonicalTileID& id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = tiles.find(id);
+        if (it == tiles.end()) {
+            return {};
+        }
+        order.splice(order.begin(), order, it->second.second);
+        return it->second.first;
+    }
+
+    void insert(const CanonicalTileID& id, std::shared_ptr<const GeoJSONData::TileFeatures> features) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto result = tiles.try_emplace(id);
+        auto& item = result.first->second;
+        item.first = std::move(features);
+        if (!result.second) {
+            order.splice(order.begin(), order, item.second);
+            return;
+        }
+        order.push_front(id);
+        item.second = order.begin();
+        if (tiles.size() > capacity) {
+            tiles.erase(order.back());
+            order.pop_back();
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<CanonicalTileID,
+                       std::pair<std::shared_ptr<const GeoJSONData::TileFeatures>, std::list<CanonicalTileID>::iterator>>
+        tiles;
+    // Most recently used first
+    std::list<CanonicalTileID> order;
+};
+
+class FlatGeobufData final : public GeoJSONData {
+public:
+    FlatGeobufData(std::shared_ptr<const util::FlatGeobufFile> file_,
+                   const GeoJSONOptions& options,
+                   std::shared_ptr<Scheduler> scheduler_)
+        : file(std::move(file_)),
+          scheduler(std::move(scheduler_)) {
+        constexpr double scale = util::EXTENT / util::tileSize_D;
+        tileOptions.extent = util::EXTENT;
+        tileOptions.buffer = static_cast<uint16_t>(::round(scale * options.buffer));
+        tileOptions.tolerance = scale * options.tolerance;
+        tileOptions.lineMetrics = options.lineMetrics;
+    }
+
+    void getTile(const CanonicalTileID& id, const std::function<void(TileFeatures)>& fn) final {
+        assert(fn);
+        scheduler->scheduleAndReplyValue(
+            [id, file = file, cache = cache, tileOptions = tileOptions]() -> TileFeatures {
+                if (auto cached = cache->find(id)) {
+                    return *cached;
+                }
+                try {
+                    auto features = std::make_shared<const TileFeatures>(getTileFeatures(*file, id, tileOptions));
+                    cache->insert(id, features);
+                    return *features;
+                } catch (const std::exception& ex) {
+                    // A corrupt file leaves the tile empty
+                    Log::Error(Event::ParseTile,
+                               "Failed to read FlatGeobuf tile " + util::toString(id) + ": " + ex.what());
+                    return {};
+                }
+            },
+            fn);
+    }
+
+    Features getChildren(const std::uint32_t) final { return {}; }
+
+    Features getLeaves(const std::uint32_t, const std::uint32_t, const std::uint32_t) final { return {}; }
+
+    std::uint8_t getClusterExpansionZoom(std::uint32_t) final { return 0; }
+
+    std::shared_ptr<Scheduler> getScheduler() final { return scheduler; }
+
+private:
+    // Reads the features around the tile, then clips and simplifies them
+    // like geojson-vt does for the tile
+    static TileFeatures getTileFeatures(const util::FlatGeobufFile& file,
+                                        const CanonicalTileID& id,
+                                        const mapbox::geojsonvt::TileOptions& tileOptions) {
+        const double tiles = std::pow(2.0, id.z);
+        const double buffer = static_cast<double>(tileOptions.buffer) / tileOptions.extent;
+        const auto longitude = [&](double x) {
+            return x / tiles * util::DEGREES_MAX - util::LONGITUDE_MAX;
+        };
+        const auto latitude = [&](double y) {
+            return util::rad2deg(std::atan(std::sinh(M_PI * (1 - 2 * y / tiles))));
+        };
+        auto features = file.query({{longitude(id.x - buffer), latitude(id.y + 1 + buffer)},
+                                    {longitude(id.x + 1 + buffer), latitude(id.y - buffer)}});
+        if (features.empty()) {
+            return {};
+        }
+        return mapbox::geojsonvt::geoJSONToTile(
+                   GeoJSON{std::move(features)}, id.z, id.x, id.y, tileOptions, false /*wrap*/, true /*clip*/)
+            .features;
+    }
+
+    // Accessed on worker threads
+    std::shared_ptr<const util::FlatGeobufFile> file;
+    std::shared_ptr<FlatGeobufTileCache> cache = std::make_shared<FlatGeobufTileCache>();
+    mapbox::geojsonvt::TileOptions tileOptions;
+    // Reading is thread-safe, so tiles are made in parallel
+    std::shared_ptr<Scheduler> scheduler;
+};
+
+} // namespace
+
+FlatGeobufSource::Impl::Impl(std::string id_, Immutable<GeoJSONOptions> options_)
+    : Source::Impl(SourceType::FlatGeobuf, std::move(id_)),
+      options(std::move(options_)) {}
+
+FlatGeobufSource::Impl::Impl(const FlatGeobufSource::Impl& other, std::shared_ptr<GeoJSONData> data_)
+    : Source::Impl(other),
+      options(other.options),
+      data(std::move(data_)) {}
+
+FlatGeobufSource::Impl::~Impl() = default;
+
+Range<uint8_t> FlatGeobufSource::Impl::getZoomRange() const {
+    return {options->minzoom, options->maxzoom};
+}
+
+std::weak_ptr<GeoJSONData> FlatGeobufSource::Impl::getData() const {
+    return data;
+}
+
+std::optional<std::string> FlatGeobufSource::Impl::getAttribution() const {
+    return {};
+}
+
+std::shared_ptr<GeoJSONData> FlatGeobufSource::Impl::createData(const std::string& path,
+                                                                const GeoJSONOptions& options,
+                                                                std::shared_ptr<Scheduler> scheduler) {
+    return std::make_shared<FlatGeobufData>(
+        std::make_shared<const util::FlatGeobufFile>(path), options, std::move(scheduler));
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <mbgl/style/source_impl.hpp>
+#include <mbgl/style/sources/flatgeobuf_source.hpp>
+#include <mbgl/util/range.hpp>
+
+namespace mbgl {
+namespace style {
+
+class FlatGeobufSource::Impl final : public Source::Impl {
+public:
+    Impl(std::string id, Immutable<GeoJSONOptions>);
+    Impl(const FlatGeobufSource::Impl&, std::shared_ptr<GeoJSONData>);
+    ~Impl() final;
+
+    Range<uint8_t> getZoomRange() const;
+    std::weak_ptr<GeoJSONData> getData() const;
+    const Immutable<GeoJSONOptions>& getOptions() const { return options; }
+
+    std::optional<std::string> getAttribution() const final;
+
+    // Opens the file, whose tiles are then made on the scheduler. Throws if
+    // the file cannot be read.
+    static std::shared_ptr<GeoJSONData> createData(const std::string& path,
+                                                   const GeoJSONOptions&,
+                                                   std::shared_ptr<Scheduler>);
+
+private:
+    Immutable<GeoJSONOptions> options;
+    std::shared_ptr<GeoJSONData> data;
+};
+
+} // namespace style
+} // namespace mbgl
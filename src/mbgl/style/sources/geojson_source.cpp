@@ -1,6 +1,5 @@
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/style/conversion/geojson.hpp>
-#include <mbgl/style/conversion/json.hpp>
 #include <mbgl/style/layer.hpp>
 #include <mbgl/style/source_observer.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
@@ -10,6 +9,8 @@
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/thread_pool.hpp>
 
+#include <tuple>
+
 namespace mbgl {
 namespace style {
 
@@ -21,7 +22,9 @@ Immutable<GeoJSONOptions> GeoJSONOptions::defaultOptions() {
 
 GeoJSONSource::GeoJSONSource(std::string id, Immutable<GeoJSONOptions> options)
     : Source(makeMutable<Impl>(std::move(id), std::move(options))),
-      threadPool(Scheduler::GetBackground()) {}
+      threadPool(Scheduler::GetBackground()),
+      features(std::make_shared<GeoJSONFeatureStore>()),
+      dataRequest(std::make_shared<std::atomic<std::uint64_t>>(0)) {}
 
 GeoJSONSource::~GeoJSONSource() = default;
 
@@ -31,10 +34,12 @@ const GeoJSONSource::Impl& GeoJSONSource::impl() const {
 
 void GeoJSONSource::setURL(const std::string& url_) {
     url = url_;
+    ++*dataRequest;
 
     // Signal that the source description needs a reload
-    if (loaded || req) {
+    if (loaded || req || building) {
         loaded = false;
+        building = false;
         req.reset();
         observer->onSourceDescriptionChanged(*this);
     }
@@ -42,22 +47,99 @@ void GeoJSONSource::setURL(const std::string& url_) {
 
 namespace {
 
-inline std::shared_ptr<GeoJSONData> createGeoJSONData(const mapbox::geojson::geojson& geoJSON,
-                                                      const GeoJSONSource::Impl& impl) {
+// Keeps fetching the tiles of new data on the same scheduler
+inline std::shared_ptr<Scheduler> getTileScheduler(const GeoJSONSource::Impl& impl) {
     if (auto data = impl.getData().lock()) {
-        return GeoJSONData::create(geoJSON, impl.getOptions(), data->getScheduler());
+        return data->getScheduler();
     }
-    return GeoJSONData::create(geoJSON, impl.getOptions());
+    return nullptr;
 }
 
 } // namespace
 
 void GeoJSONSource::setGeoJSON(const mapbox::geojson::geojson& geoJSON) {
-    setGeoJSONData(createGeoJSONData(geoJSON, impl()));
+    setGeoJSON(GeoJSON(geoJSON));
+}
+
+void GeoJSONSource::setGeoJSON(GeoJSON&& geoJSON) {
+    req.reset();
+    // Moved into the store by the only build applying the change
+    buildData([geoJSON = std::make_shared<GeoJSON>(std::move(geoJSON))](GeoJSONFeatureStore& store) {
+        store.reset(std::move(*geoJSON));
+    });
+}
+
+void GeoJSONSource::updateFeatures(GeoJSONData::Features add,
+                                   GeoJSONData::Features update,
+                                   std::vector<FeatureIdentifier> remove) {
+    if (!features) {
+        Log::Warning(Event::General,
+                     "Ignoring feature updates of GeoJSON source " + getID() + ", whose data were set directly");
+        return;
+    }
+
+    using Changes = std::tuple<GeoJSONData::Features, GeoJSONData::Features, std::vector<FeatureIdentifier>>;
+    buildData([id = getID(),
+               changes = std::make_shared<Changes>(std::move(add), std::move(update), std::move(remove))](
+                  GeoJSONFeatureStore& store) {
+        if (!store.update(
+                std::move(std::get<0>(*changes)), std::move(std::get<1>(*changes)), std::get<2>(*changes))) {
+            Log::Warning(Event::General,
+                         "Ignoring feature updates of GeoJSON source " + id +
+                             ", whose data were indexed before its first update and not kept");
+        }
+    });
+}
+
+void GeoJSONSource::buildData(std::function<void(GeoJSONFeatureStore&)> change) {
+    auto tileScheduler = getTileScheduler(impl());
+    if (!features) {
+        features = std::make_shared<GeoJSONFeatureStore>();
+    }
+    features->queue(std::move(change));
+    const std::uint64_t request = ++*dataRequest;
+
+    if (!Scheduler::GetCurrent()) {
+        // Without a run loop to reply to, the data are built right away
+        building = false;
+        baseImpl = makeMutable<Impl>(
+            impl(), features->build(impl().getOptions(), std::move(tileScheduler), *dataRequest, request));
+        observer->onSourceChanged(*this);
+        return;
+    }
+
+    // Builds may run at the same time on the thread pool, the store applies
+    // the changes in order and the latest build indexes them
+    auto makeDataInBackground = [store = features,
+                                 latest = dataRequest,
+                                 request,
+                                 options = impl().getOptions(),
+                                 tileScheduler]() -> std::shared_ptr<GeoJSONData> {
+        return store->build(options, tileScheduler, *latest, request);
+    };
+    auto onDataReady = [this, self = makeWeakPtr(), request](std::shared_ptr<GeoJSONData> data) {
+        if (!self) return;                   // This source has been deleted.
+        if (request != *dataRequest) return; // Newer data are being built, or were set.
+
+        building = false;
+        baseImpl = makeMutable<Impl>(impl(), std::move(data));
+        loaded = true;
+        observer->onSourceLoaded(*this);
+    };
+    building = true;
+    loaded = false;
+    threadPool->scheduleAndReplyValue(makeDataInBackground, onDataReady);
 }
 
 void GeoJSONSource::setGeoJSONData(std::shared_ptr<GeoJSONData> geoJSONData) {
     req.reset();
+    ++*dataRequest;
+    if (building) {
+        building = false;
+        loaded = true;
+    }
+    // The data have no features to update, and pending builds are discarded
+    features.reset();
     baseImpl = makeMutable<Impl>(impl(), std::move(geoJSONData));
     observer->onSourceChanged(*this);
 }
@@ -72,7 +154,8 @@ const GeoJSONOptions& GeoJSONSource::getOptions() const {
 
 void GeoJSONSource::loadDescription(FileSource& fileSource) {
     if (!url) {
-        loaded = true;
+        // Otherwise, loaded once the data are built
+        if (!building) loaded = true;
         return;
     }
 
@@ -88,30 +171,17 @@ void GeoJSONSource::loadDescription(FileSource& fileSource) {
         } else if (res.noContent) {
             observer->onSourceError(*this, std::make_exception_ptr(std::runtime_error("unexpectedly empty GeoJSON")));
         } else {
-            auto makeImplInBackground = [currentImpl = baseImpl, data = res.data]() -> Immutable<Source::Impl> {
+            buildData([data = res.data](GeoJSONFeatureStore& store) {
                 assert(data);
-                auto& current = static_cast<const Impl&>(*currentImpl);
                 conversion::Error error;
-                std::shared_ptr<GeoJSONData> geoJSONData;
-                if (std::optional<GeoJSON> geoJSON = conversion::convertJSON<GeoJSON>(*data, error)) {
-                    geoJSONData = createGeoJSONData(*geoJSON, current);
-                } else {
-                    // Create an empty GeoJSON VT object to make sure we're not
-                    // infinitely waiting for tiles to load.
+                std::optional<GeoJSON> geoJSON = conversion::parseGeoJSON(*data, error);
+                if (!geoJSON) {
+                    // Build empty data, so that tiles do not wait for them forever
                     Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: " + error.message);
+                    geoJSON = GeoJSON{GeoJSONData::Features{}};
                 }
-                return makeMutable<Impl>(current, std::move(geoJSONData));
-            };
-            auto onImplReady = [this, self = makeWeakPtr(), capturedReq = req.get()](Immutable<Source::Impl> newImpl) {
-                assert(capturedReq);
-                if (!self) return;                    // This source has been deleted.
-                if (capturedReq != req.get()) return; // A new request is being processed, ignore this impl.
-
-                baseImpl = std::move(newImpl);
-                loaded = true;
-                observer->onSourceLoaded(*this);
-            };
-            threadPool->scheduleAndReplyValue(makeImplInBackground, onImplReady);
+                store.reset(std::move(*geoJSON));
+            });
         }
     });
 }
@@ -1,4 +1,6 @@
 #include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/math/clamp.hpp>
+#include <mbgl/style/expression/literal.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/feature.hpp>
@@ -10,6 +12,7 @@
 #pragma warning(disable : 4244)
 #endif
 
+#include <mapbox/geometry/envelope.hpp>
 #include <mapbox/geojsonvt.hpp>
 #include <supercluster.hpp>
 
@@ -18,6 +21,7 @@
 #endif
 
 #include <cmath>
+#include <limits>
 
 namespace mbgl {
 namespace style {
@@ -37,39 +41,94 @@ class GeoJSONVTData final : public GeoJSONData {
 
     std::shared_ptr<Scheduler> getScheduler() final { return scheduler; }
 
+    bool isTileChanged(const CanonicalTileID& id, const GeoJSONData& previous) const final {
+        if (&previous == this) {
+            return false;
+        }
+        // Walk back to the previous data, through the changes made since
+        for (auto it = changes.rbegin(); it != changes.rend(); ++it) {
+            for (const auto& box : it->boxes) {
+                if (intersects(box, id)) {
+                    return true;
+                }
+            }
+            if (it->data.lock().get() == &previous) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Whether the box touches the tile or its buffer, which geojson-vt fills
+    // with the features around the tile
+    bool intersects(const GeoJSONFeatureStore::Box& box, const CanonicalTileID& id) const {
+        const double tiles = std::pow(2.0, id.z);
+        const double minX = (id.x - buffer) / tiles;
+        const double maxX = (id.x + 1 + buffer) / tiles;
+        const double minY = (id.y - buffer) / tiles;
+        const double maxY = (id.y + 1 + buffer) / tiles;
+        if (box.min.y > maxY || box.max.y < minY) {
+            return false;
+        }
+        // Features are also wrapped around the antimeridian
+        for (const double shift : {-1.0, 0.0, 1.0}) {
+            if (box.min.x + shift <= maxX && box.max.x + shift >= minX) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     friend GeoJSONData;
+    friend GeoJSONFeatureStore;
     GeoJSONVTData(const GeoJSON& geoJSON,
                   const mapbox::geojsonvt::Options& options,
-                  std::shared_ptr<Scheduler> scheduler_)
+                  std::shared_ptr<Scheduler> scheduler_,
+                  std::deque<GeoJSONFeatureStore::Change> changes_ = {})
         : impl(std::make_shared<mapbox::geojsonvt::GeoJSONVT>(geoJSON, options)),
-          scheduler(std::move(scheduler_)) {
+          scheduler(std::move(scheduler_)),
+          buffer(static_cast<double>(options.buffer) / options.extent),
+          changes(std::move(changes_)) {
         assert(scheduler);
     }
 
     std::shared_ptr<mapbox::geojsonvt::GeoJSONVT> impl; // Accessed on worker thread.
     std::shared_ptr<Scheduler> scheduler;
+    // Buffer around the tiles, in tiles
+    double buffer;
+    std::deque<GeoJSONFeatureStore::Change> changes;
 };
 
 class SuperclusterData final : public GeoJSONData {
     void getTile(const CanonicalTileID& id, const std::function<void(TileFeatures)>& fn) final {
         assert(fn);
-        fn(impl.getTile(id.z, id.x, id.y));
+        scheduler->scheduleAndReplyValue(
+            [id, impl = this->impl]() -> TileFeatures { return impl->getTile(id.z, id.x, id.y); }, fn);
     }
 
-    Features getChildren(const std::uint32_t cluster_id) final { return impl.getChildren(cluster_id); }
+    Features getChildren(const std::uint32_t cluster_id) final { return impl->getChildren(cluster_id); }
 
     Features getLeaves(const std::uint32_t cluster_id, const std::uint32_t limit, const std::uint32_t offset) final {
-        return impl.getLeaves(cluster_id, limit, offset);
+        return impl->getLeaves(cluster_id, limit, offset);
     }
 
     std::uint8_t getClusterExpansionZoom(std::uint32_t cluster_id) final {
-        return impl.getClusterExpansionZoom(cluster_id);
+        return impl->getClusterExpansionZoom(cluster_id);
     }
 
+    std::shared_ptr<Scheduler> getScheduler() final { return scheduler; }
+
     friend GeoJSONData;
-    SuperclusterData(const Features& features, const mapbox::supercluster::Options& options)
-        : impl(features, options) {}
-    mapbox::supercluster::Supercluster impl;
+    SuperclusterData(const Features& features,
+                     const mapbox::supercluster::Options& options,
+                     std::shared_ptr<Scheduler> scheduler_)
+        : impl(std::make_shared<mapbox::supercluster::Supercluster>(features, options)),
+          scheduler(std::move(scheduler_)) {
+        assert(scheduler);
+    }
+
+    std::shared_ptr<mapbox::supercluster::Supercluster> impl; // Read on worker thread.
+    std::shared_ptr<Scheduler> scheduler;
 };
 
 template <class T>
@@ -86,6 +145,165 @@ T evaluateFeature(const mapbox::feature::feature<double>& f,
     return T();
 }
 
+namespace {
+
+// The argument of a number assertion, which the parser adds around the
+// arguments of math operators that are not numbers
+const expression::Expression& withoutNumberAssertion(const expression::Expression& expression) {
+    const expression::Expression* argument = nullptr;
+    std::size_t arguments = 0;
+    if (expression.getKind() == expression::Kind::Assertion && expression.getOperator() == "number") {
+        expression.eachChild([&](const expression::Expression& child) {
+            argument = &child;
+            ++arguments;
+        });
+    }
+    return arguments == 1 ? *argument : expression;
+}
+
+// The key of a ["get", key] expression
+std::optional<std::string> getKey(const expression::Expression& expression) {
+    if (expression.getKind() != expression::Kind::CompoundExpression || expression.getOperator() != "get") {
+        return std::nullopt;
+    }
+    std::vector<const expression::Expression*> arguments;
+    expression.eachChild([&](const expression::Expression& child) { arguments.push_back(&child); });
+    if (arguments.size() != 1 || arguments[0]->getKind() != expression::Kind::Literal) {
+        return std::nullopt;
+    }
+    const auto value = static_cast<const expression::Literal*>(arguments[0])->getValue();
+    if (!value.is<std::string>()) {
+        return std::nullopt;
+    }
+    return value.get<std::string>();
+}
+
+// Cluster property whose map expression gets a point property or is a
+// number, and whose reduce expression adds, multiplies or takes the minimum
+// or maximum of the accumulated value and the one of the point, like sums,
+// counts and extremes do. It is computed without evaluating the expressions,
+// with the same results.
+class ClusterAccumulator {
+public:
+    static std::optional<ClusterAccumulator> create(const std::string& name,
+                                                    const GeoJSONOptions::ClusterExpression& expressions) {
+        ClusterAccumulator accumulator;
+        const auto& map = *expressions.first;
+        if (auto key = getKey(map)) {
+            accumulator.key = std::move(*key);
+        } else if (map.getKind() == expression::Kind::Literal &&
+                   static_cast<const expression::Literal&>(map).getValue().is<double>()) {
+            accumulator.constant = static_cast<const expression::Literal&>(map).getValue().get<double>();
+        } else {
+            return std::nullopt;
+        }
+
+        const auto& reduce = *expressions.second;
+        if (reduce.getKind() != expression::Kind::CompoundExpression) {
+            return std::nullopt;
+        }
+        const std::string op = reduce.getOperator();
+        if (op == "+") {
+            accumulator.op = Operator::Sum;
+        } else if (op == "*") {
+            accumulator.op = Operator::Product;
+        } else if (op == "min") {
+            accumulator.op = Operator::Min;
+        } else if (op == "max") {
+            accumulator.op = Operator::Max;
+        } else {
+            return std::nullopt;
+        }
+        std::vector<const expression::Expression*> arguments;
+        reduce.eachChild(
+            [&](const expression::Expression& child) { arguments.push_back(&withoutNumberAssertion(child)); });
+        if (arguments.size() != 2 || arguments[0]->getKind() != expression::Kind::CompoundExpression ||
+            arguments[0]->getOperator() != "accumulated" || getKey(*arguments[1]) != name) {
+            return std::nullopt;
+        }
+        return accumulator;
+    }
+
+    Value map(const PropertyMap& properties) const {
+        if (!key) {
+            return constant;
+        }
+        const auto it = properties.find(*key);
+        if (it == properties.end()) {
+            return NullValue();
+        }
+        if (auto number = numericValue<double>(it->second)) {
+            return *number;
+        }
+        // Same conversion as the evaluation of ["get", key]
+        return *expression::fromExpressionValue<Value>(expression::toExpressionValue(it->second));
+    }
+
+    // Same operations as the math expressions, which fail on values that are
+    // not numbers
+    Value reduce(const Value& accumulated, const Value& value) const {
+        const auto a = numericValue<double>(accumulated);
+        const auto b = numericValue<double>(value);
+        if (!a || !b) {
+            return NullValue();
+        }
+        switch (op) {
+            case Operator::Sum:
+                return 0.0 + *a + *b;
+            case Operator::Product:
+                return 1.0 * *a * *b;
+            case Operator::Min:
+                return std::fmin(*b, std::fmin(*a, std::numeric_limits<double>::infinity()));
+            case Operator::Max:
+                return std::fmax(*b, std::fmax(*a, -std::numeric_limits<double>::infinity()));
+        }
+        return NullValue();
+    }
+
+private:
+    enum class Operator : uint8_t {
+        Sum,
+        Product,
+        Min,
+        Max
+    };
+
+    std::optional<std::string> key;
+    double constant = 0;
+    Operator op = Operator::Sum;
+};
+
+struct ClusterProperty {
+    const std::string& name;
+    const GeoJSONOptions::ClusterExpression& expressions;
+    std::optional<ClusterAccumulator> accumulator;
+};
+
+mapbox::geojsonvt::Options getVTOptions(const GeoJSONOptions& options) {
+    constexpr double scale = util::EXTENT / util::tileSize_D;
+    mapbox::geojsonvt::Options vtOptions;
+    vtOptions.maxZoom = options.maxzoom;
+    vtOptions.extent = util::EXTENT;
+    vtOptions.buffer = static_cast<uint16_t>(::round(scale * options.buffer));
+    vtOptions.tolerance = scale * options.tolerance;
+    vtOptions.lineMetrics = options.lineMetrics;
+    return vtOptions;
+}
+
+// Bounding box of the feature in world coordinates, projected the way
+// geojson-vt does
+GeoJSONFeatureStore::Box getWorldBox(const GeoJSONFeature& feature) {
+    const auto box = mapbox::geometry::envelope(feature.geometry);
+    const auto project = [](double lng, double lat) {
+        const double sine = std::sin(lat * M_PI / 180);
+        const double y = 0.5 - 0.25 * std::log((1 + sine) / (1 - sine)) / M_PI;
+        return mapbox::geometry::point<double>{lng / 360 + 0.5, util::clamp(y, 0.0, 1.0)};
+    };
+    return {project(box.min.x, box.max.y), project(box.max.x, box.min.y)};
+}
+
+} // namespace
+
 // static
 std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON,
                                                  const Immutable<GeoJSONOptions>& options,
@@ -96,37 +314,204 @@ std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON,
         clusterOptions.maxZoom = options->clusterMaxZoom;
         clusterOptions.extent = util::EXTENT;
         clusterOptions.radius = static_cast<uint16_t>(::round(scale * options->clusterRadius));
+        auto properties = std::make_shared<std::vector<ClusterProperty>>();
+        for (const auto& p : options->clusterProperties) {
+            properties->push_back({p.first, p.second, ClusterAccumulator::create(p.first, p.second)});
+        }
+        // Other properties are evaluated on a feature holding the point properties
         auto feature = std::make_shared<Feature>();
-        clusterOptions.map = [feature, options](const PropertyMap& properties) -> PropertyMap {
+        clusterOptions.map = [feature, properties, options](const PropertyMap& pointProperties) -> PropertyMap {
             PropertyMap ret{};
-            if (properties.empty()) return ret;
-            for (const auto& p : options->clusterProperties) {
-                feature->properties = properties;
-                ret[p.first] = evaluateFeature<Value>(*feature, p.second.first);
+            if (pointProperties.empty()) return ret;
+            bool copied = false;
+            for (const auto& p : *properties) {
+                if (p.accumulator) {
+                    ret[p.name] = p.accumulator->map(pointProperties);
+                    continue;
+                }
+                if (!copied) {
+                    feature->properties = pointProperties;
+                    copied = true;
+                }
+                ret[p.name] = evaluateFeature<Value>(*feature, p.expressions.first);
             }
             return ret;
         };
-        clusterOptions.reduce = [feature, options](PropertyMap& toReturn, const PropertyMap& toFill) {
-            for (const auto& p : options->clusterProperties) {
-                if (toFill.count(p.first) == 0) {
+        clusterOptions.reduce = [feature, properties, options](PropertyMap& toReturn, const PropertyMap& toFill) {
+            bool copied = false;
+            for (const auto& p : *properties) {
+                const auto it = toFill.find(p.name);
+                if (it == toFill.end()) {
                     continue;
                 }
-                feature->properties = toFill;
-                std::optional<Value> accumulated(toReturn[p.first]);
-                toReturn[p.first] = evaluateFeature<Value>(*feature, p.second.second, accumulated);
+                auto& accumulated = toReturn[p.name];
+                if (p.accumulator) {
+                    accumulated = p.accumulator->reduce(accumulated, it->second);
+                    continue;
+                }
+                if (!copied) {
+                    feature->properties = toFill;
+                    copied = true;
+                }
+                accumulated = evaluateFeature<Value>(*feature, p.expressions.second, std::optional<Value>(accumulated));
             }
         };
-        return std::shared_ptr<GeoJSONData>(new SuperclusterData(geoJSON.get<Features>(), clusterOptions));
+        if (!scheduler) scheduler = Scheduler::GetSequenced();
+        return std::shared_ptr<GeoJSONData>(
+            new SuperclusterData(geoJSON.get<Features>(), clusterOptions, std::move(scheduler)));
     }
 
-    mapbox::geojsonvt::Options vtOptions;
-    vtOptions.maxZoom = options->maxzoom;
-    vtOptions.extent = util::EXTENT;
-    vtOptions.buffer = static_cast<uint16_t>(::round(scale * options->buffer));
-    vtOptions.tolerance = scale * options->tolerance;
-    vtOptions.lineMetrics = options->lineMetrics;
     if (!scheduler) scheduler = Scheduler::GetSequenced();
-    return std::shared_ptr<GeoJSONData>(new GeoJSONVTData(geoJSON, vtOptions, std::move(scheduler)));
+    return std::shared_ptr<GeoJSONData>(new GeoJSONVTData(geoJSON, getVTOptions(*options), std::move(scheduler)));
+}
+
+void GeoJSONFeatureStore::reset(GeoJSON geoJSON_) {
+    geoJSON = std::move(geoJSON_);
+    dropped = false;
+    positions.reset();
+    pending.clear();
+    changes.clear();
+    last.reset();
+}
+
+GeoJSONData::Features& GeoJSONFeatureStore::getFeatures() {
+    if (!geoJSON.is<GeoJSONData::Features>()) {
+        GeoJSONData::Features features;
+        if (geoJSON.is<GeoJSONFeature>()) {
+            features.push_back(std::move(geoJSON.get<GeoJSONFeature>()));
+        } else {
+            features.emplace_back(std::move(geoJSON.get<mapbox::geometry::geometry<double>>()));
+        }
+        geoJSON = std::move(features);
+    }
+    return geoJSON.get<GeoJSONData::Features>();
+}
+
+void GeoJSONFeatureStore::addChange(const GeoJSONFeature& feature) {
+    pending.push_back(getWorldBox(feature));
+}
+
+bool GeoJSONFeatureStore::update(GeoJSONData::Features add,
+                                 GeoJSONData::Features update,
+                                 const std::vector<FeatureIdentifier>& remove) {
+    // Features set from now on are kept
+    keep = true;
+    if (dropped) {
+        return false;
+    }
+
+    auto& features = getFeatures();
+    if (!positions) {
+        positions.emplace();
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            if (!features[i].id.is<NullValue>()) {
+                (*positions)[features[i].id] = i;
+            }
+        }
+    }
+
+    for (const auto& id : remove) {
+        auto it = positions->find(id);
+        if (it == positions->end()) {
+            continue;
+        }
+        const std::size_t position = it->second;
+        positions->erase(it);
+        addChange(features[position]);
+        if (position + 1 != features.size()) {
+            // The last feature takes the place of the removed one, which
+            // changes its drawing order
+            addChange(features.back());
+            features[position] = std::move(features.back());
+            auto moved = positions->find(features[position].id);
+            if (moved != positions->end() && moved->second == features.size() - 1) {
+                moved->second = position;
+            }
+        }
+        features.pop_back();
+    }
+
+    for (auto& feature : update) {
+        auto it = positions->find(feature.id);
+        if (it == positions->end()) {
+            continue;
+        }
+        addChange(features[it->second]);
+        addChange(feature);
+        features[it->second] = std::move(feature);
+    }
+
+    for (auto& feature : add) {
+        addChange(feature);
+        if (!feature.id.is<NullValue>()) {
+            auto result = positions->emplace(feature.id, features.size());
+            if (!result.second) {
+                addChange(features[result.first->second]);
+                features[result.first->second] = std::move(feature);
+                continue;
+            }
+        }
+        features.push_back(std::move(feature));
+    }
+    return true;
+}
+
+void GeoJSONFeatureStore::queue(Edit edit) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    queued.push_back(std::move(edit));
+}
+
+std::shared_ptr<GeoJSONData> GeoJSONFeatureStore::build(const Immutable<GeoJSONOptions>& options,
+                                                        std::shared_ptr<Scheduler> scheduler,
+                                                        const std::atomic<std::uint64_t>& latest,
+                                                        std::uint64_t request) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::deque<Edit> edits;
+    {
+        std::lock_guard<std::mutex> queueLock(queueMutex);
+        edits.swap(queued);
+    }
+    while (!edits.empty()) {
+        // Dropped once applied, releasing the data it holds
+        edits.front()(*this);
+        edits.pop_front();
+    }
+    // A newer build includes these changes
+    if (latest != request) return nullptr;
+
+    if (options->cluster) {
+        // Clusters around the changed points may move anywhere, so all the
+        // tiles are reloaded.
+        pending.clear();
+        changes.clear();
+        last.reset();
+        auto data = GeoJSONData::create(geoJSON, options, std::move(scheduler));
+        drop();
+        return data;
+    }
+
+    changes.push_back({last, std::move(pending)});
+    pending.clear();
+    if (changes.size() > maxChanges) {
+        changes.pop_front();
+    }
+
+    if (!scheduler) scheduler = Scheduler::GetSequenced();
+    auto data = std::shared_ptr<GeoJSONData>(
+        new GeoJSONVTData(geoJSON, getVTOptions(*options), std::move(scheduler), changes));
+    last = data;
+    drop();
+    return data;
+}
+
+void GeoJSONFeatureStore::drop() {
+    if (keep || dropped) {
+        return;
+    }
+    // Nothing is lost when there were no features
+    dropped = !geoJSON.is<GeoJSONData::Features>() || !geoJSON.get<GeoJSONData::Features>().empty();
+    geoJSON = GeoJSONData::Features{};
+    positions.reset();
 }
 
 GeoJSONSource::Impl::Impl(std::string id_, Immutable<GeoJSONOptions> options_)
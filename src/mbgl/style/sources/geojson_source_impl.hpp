@@ -4,6 +4,15 @@
 #include <mbgl/style/sources/geojson_source.hpp>
 #include <mbgl/util/range.hpp>
 
+#include <mapbox/geometry/box.hpp>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+
 namespace mbgl {
 
 class AsyncRequest;
@@ -28,5 +37,72 @@ private:
     std::shared_ptr<GeoJSONData> data;
 };
 
+// Features of a GeoJSONSource, kept so that updateFeatures() can change them
+// by ID. Changes are queued by the source and applied by the builds, which may
+// run on several threads of the thread pool at once. Until the first update,
+// features are dropped once indexed, so that sources which are never updated
+// do not hold them twice.
+class GeoJSONFeatureStore {
+public:
+    using Box = mapbox::geometry::box<double>;
+    using Edit = std::function<void(GeoJSONFeatureStore&)>;
+
+    struct Change {
+        // Data the change was made to
+        std::weak_ptr<GeoJSONData> data;
+        // Bounding boxes of the changed features, in world coordinates from 0 to 1
+        std::vector<Box> boxes;
+    };
+
+    // Number of changes the data remember, past which all tiles are reloaded
+    static constexpr std::size_t maxChanges = 16;
+
+    // Queues a change of the features. Changes apply in the order they were
+    // queued, whichever build applies them.
+    void queue(Edit);
+
+    // Applies the queued changes and indexes the features, unless `request`
+    // is no longer the `latest` one, in which case the newer build does it.
+    // Tiles away from the features changed since the previous builds report
+    // being unchanged.
+    std::shared_ptr<GeoJSONData> build(const Immutable<GeoJSONOptions>&,
+                                       std::shared_ptr<Scheduler>,
+                                       const std::atomic<std::uint64_t>& latest,
+                                       std::uint64_t request);
+
+    // Replaces all the features
+    void reset(GeoJSON);
+
+    // Returns false, leaving the features as they are, if they were indexed
+    // and dropped before the first update
+    bool update(GeoJSONData::Features add,
+                GeoJSONData::Features update,
+                const std::vector<FeatureIdentifier>& remove);
+
+private:
+    GeoJSONData::Features& getFeatures();
+    void addChange(const GeoJSONFeature&);
+    // Releases the indexed features, unless they are kept for updates
+    void drop();
+
+    GeoJSON geoJSON = GeoJSONData::Features{};
+    // Whether the features are kept once indexed, from the first update on
+    bool keep = false;
+    // Whether the features were dropped once indexed
+    bool dropped = false;
+    // Position of the features by ID, built on the first update
+    std::optional<std::map<FeatureIdentifier, std::size_t>> positions;
+    // Boxes of the features changed since the last build
+    std::vector<Box> pending;
+    // Changes between the last builds, the most recent last
+    std::deque<Change> changes;
+    std::weak_ptr<GeoJSONData> last;
+
+    // Guards the features, held by the build applying the changes
+    std::mutex mutex;
+    std::mutex queueMutex;
+    std::deque<Edit> queued;
+};
+
 } // namespace style
 } // namespace mbgl
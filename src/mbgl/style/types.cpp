@@ -12,7 +12,8 @@ MBGL_DEFINE_ENUM(SourceType,
                   {SourceType::Video, "video"},
                   {SourceType::Annotations, "annotations"},
                   {SourceType::Image, "image"},
-                  {SourceType::CustomVector, "customvector"}});
+                  {SourceType::CustomVector, "customvector"},
+                  {SourceType::FlatGeobuf, "flatgeobuf"}});
 
 MBGL_DEFINE_ENUM(VisibilityType,
                  {
@@ -32,6 +32,14 @@ inline float findViewportPadding(const TransformState& transformState, MapMode m
     return (transformState.getPitch() != 0.0f) ? viewportPaddingDefault * 2 : viewportPaddingDefault;
 }
 
+// Calls the collision group predicate directly rather than through a copy of the optional
+template <typename Geometry>
+bool hitTest(const CollisionIndex::CollisionGrid& grid,
+             const Geometry& geometry,
+             const std::optional<std::function<bool(const IndexedSubfeature&)>>& predicate) {
+    return predicate ? grid.hitTest(geometry, *predicate) : grid.hitTest(geometry);
+}
+
 } // namespace
 
 CollisionIndex::CollisionIndex(const TransformState& transformState_, MapMode mapMode)
@@ -168,7 +176,7 @@ std::pair<bool, bool> CollisionIndex::placeFeature(
         projectedBoxes.emplace_back(
             collisionBoundaries[0], collisionBoundaries[1], collisionBoundaries[2], collisionBoundaries[3]);
         if ((avoidEdges && !isInsideTile(collisionBoundaries, *avoidEdges)) || !isInsideGrid(collisionBoundaries) ||
-            (!allowOverlap && collisionGrid.hitTest(projectedBoxes.back().box(), collisionGroupPredicate))) {
+            (!allowOverlap && hitTest(collisionGrid, projectedBoxes.back().box(), collisionGroupPredicate))) {
             return {false, false};
         }
 
@@ -214,6 +222,9 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
     const float lineOffsetY = symbol.lineOffset[1] * fontSize;
 
     const auto labelPlaneAnchorPoint = project(tileUnitAnchorPoint, labelPlaneMatrix).first;
+    // Kept across labels so that its storage is only allocated once per placement thread
+    thread_local LineProjectionCache projectionCache;
+    projectionCache.reset(symbol.line, labelPlaneMatrix);
 
     const auto firstAndLastGlyph = placeFirstAndLastGlyph(fontScale,
                                                           lineOffsetX,
@@ -223,6 +234,7 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
                                                           tileUnitAnchorPoint,
                                                           symbol,
                                                           labelPlaneMatrix,
+                                                          projectionCache,
                                                           /*return tile distance*/ true);
 
     bool collisionDetected = false;
@@ -314,7 +326,7 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
         inGrid |= isInsideGrid(collisionBoundaries);
 
         if ((avoidEdges && !isInsideTile(collisionBoundaries, *avoidEdges)) ||
-            (!allowOverlap && collisionGrid.hitTest(projectedBoxes[i].circle(), collisionGroupPredicate))) {
+            (!allowOverlap && hitTest(collisionGrid, projectedBoxes[i].circle(), collisionGroupPredicate))) {
             if (!collisionDebug) {
                 return {false, false};
             } else {
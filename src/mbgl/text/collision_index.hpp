@@ -7,6 +7,8 @@
 #include <mbgl/map/transform_state.hpp>
 
 #include <array>
+#include <functional>
+#include <optional>
 
 namespace mbgl {
 
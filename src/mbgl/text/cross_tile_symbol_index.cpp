@@ -4,6 +4,8 @@
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/tile/tile.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 TileLayerIndex::TileLayerIndex(OverscaledTileID coord_,
@@ -15,9 +17,28 @@ TileLayerIndex::TileLayerIndex(OverscaledTileID coord_,
       bucketLeaderId(std::move(bucketLeaderId_)) {
     for (SymbolInstance& symbolInstance : symbolInstances) {
         if (symbolInstance.crossTileID == SymbolInstance::invalidCrossTileID()) continue;
-        indexedSymbolInstances[symbolInstance.key].emplace_back(symbolInstance.crossTileID,
-                                                                getScaledCoordinates(symbolInstance, coord));
+        auto& keys = indexedSymbolInstances[symbolInstance.keyHash];
+        auto it = std::find_if(keys.begin(), keys.end(), [&](const IndexedSymbolKey& indexed) {
+            return indexed.key == symbolInstance.key;
+        });
+        if (it == keys.end()) {
+            it = keys.insert(keys.end(), IndexedSymbolKey{symbolInstance.key, {}});
+        }
+        it->symbols.emplace_back(symbolInstance.crossTileID, getScaledCoordinates(symbolInstance, coord));
+    }
+}
+
+const std::vector<IndexedSymbolInstance>* TileLayerIndex::findSymbols(const SymbolInstance& symbolInstance) const {
+    auto it = indexedSymbolInstances.find(symbolInstance.keyHash);
+    if (it == indexedSymbolInstances.end()) {
+        return nullptr;
+    }
+    for (const IndexedSymbolKey& indexed : it->second) {
+        if (indexed.key == symbolInstance.key) {
+            return &indexed.symbols;
+        }
     }
+    return nullptr;
 }
 
 Point<int64_t> TileLayerIndex::getScaledCoordinates(SymbolInstance& symbolInstance,
@@ -33,7 +54,7 @@ Point<int64_t> TileLayerIndex::getScaledCoordinates(SymbolInstance& symbolInstan
 
 void TileLayerIndex::findMatches(SymbolBucket& bucket,
                                  const OverscaledTileID& newCoord,
-                                 std::set<uint32_t>& zoomCrossTileIDs) const {
+                                 std::unordered_set<uint32_t>& zoomCrossTileIDs) const {
     auto& symbolInstances = bucket.symbolInstances;
     float tolerance = coord.canonical.z < newCoord.canonical.z
                           ? 1.0f
@@ -47,15 +68,15 @@ void TileLayerIndex::findMatches(SymbolBucket& bucket,
             continue;
         }
 
-        auto it = indexedSymbolInstances.find(symbolInstance.key);
-        if (it == indexedSymbolInstances.end()) {
+        const auto* thisTileSymbols = findSymbols(symbolInstance);
+        if (!thisTileSymbols) {
             // No symbol with this key in this bucket
             continue;
         }
 
         auto scaledSymbolCoord = getScaledCoordinates(symbolInstance, newCoord);
 
-        for (const IndexedSymbolInstance& thisTileSymbol : it->second) {
+        for (const IndexedSymbolInstance& thisTileSymbol : *thisTileSymbols) {
             // Return any symbol with the same keys whose coordinates are within
             // 1 grid unit. (with a 4px grid, this covers a 12px by 12px area)
             if (std::abs(thisTileSymbol.coord.x - scaledSymbolCoord.x) <= tolerance &&
@@ -190,9 +211,11 @@ bool CrossTileSymbolLayerIndex::addBucket(const OverscaledTileID& tileID,
 }
 
 void CrossTileSymbolLayerIndex::removeBucketCrossTileIDs(uint8_t zoom, const TileLayerIndex& removedBucket) {
-    for (const auto& key : removedBucket.indexedSymbolInstances) {
-        for (auto indexedSymbolInstance : key.second) {
-            usedCrossTileIDs[zoom].erase(indexedSymbolInstance.crossTileID);
+    for (const auto& hash : removedBucket.indexedSymbolInstances) {
+        for (const IndexedSymbolKey& key : hash.second) {
+            for (const IndexedSymbolInstance& indexedSymbolInstance : key.symbols) {
+                usedCrossTileIDs[zoom].erase(indexedSymbolInstance.crossTileID);
+            }
         }
     }
 }
@@ -11,6 +11,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace mbgl {
@@ -29,6 +30,13 @@ public:
     Point<int64_t> coord;
 };
 
+// The indexed symbols sharing a key
+class IndexedSymbolKey {
+public:
+    std::u16string key;
+    std::vector<IndexedSymbolInstance> symbols;
+};
+
 class TileLayerIndex {
 public:
     TileLayerIndex(OverscaledTileID coord,
@@ -37,12 +45,17 @@ public:
                    std::string bucketLeaderId);
 
     Point<int64_t> getScaledCoordinates(SymbolInstance&, const OverscaledTileID&) const;
-    void findMatches(SymbolBucket&, const OverscaledTileID&, std::set<uint32_t>&) const;
+    void findMatches(SymbolBucket&, const OverscaledTileID&, std::unordered_set<uint32_t>&) const;
+    // Returns the indexed symbols with the same key as the given one, if any
+    const std::vector<IndexedSymbolInstance>* findSymbols(const SymbolInstance&) const;
 
     OverscaledTileID coord;
     uint32_t bucketInstanceId;
     std::string bucketLeaderId;
-    std::map<std::u16string, std::vector<IndexedSymbolInstance>> indexedSymbolInstances;
+    // Indexed symbols by the hash of their key. Keys with the same hash are
+    // kept apart, so a collision costs a string comparison but never matches
+    // unrelated symbols.
+    std::unordered_map<std::size_t, std::vector<IndexedSymbolKey>> indexedSymbolInstances;
 };
 
 class CrossTileSymbolLayerIndex {
@@ -55,8 +68,10 @@ public:
 private:
     void removeBucketCrossTileIDs(uint8_t zoom, const TileLayerIndex& removedBucket);
 
+    // Ordered by tile, so that the child tiles a bucket is matched against are
+    // visited in the same order every time
     std::map<uint8_t, std::map<OverscaledTileID, TileLayerIndex>> indexes;
-    std::map<uint8_t, std::set<uint32_t>> usedCrossTileIDs;
+    std::map<uint8_t, std::unordered_set<uint32_t>> usedCrossTileIDs;
     float lng = 0;
     uint32_t& maxCrossTileID;
 };
@@ -77,7 +92,7 @@ public:
     void reset();
 
 private:
-    std::map<std::string, CrossTileSymbolLayerIndex> layerIndexes;
+    std::unordered_map<std::string, CrossTileSymbolLayerIndex> layerIndexes;
     uint32_t maxCrossTileID = 0;
 };
 
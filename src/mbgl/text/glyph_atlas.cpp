@@ -1,7 +1,16 @@
 #include <mbgl/text/glyph_atlas.hpp>
 
+#if MLN_DRAWABLE_RENDERER
+#include <mbgl/gfx/context.hpp>
+#include <mbgl/gfx/texture2d.hpp>
+#include <mbgl/gfx/upload_pass.hpp>
+#endif
+
 #include <mapbox/shelf-pack.hpp>
 
+#include <algorithm>
+#include <cassert>
+
 namespace mbgl {
 
 static constexpr uint32_t padding = 1;
@@ -45,4 +54,207 @@ GlyphAtlas makeGlyphAtlas(const GlyphMap& glyphs) {
     return result;
 }
 
+namespace {
+
+constexpr uint32_t initialSharedAtlasSize = 256;
+
+bool sameGlyph(const Glyph& lhs, const Glyph& rhs) {
+    return lhs.metrics == rhs.metrics && lhs.bitmap.size == rhs.bitmap.size &&
+           std::equal(lhs.bitmap.data.get(), lhs.bitmap.data.get() + lhs.bitmap.bytes(), rhs.bitmap.data.get());
+}
+
+} // namespace
+
+SharedGlyphAtlas::Reference::Reference(std::weak_ptr<SharedGlyphAtlas> atlas_)
+    : atlas(std::move(atlas_)) {}
+
+SharedGlyphAtlas::Reference::~Reference() {
+    if (auto shared = atlas.lock()) {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        shared->release(positions);
+    }
+}
+
+SharedGlyphAtlas::SharedGlyphAtlas(Size maxSize_)
+    : maxSize(maxSize_),
+      pack(std::min(initialSharedAtlasSize, maxSize_.width), std::min(initialSharedAtlasSize, maxSize_.height)),
+      image({static_cast<uint32_t>(pack.width()), static_cast<uint32_t>(pack.height())}) {
+    image.fill(0);
+}
+
+SharedGlyphAtlas::~SharedGlyphAtlas() = default;
+
+std::unique_ptr<SharedGlyphAtlas::Reference> SharedGlyphAtlas::acquire(const GlyphMap& glyphs) {
+    std::unique_ptr<Reference> result(new Reference(weak_from_this()));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& glyphMapEntry : glyphs) {
+        const FontStackHash fontStack = glyphMapEntry.first;
+
+        for (const auto& entry : glyphMapEntry.second) {
+            if (!entry.second || !(*entry.second)->bitmap.valid()) {
+                continue;
+            }
+            const Immutable<Glyph>& glyph = *entry.second;
+            const Key key{fontStack, glyph->id};
+
+            Slot* slot = nullptr;
+            if (auto it = slots.find(key); it != slots.end()) {
+                slot = &it->second;
+                if (slot->glyph != glyph && !sameGlyph(*slot->glyph, *glyph)) {
+                    // The font stack was reloaded with different glyphs
+                    if (slot->refs > 0) {
+                        release(result->positions);
+                        result->positions.clear();
+                        return {};
+                    }
+                    evict(it);
+                    slot = nullptr;
+                }
+            }
+            if (!slot) {
+                slot = add(key, glyph);
+                if (!slot) {
+                    release(result->positions);
+                    result->positions.clear();
+                    return {};
+                }
+            }
+
+            if (slot->refs++ == 0 && slot->unusedEntry != unused.end()) {
+                unused.erase(slot->unusedEntry);
+                slot->unusedEntry = unused.end();
+            }
+            result->positions[fontStack].emplace(glyph->id, slot->position);
+        }
+    }
+
+    return result;
+}
+
+Size SharedGlyphAtlas::getSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return image.size;
+}
+
+std::size_t SharedGlyphAtlas::getGlyphCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return slots.size();
+}
+
+#if MLN_DRAWABLE_RENDERER
+const gfx::Texture2DPtr& SharedGlyphAtlas::upload(gfx::UploadPass& uploadPass) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!texture || texture->getSize() != image.size) {
+        texture = uploadPass.getContext().createTexture2D();
+        texture->setSamplerConfiguration(
+            {gfx::TextureFilterType::Linear, gfx::TextureWrapType::Clamp, gfx::TextureWrapType::Clamp});
+        texture->upload(image);
+    } else if (dirty) {
+        const Size patchSize{dirtyRight - dirtyLeft, dirtyBottom - dirtyTop};
+        AlphaImage patch(patchSize);
+        AlphaImage::copy(image, patch, {dirtyLeft, dirtyTop}, {0, 0}, patchSize);
+        texture->uploadSubRegion(patch, static_cast<uint16_t>(dirtyLeft), static_cast<uint16_t>(dirtyTop));
+    }
+    dirty = false;
+    return texture;
+}
+#endif
+
+SharedGlyphAtlas::Slot* SharedGlyphAtlas::add(const Key& key, const Immutable<Glyph>& glyph) {
+    const auto width = static_cast<int32_t>(glyph->bitmap.size.width + 2 * padding);
+    const auto height = static_cast<int32_t>(glyph->bitmap.size.height + 2 * padding);
+
+    mapbox::Bin* bin = pack.packOne(-1, width, height);
+    while (!bin) {
+        // Grow first, so that recently released glyphs can be reused by the
+        // next tiles, and only then evict the least recently used ones.
+        if (!grow()) {
+            if (unused.empty()) {
+                return nullptr;
+            }
+            evict(slots.find(unused.front()));
+        }
+        bin = pack.packOne(-1, width, height);
+    }
+
+    const auto x = static_cast<uint32_t>(bin->x);
+    const auto y = static_cast<uint32_t>(bin->y);
+    AlphaImage::clear(image, {x, y}, {static_cast<uint32_t>(width), static_cast<uint32_t>(height)});
+    AlphaImage::copy(glyph->bitmap, image, {0, 0}, {x + padding, y + padding}, glyph->bitmap.size);
+    markDirty(x, y, static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+
+    Slot slot{bin->id,
+              glyph,
+              GlyphPosition{Rect<uint16_t>{static_cast<uint16_t>(bin->x),
+                                           static_cast<uint16_t>(bin->y),
+                                           static_cast<uint16_t>(bin->w),
+                                           static_cast<uint16_t>(bin->h)},
+                            glyph->metrics},
+              0,
+              unused.end()};
+    return &slots.emplace(key, std::move(slot)).first->second;
+}
+
+void SharedGlyphAtlas::evict(std::map<Key, Slot>::iterator it) {
+    assert(it != slots.end() && it->second.refs == 0);
+    if (mapbox::Bin* bin = pack.getBin(it->second.bin)) {
+        pack.unref(*bin);
+    }
+    if (it->second.unusedEntry != unused.end()) {
+        unused.erase(it->second.unusedEntry);
+    }
+    slots.erase(it);
+}
+
+bool SharedGlyphAtlas::grow() {
+    const auto width = static_cast<uint32_t>(pack.width());
+    const auto height = static_cast<uint32_t>(pack.height());
+    if (width >= maxSize.width && height >= maxSize.height) {
+        return false;
+    }
+
+    // Alternate between doubling the height and the width, as shelf packing
+    // benefits from more shelves before wider ones.
+    Size newSize{width, height};
+    if (height <= width && height < maxSize.height) {
+        newSize.height = std::min(height * 2, maxSize.height);
+    } else {
+        newSize.width = std::min(width * 2, maxSize.width);
+    }
+    pack.resize(static_cast<int32_t>(newSize.width), static_cast<int32_t>(newSize.height));
+    image.resize(newSize);
+
+    // The texture is recreated from the whole image when its size changes
+    markDirty(0, 0, newSize.width, newSize.height);
+    return true;
+}
+
+void SharedGlyphAtlas::release(const GlyphPositions& positions) {
+    for (const auto& fontStackEntry : positions) {
+        for (const auto& glyphEntry : fontStackEntry.second) {
+            auto it = slots.find({fontStackEntry.first, glyphEntry.first});
+            assert(it != slots.end() && it->second.refs > 0);
+            if (it != slots.end() && --it->second.refs == 0) {
+                it->second.unusedEntry = unused.insert(unused.end(), it->first);
+            }
+        }
+    }
+}
+
+void SharedGlyphAtlas::markDirty(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    if (!dirty) {
+        dirty = true;
+        dirtyLeft = x;
+        dirtyTop = y;
+        dirtyRight = x + width;
+        dirtyBottom = y + height;
+    } else {
+        dirtyLeft = std::min(dirtyLeft, x);
+        dirtyTop = std::min(dirtyTop, y);
+        dirtyRight = std::max(dirtyRight, x + width);
+        dirtyBottom = std::max(dirtyBottom, y + height);
+    }
+}
+
 } // namespace mbgl
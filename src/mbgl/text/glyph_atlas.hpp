@@ -4,8 +4,20 @@
 
 #include <mapbox/shelf-pack.hpp>
 
+#include <list>
+#include <memory>
+#include <mutex>
+
 namespace mbgl {
 
+#if MLN_DRAWABLE_RENDERER
+namespace gfx {
+class Texture2D;
+class UploadPass;
+using Texture2DPtr = std::shared_ptr<Texture2D>;
+} // namespace gfx
+#endif
+
 struct GlyphPosition {
     Rect<uint16_t> rect;
     GlyphMetrics metrics;
@@ -22,4 +34,85 @@ public:
 
 GlyphAtlas makeGlyphAtlas(const GlyphMap&);
 
+/// A glyph atlas shared by all the tiles of a renderer.
+///
+/// Each glyph is packed once and reference counted by the tiles using it.
+/// Glyphs which are no longer referenced stay in the atlas until their space
+/// is needed, and only the modified region is uploaded to the texture.
+/// Tiles are laid out on worker threads, so all methods are thread-safe.
+class SharedGlyphAtlas : public std::enable_shared_from_this<SharedGlyphAtlas> {
+public:
+    /// Keeps the glyphs acquired by a tile resident in the atlas
+    class Reference {
+    public:
+        Reference(const Reference&) = delete;
+        Reference& operator=(const Reference&) = delete;
+        ~Reference();
+
+        const GlyphPositions& getPositions() const { return positions; }
+        std::shared_ptr<SharedGlyphAtlas> getAtlas() const { return atlas.lock(); }
+
+    private:
+        friend class SharedGlyphAtlas;
+        Reference(std::weak_ptr<SharedGlyphAtlas>);
+
+        std::weak_ptr<SharedGlyphAtlas> atlas;
+        GlyphPositions positions;
+    };
+
+    explicit SharedGlyphAtlas(Size maxSize = {2048, 2048});
+    ~SharedGlyphAtlas();
+
+    /// Add the glyphs to the atlas, or reference them if they are already
+    /// present. Returns nothing if they don't fit, in which case the caller
+    /// should fall back to a per-tile atlas.
+    std::unique_ptr<Reference> acquire(const GlyphMap&);
+
+    Size getSize() const;
+
+    /// Number of glyphs in the atlas, including unreferenced ones
+    std::size_t getGlyphCount() const;
+
+#if MLN_DRAWABLE_RENDERER
+    /// Upload any changes to the atlas texture and return it.
+    /// Must be called on the render thread.
+    const gfx::Texture2DPtr& upload(gfx::UploadPass&);
+#endif
+
+private:
+    using Key = std::pair<FontStackHash, GlyphID>;
+
+    struct Slot {
+        int32_t bin;
+        Immutable<Glyph> glyph;
+        GlyphPosition position;
+        uint32_t refs = 0;
+        // Position in `unused` while the glyph isn't referenced
+        std::list<Key>::iterator unusedEntry;
+    };
+
+    Slot* add(const Key&, const Immutable<Glyph>&);
+    void evict(std::map<Key, Slot>::iterator);
+    bool grow();
+    void release(const GlyphPositions&);
+    void markDirty(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+    const Size maxSize;
+
+    mutable std::mutex mutex;
+    mapbox::ShelfPack pack;
+    AlphaImage image;
+    std::map<Key, Slot> slots;
+    // Unreferenced glyphs, least recently released first
+    std::list<Key> unused;
+
+    // Region of `image` changed since the last upload
+    bool dirty = false;
+    uint32_t dirtyLeft = 0, dirtyTop = 0, dirtyRight = 0, dirtyBottom = 0;
+
+#if MLN_DRAWABLE_RENDERER
+    gfx::Texture2DPtr texture;
+#endif
+};
+
 } // namespace mbgl
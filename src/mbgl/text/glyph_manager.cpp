@@ -1,3 +1,4 @@
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
@@ -5,16 +6,132 @@
 #include <mbgl/text/glyph_manager_observer.hpp>
 #include <mbgl/text/glyph_pbf.hpp>
 #include <mbgl/util/async_request.hpp>
+#include <mbgl/util/hash.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/tiny_sdf.hpp>
 
+#include <list>
+#include <mutex>
+#include <string_view>
+
 namespace mbgl {
 
 static GlyphManagerObserver nullObserver;
 
+class ParsedGlyphRange {
+public:
+    std::shared_ptr<const std::string> data;
+    std::vector<Immutable<Glyph>> glyphs;
+};
+
+namespace {
+
+// Glyph ranges decoded by any GlyphManager in the process, keyed by URL, so
+// that renderers using the same fonts only parse them once. Ranges are only
+// kept while at least one GlyphManager uses them.
+class ParsedGlyphRangeCache {
+public:
+    static ParsedGlyphRangeCache& get() {
+        static ParsedGlyphRangeCache instance;
+        return instance;
+    }
+
+    std::shared_ptr<const ParsedGlyphRange> find(const std::string& url, const std::string& data) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = ranges.find(url);
+        if (it == ranges.end()) {
+            return {};
+        }
+        auto range = it->second.lock();
+        if (!range) {
+            ranges.erase(it);
+            return {};
+        }
+        // The same URL may have been updated since it was parsed
+        return (range->data.get() == &data || *range->data == data) ? range : nullptr;
+    }
+
+    void insert(const std::string& url, std::shared_ptr<const ParsedGlyphRange> range) {
+        std::lock_guard<std::mutex> lock(mutex);
+        util::erase_if(ranges, [](const auto& entry) { return entry.second.expired(); });
+        ranges[url] = std::move(range);
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<std::string, std::weak_ptr<const ParsedGlyphRange>> ranges;
+};
+
+// SDFs of locally rasterized glyphs, shared by all GlyphManagers in the
+// process. They are keyed by the rasterized glyph rather than by the font, so
+// that any rasterizer rendering the same bitmap reuses its SDF, which is the
+// expensive part. The least recently used glyphs are dropped past the capacity.
+class LocalGlyphSDFCache {
+public:
+    static constexpr std::size_t capacity = 2048;
+
+    static LocalGlyphSDFCache& get() {
+        static LocalGlyphSDFCache instance;
+        return instance;
+    }
+
+    std::optional<Immutable<Glyph>> find(const Glyph& raster) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto range = index.equal_range(hash(raster));
+        for (auto it = range.first; it != range.second; ++it) {
+            const Glyph& key = it->second->raster;
+            if (key.id == raster.id && key.metrics == raster.metrics && key.bitmap.size == raster.bitmap.size &&
+                key.bitmap == raster.bitmap) {
+                order.splice(order.begin(), order, it->second);
+                return it->second->sdf;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void insert(Glyph raster, Immutable<Glyph> sdf) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const std::size_t key = hash(raster);
+        order.push_front({key, std::move(raster), std::move(sdf)});
+        index.emplace(key, order.begin());
+        if (order.size() > capacity) {
+            const auto range = index.equal_range(order.back().hash);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == std::prev(order.end())) {
+                    index.erase(it);
+                    break;
+                }
+            }
+            order.pop_back();
+        }
+    }
+
+private:
+    struct Entry {
+        std::size_t hash;
+        Glyph raster;
+        Immutable<Glyph> sdf;
+    };
+
+    static std::size_t hash(const Glyph& raster) {
+        const std::string_view pixels(reinterpret_cast<const char*>(raster.bitmap.data.get()), raster.bitmap.bytes());
+        return util::hash(raster.id, raster.metrics.width, raster.metrics.height, pixels);
+    }
+
+    std::mutex mutex;
+    // Most recently used first
+    std::list<Entry> order;
+    std::unordered_multimap<std::size_t, std::list<Entry>::iterator> index;
+};
+
+} // namespace
+
 GlyphManager::GlyphManager(std::unique_ptr<LocalGlyphRasterizer> localGlyphRasterizer_)
     : observer(&nullObserver),
-      localGlyphRasterizer(std::move(localGlyphRasterizer_)) {}
+      localGlyphRasterizer(std::move(localGlyphRasterizer_)),
+      threadPool(Scheduler::GetBackground()),
+      localGlyphScheduler(Scheduler::GetSequenced()),
+      tinySDF(std::make_shared<util::TinySDF>()) {}
 
 GlyphManager::~GlyphManager() = default;
 
@@ -26,6 +143,7 @@ void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphD
     // shared pointer containing the dependencies. When the shared pointer
     // becomes unique, we know that all the dependencies for that requestor have
     // been fetched, and can notify it of completion.
+    GlyphDependencies localGlyphs;
     for (const auto& dependency : *dependencies) {
         const FontStack& fontStack = dependency.first;
         Entry& entry = entries[fontStack];
@@ -35,7 +153,7 @@ void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphD
         for (const auto& glyphID : glyphIDs) {
             if (localGlyphRasterizer->canRasterizeGlyph(fontStack, glyphID)) {
                 if (entry.glyphs.find(glyphID) == entry.glyphs.end()) {
-                    entry.glyphs.emplace(glyphID, makeMutable<Glyph>(generateLocalSDF(fontStack, glyphID)));
+                    localGlyphs[fontStack].insert(glyphID);
                 }
             } else {
                 ranges.insert(getGlyphRange(glyphID));
@@ -52,6 +170,12 @@ void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphD
         }
     }
 
+    if (!localGlyphs.empty()) {
+        const auto id = nextLocalGlyphRequest++;
+        localGlyphRequests.emplace(id, LocalGlyphRequest{&requestor, dependencies});
+        generateLocalGlyphs(id, std::move(localGlyphs));
+    }
+
     // If the shared dependencies pointer is already unique, then all dependent
     // glyph ranges have already been loaded. Send a notification immediately.
     if (dependencies.unique()) {
@@ -59,10 +183,64 @@ void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphD
     }
 }
 
-Glyph GlyphManager::generateLocalSDF(const FontStack& fontStack, GlyphID glyphID) {
-    Glyph local = localGlyphRasterizer->rasterizeGlyph(fontStack, glyphID);
-    local.bitmap = util::transformRasterToSDF(local.bitmap, 8, .25);
-    return local;
+void GlyphManager::generateLocalGlyphs(uint64_t id, GlyphDependencies glyphIDs) {
+    using LocalGlyphs = std::vector<std::pair<FontStack, std::vector<Immutable<Glyph>>>>;
+
+    // Rasterizing and computing the SDF of each glyph is too slow for the
+    // render thread when a tile needs hundreds of ideographs
+    auto generateClosure = [rasterizer = localGlyphRasterizer, sdf = tinySDF, glyphIDs = std::move(glyphIDs)]() {
+        LocalGlyphs result;
+        for (const auto& [fontStack, ids] : glyphIDs) {
+            auto& glyphs = result.emplace_back(fontStack, std::vector<Immutable<Glyph>>()).second;
+            glyphs.reserve(ids.size());
+            for (const auto glyphID : ids) {
+                Glyph raster = rasterizer->rasterizeGlyph(fontStack, glyphID);
+                auto& cache = LocalGlyphSDFCache::get();
+                if (auto cached = cache.find(raster)) {
+                    glyphs.push_back(std::move(*cached));
+                    continue;
+                }
+
+                auto local = makeMutable<Glyph>();
+                local->id = raster.id;
+                local->metrics = raster.metrics;
+                local->bitmap = sdf->transform(raster.bitmap, 8, .25);
+                Immutable<Glyph> glyph = std::move(local);
+                cache.insert(std::move(raster), glyph);
+                glyphs.push_back(std::move(glyph));
+            }
+        }
+        return result;
+    };
+
+    auto resultClosure = [this, weak = weakFactory.makeWeakPtr(), id](LocalGlyphs result) {
+        if (!weak) return; // This instance has been deleted.
+
+        for (auto& [fontStack, glyphs] : result) {
+            auto entryIt = entries.find(fontStack);
+            if (entryIt == entries.end()) {
+                // The font stack was evicted while the glyphs were generated
+                continue;
+            }
+            for (auto& glyph : glyphs) {
+                const auto glyphID = glyph->id;
+                entryIt->second.glyphs.emplace(glyphID, std::move(glyph));
+            }
+        }
+
+        auto requestIt = localGlyphRequests.find(id);
+        if (requestIt == localGlyphRequests.end()) {
+            // The requestor was removed
+            return;
+        }
+        const LocalGlyphRequest request = std::move(requestIt->second);
+        localGlyphRequests.erase(requestIt);
+        if (request.dependencies.unique()) {
+            notify(*request.requestor, *request.dependencies);
+        }
+    };
+
+    localGlyphScheduler->scheduleAndReplyValue(generateClosure, resultClosure);
 }
 
 void GlyphManager::requestRange(GlyphRequest& request,
@@ -88,26 +266,71 @@ void GlyphManager::processResponse(const Response& res, const FontStack& fontSta
         return;
     }
 
-    Entry& entry = entries[fontStack];
-    GlyphRequest& request = entry.ranges[range];
+    if (res.noContent) {
+        onRangeParsed(fontStack, range, nullptr);
+        return;
+    }
+
+    // Decoding a range of SDF glyphs is expensive, so do it on the thread pool
+    struct ParseResult {
+        std::shared_ptr<const ParsedGlyphRange> range;
+        std::exception_ptr error;
+    };
 
-    if (!res.noContent) {
-        std::vector<Glyph> glyphs;
+    auto parseClosure = [url = Resource::glyphs(glyphURL, fontStack, range).url,
+                         data = res.data,
+                         range]() -> ParseResult {
+        auto& cache = ParsedGlyphRangeCache::get();
+        if (auto cached = cache.find(url, *data)) {
+            return {std::move(cached), nullptr};
+        }
 
         try {
-            glyphs = parseGlyphPBF(range, *res.data);
+            auto parsed = std::make_shared<ParsedGlyphRange>();
+            parsed->data = data;
+            for (auto& glyph : parseGlyphPBF(range, *data)) {
+                parsed->glyphs.emplace_back(makeMutable<Glyph>(std::move(glyph)));
+            }
+            cache.insert(url, parsed);
+            return {std::move(parsed), nullptr};
         } catch (...) {
-            observer->onGlyphsError(fontStack, range, std::current_exception());
+            return {nullptr, std::current_exception()};
+        }
+    };
+
+    auto resultClosure = [this, weak = weakFactory.makeWeakPtr(), fontStack, range](ParseResult result) {
+        if (!weak) return; // This instance has been deleted.
+
+        if (result.error) {
+            observer->onGlyphsError(fontStack, range, result.error);
             return;
         }
+        onRangeParsed(fontStack, range, std::move(result.range));
+    };
+
+    threadPool->scheduleAndReplyValue(parseClosure, resultClosure);
+}
+
+void GlyphManager::onRangeParsed(const FontStack& fontStack,
+                                 const GlyphRange& range,
+                                 std::shared_ptr<const ParsedGlyphRange> parsed) {
+    auto entryIt = entries.find(fontStack);
+    if (entryIt == entries.end()) {
+        // The font stack was evicted while the range was being parsed
+        return;
+    }
+    Entry& entry = entryIt->second;
+    GlyphRequest& request = entry.ranges[range];
 
-        for (auto& glyph : glyphs) {
-            auto id = glyph.id;
+    if (parsed) {
+        for (const auto& glyph : parsed->glyphs) {
+            auto id = glyph->id;
             if (!localGlyphRasterizer->canRasterizeGlyph(fontStack, id)) {
                 entry.glyphs.erase(id);
-                entry.glyphs.emplace(id, makeMutable<Glyph>(std::move(glyph)));
+                entry.glyphs.emplace(id, glyph);
             }
         }
+        request.glyphs = std::move(parsed);
     }
 
     request.parsed = true;
@@ -158,6 +381,7 @@ void GlyphManager::removeRequestor(GlyphRequestor& requestor) {
             range.second.requestors.erase(&requestor);
         }
     }
+    util::erase_if(localGlyphRequests, [&](const auto& request) { return request.second.requestor == &requestor; });
 }
 
 void GlyphManager::evict(const std::set<FontStack>& keep) {
@@ -1,12 +1,15 @@
 #pragma once
 
 #include <mbgl/text/glyph.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/text/glyph_manager_observer.hpp>
 #include <mbgl/text/glyph_range.hpp>
 #include <mbgl/text/local_glyph_rasterizer.hpp>
 #include <mbgl/util/font_stack.hpp>
 #include <mbgl/util/immutable.hpp>
+#include <mapbox/std/weak.hpp>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -15,6 +18,12 @@ namespace mbgl {
 class FileSource;
 class AsyncRequest;
 class Response;
+class Scheduler;
+class ParsedGlyphRange;
+
+namespace util {
+class TinySDF;
+} // namespace util
 
 class GlyphRequestor {
 public:
@@ -47,14 +56,18 @@ public:
     // Remove glyphs for all but the supplied font stacks.
     void evict(const std::set<FontStack>&);
 
+    // Atlas shared by the tiles laid out with glyphs from this manager.
+    const std::shared_ptr<SharedGlyphAtlas>& getSharedAtlas() const { return sharedAtlas; }
+
 private:
-    Glyph generateLocalSDF(const FontStack& fontStack, GlyphID glyphID);
     std::string glyphURL;
 
     struct GlyphRequest {
         bool parsed = false;
         std::unique_ptr<AsyncRequest> req;
         std::unordered_map<GlyphRequestor*, std::shared_ptr<GlyphDependencies>> requestors;
+        // Keeps the decoded range in the process-wide cache while in use
+        std::shared_ptr<const ParsedGlyphRange> glyphs;
     };
 
     struct Entry {
@@ -64,13 +77,34 @@ private:
 
     std::unordered_map<FontStack, Entry, FontStackHasher> entries;
 
+    // Requestors waiting on locally generated glyphs
+    struct LocalGlyphRequest {
+        GlyphRequestor* requestor;
+        std::shared_ptr<GlyphDependencies> dependencies;
+    };
+
+    std::unordered_map<uint64_t, LocalGlyphRequest> localGlyphRequests;
+    uint64_t nextLocalGlyphRequest = 0;
+
     void requestRange(GlyphRequest&, const FontStack&, const GlyphRange&, FileSource& fileSource);
     void processResponse(const Response&, const FontStack&, const GlyphRange&);
+    void onRangeParsed(const FontStack&, const GlyphRange&, std::shared_ptr<const ParsedGlyphRange>);
     void notify(GlyphRequestor&, const GlyphDependencies&);
+    void generateLocalGlyphs(uint64_t id, GlyphDependencies);
 
     GlyphManagerObserver* observer = nullptr;
 
-    std::unique_ptr<LocalGlyphRasterizer> localGlyphRasterizer;
+    // Shared with the background thread rasterizing local glyphs
+    std::shared_ptr<LocalGlyphRasterizer> localGlyphRasterizer;
+
+    std::shared_ptr<SharedGlyphAtlas> sharedAtlas = std::make_shared<SharedGlyphAtlas>();
+
+    std::shared_ptr<Scheduler> threadPool;
+    // Calls into the rasterizer one at a time
+    std::shared_ptr<Scheduler> localGlyphScheduler;
+    // Only used on the local glyph scheduler, reusing its buffers between glyphs
+    std::shared_ptr<util::TinySDF> tinySDF;
+    mapbox::base::WeakPtrFactory<GlyphManager> weakFactory{this};
 };
 
 } // namespace mbgl
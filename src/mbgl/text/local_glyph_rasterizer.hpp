@@ -27,7 +27,13 @@ namespace mbgl {
     It is left to platform-specific implementation to decide how best to
     map a FontStack to a particular rasterization.
 
-    The default implementation simply refuses to rasterize any glyphs.
+    GlyphManager calls canRasterizeGlyph on its own thread, and rasterizeGlyph
+    on a background thread, one glyph at a time. Implementations must allow
+    the two to run concurrently.
+
+    The default implementation simply refuses to rasterize any glyphs. On
+    Linux, glyphs are rendered with FreeType from the font that Fontconfig
+    matches to the font family.
 */
 
 class LocalGlyphRasterizer {
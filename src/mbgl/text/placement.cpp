@@ -8,6 +8,8 @@
 #include <mbgl/text/placement.hpp>
 #include <mbgl/tile/geometry_tile.hpp>
 #include <mbgl/util/math.hpp>
+
+#include <algorithm>
 #include <utility>
 
 namespace mbgl {
@@ -74,6 +76,7 @@ public:
                      const TransformState& state_,
                      float placementZoom,
                      CollisionGroups::CollisionGroup collisionGroup_,
+                     bool justReloaded_,
                      std::optional<CollisionBoundaries> avoidEdges_ = std::nullopt)
         : bucket(bucket_),
           renderTile(renderTile_),
@@ -84,6 +87,7 @@ public:
           collisionGroup(std::move(collisionGroup_)),
           partiallyEvaluatedTextSize(bucket_.textSizeBinder->evaluateForZoom(placementZoom)),
           partiallyEvaluatedIconSize(bucket_.iconSizeBinder->evaluateForZoom(placementZoom)),
+          justReloaded(justReloaded_),
           avoidEdges(std::move(avoidEdges_)) {}
 
     const SymbolBucket& getBucket() const { return bucket.get(); }
@@ -145,6 +149,9 @@ public:
 
     bool hasIconTextFit = getLayout().get<IconTextFit>() != IconTextFitType::None;
 
+    // Whether the bucket is placed for the first time since it was loaded
+    bool justReloaded;
+
     std::optional<CollisionBoundaries> avoidEdges;
 };
 
@@ -155,6 +162,7 @@ PlacementController::PlacementController()
 
 void PlacementController::setPlacement(Immutable<Placement> placement_) {
     placement = std::move(placement_);
+    placement->markBucketsPlaced();
     stale = false;
 }
 
@@ -207,6 +215,79 @@ void Placement::placeLayers(const RenderLayerReferences& layers) {
     commit();
 }
 
+bool Placement::placeLayers(const RenderLayerReferences& layers, Duration budget, TimePoint now) {
+    const auto deadline = Clock::now() + budget;
+    bool placedAny = false;
+    if (!reloadedBucketIds.empty()) {
+        // Pick up the reloaded buckets placed by the previous calls that are still there
+        for (const RenderLayer& layer : layers) {
+            for (const BucketPlacementData& data : layer.getPlacementData()) {
+                const auto& bucket = static_cast<const SymbolBucket&>(data.bucket.get());
+                if (reloadedBucketIds.erase(bucket.bucketInstanceId) != 0u) {
+                    reloadedBuckets.emplace_back(bucket);
+                }
+            }
+        }
+        reloadedBucketIds.clear();
+    }
+    for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
+        const RenderLayer& layer = *it;
+        if (placedLayers.count(layer.getID())) continue;
+        if (currentLayer.layerID != layer.getID()) {
+            currentLayer = {layer.getID(), {}, {}};
+        }
+
+        for (const BucketPlacementData& data : layer.getPlacementData()) {
+            std::pair<UnwrappedTileID, std::size_t> key{data.tile.get().id,
+                                                        data.sortKeyRange ? data.sortKeyRange->start : 0u};
+            if (currentLayer.placedBuckets.count(key)) continue;
+            if (placedAny && Clock::now() >= deadline) {
+                // The buckets may be gone by the next call
+                for (const SymbolBucket& reloaded : reloadedBuckets) {
+                    reloadedBucketIds.insert(reloaded.bucketInstanceId);
+                }
+                reloadedBuckets.clear();
+                return false;
+            }
+            Bucket& bucket = data.bucket;
+            bucket.place(*this, data, currentLayer.seenCrossTileIDs);
+            currentLayer.placedBuckets.insert(std::move(key));
+            placedAny = true;
+        }
+
+        placedLayers.insert(layer.getID());
+        currentLayer = {};
+    }
+
+    placedLayers.clear();
+    commitTime = now;
+    commit();
+    return true;
+}
+
+void Placement::snapshotBucketState(const RenderLayerReferences& layers) {
+    reloadedSnapshot.emplace();
+    for (const RenderLayer& layer : layers) {
+        for (const BucketPlacementData& data : layer.getPlacementData()) {
+            const auto& bucket = static_cast<const SymbolBucket&>(data.bucket.get());
+            if (bucket.justReloaded) {
+                reloadedSnapshot->insert(&bucket);
+            }
+        }
+    }
+}
+
+bool Placement::isJustReloaded(const SymbolBucket& bucket) const {
+    return reloadedSnapshot ? reloadedSnapshot->count(&bucket) != 0u : bucket.justReloaded;
+}
+
+void Placement::markBucketsPlaced() const {
+    for (const SymbolBucket& bucket : reloadedBuckets) {
+        bucket.justReloaded = false;
+    }
+    reloadedBuckets.clear();
+}
+
 void Placement::placeLayer(const RenderLayer& layer, std::set<uint32_t>& seenCrossTileIDs) {
     for (const BucketPlacementData& data : layer.getPlacementData()) {
         Bucket& bucket = data.bucket;
@@ -244,7 +325,13 @@ void Placement::placeSymbolBucket(const BucketPlacementData& params, std::set<ui
                          collisionIndex.getTransformState(),
                          placementZoom,
                          collisionGroups.get(params.sourceId),
+                         isJustReloaded(symbolBucket),
                          getAvoidEdges(symbolBucket, renderTile.matrix)};
+    // A bucket can be placed more than once, e.g. for each of its sort key ranges
+    ctx.justReloaded = ctx.justReloaded &&
+                       std::none_of(reloadedBuckets.begin(), reloadedBuckets.end(), [&](const SymbolBucket& bucket) {
+                           return &bucket == &symbolBucket;
+                       });
     for (const SymbolInstance& symbol : getSortedSymbols(params, ctx.pixelRatio)) {
         if (seenCrossTileIDs.count(symbol.crossTileID) != 0u) continue;
         placeSymbol(symbol, ctx);
@@ -256,7 +343,9 @@ void Placement::placeSymbolBucket(const BucketPlacementData& params, std::set<ui
     }
 
     // Prevent a flickering issue when a symbol is moved.
-    symbolBucket.justReloaded = false;
+    if (ctx.justReloaded) {
+        reloadedBuckets.emplace_back(symbolBucket);
+    }
 
     // As long as this placement lives, we have to hold onto this bucket's
     // matching FeatureIndex/data for querying purposes
@@ -622,7 +711,7 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
     }
 
     JointPlacement result(
-        placeText || ctx.alwaysShowText, placeIcon || ctx.alwaysShowIcon, offscreen || bucket.justReloaded);
+        placeText || ctx.alwaysShowText, placeIcon || ctx.alwaysShowIcon, offscreen || ctx.justReloaded);
     placements.emplace(symbolInstance.crossTileID, result);
     newSymbolPlaced(symbolInstance, ctx, result, ctx.placementType, textBoxes, iconBoxes);
     return result;
@@ -1404,7 +1493,7 @@ void TilePlacement::placeLayers(const RenderLayerReferences& layers) {
             return a.symbol.get().anchor.point.x < b.symbol.get().anchor.point.x;
         }
         // Finally, looking at the key hashes.
-        return std::hash<std::u16string>()(a.symbol.get().key) < std::hash<std::u16string>()(b.symbol.get().key);
+        return a.symbol.get().keyHash < b.symbol.get().keyHash;
     });
     // Place intersections.
     for (const auto& intersection : intersections) {
@@ -1452,6 +1541,7 @@ void TilePlacement::placeSymbolBucket(const BucketPlacementData& params, std::se
                          collisionIndex.getTransformState(),
                          placementZoom,
                          collisionGroups.get(params.sourceId),
+                         isJustReloaded(bucket),
                          getAvoidEdges(bucket, renderTile.matrix)};
 
     const auto& variableTextAnchors = ctx.getVariableTextAnchors();
@@ -4,7 +4,9 @@
 #include <mbgl/renderer/renderer.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/text/collision_index.hpp>
+#include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/chrono.hpp>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -122,6 +124,24 @@ public:
 
     virtual ~Placement();
     virtual void placeLayers(const RenderLayerReferences&);
+    /**
+     * @brief places the given layers, stopping once `budget` is spent.
+     *
+     * Returns `true` and commits the placement once every layer has been placed.
+     * Otherwise returns `false` and the next call resumes with the first bucket
+     * not yet placed, keeping the collision index and the current layer's seen
+     * cross-tile IDs. At least one bucket is placed per call. `now` is the time
+     * of the frame the call is made for and becomes the commit time.
+     */
+    bool placeLayers(const RenderLayerReferences&, Duration budget, TimePoint now);
+    // Copies the state of the given layers' buckets that the render thread
+    // changes while drawing frames, so the layers can be placed on another
+    // thread while frames keep being drawn from the same buckets.
+    void snapshotBucketState(const RenderLayerReferences&);
+    // Clears the "just reloaded" state of the placed buckets. Placement may run
+    // on a background thread, so this is deferred until the render thread
+    // starts using the placement.
+    void markBucketsPlaced() const;
     void updateLayerBuckets(const RenderLayer&, const TransformState&, bool updateOpacities) const;
     virtual float symbolFadeChange(TimePoint now) const;
     virtual bool hasTransitions(TimePoint now) const;
@@ -180,6 +200,7 @@ protected:
     void markUsedOrientation(SymbolBucket&, style::TextWritingModeType, const SymbolInstance&) const;
     const Placement* getPrevPlacement() const { return prevPlacement ? prevPlacement->get() : nullptr; }
     bool isTiltedView() const;
+    bool isJustReloaded(const SymbolBucket&) const;
 
     std::shared_ptr<const UpdateParameters> updateParameters;
     CollisionIndex collisionIndex;
@@ -200,6 +221,21 @@ protected:
     CollisionGroups collisionGroups;
     mutable std::optional<Immutable<Placement>> prevPlacement;
     bool showCollisionBoxes = false;
+    mutable std::vector<std::reference_wrapper<const SymbolBucket>> reloadedBuckets;
+    // The buckets that were just reloaded when the bucket state was snapshotted
+    std::optional<std::unordered_set<const SymbolBucket*>> reloadedSnapshot;
+
+    // Progress of a placement spread over several placeLayers() calls
+    struct LayerProgress {
+        std::string layerID;
+        std::set<uint32_t> seenCrossTileIDs;
+        // Buckets already placed, by tile and the start of their sort key range
+        std::set<std::pair<UnwrappedTileID, std::size_t>> placedBuckets;
+    };
+    std::unordered_set<std::string> placedLayers;
+    LayerProgress currentLayer;
+    // Instance IDs of the just reloaded buckets placed by previous calls
+    std::unordered_set<uint32_t> reloadedBucketIds;
 
     // Cache being used by placeSymbol()
     std::vector<ProjectedCollisionBox> textBoxes;
@@ -0,0 +1,202 @@
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/util/hash.hpp>
+
+#include <algorithm>
+#include <string_view>
+
+namespace mbgl {
+
+namespace {
+
+// Resolves a character the same way shapeLines() does, returning nothing if
+// it would be skipped.
+std::optional<GlyphMetrics> resolveGlyph(GlyphID id,
+                                         FontStackHash fontStack,
+                                         const GlyphMap& glyphMap,
+                                         const GlyphPositions& glyphPositions,
+                                         Rect<uint16_t>* rect = nullptr) {
+    auto positions = glyphPositions.find(fontStack);
+    if (positions == glyphPositions.end()) {
+        return std::nullopt;
+    }
+    if (auto position = positions->second.find(id); position != positions->second.end()) {
+        if (rect) {
+            *rect = position->second.rect;
+        }
+        return position->second.metrics;
+    }
+    auto glyphs = glyphMap.find(fontStack);
+    if (glyphs == glyphMap.end()) {
+        return std::nullopt;
+    }
+    auto glyph = glyphs->second.find(id);
+    if (glyph == glyphs->second.end() || !glyph->second) {
+        return std::nullopt;
+    }
+    if (rect) {
+        *rect = {};
+    }
+    return (*glyph->second)->metrics;
+}
+
+} // namespace
+
+bool ShapingCache::Key::operator==(const Key& other) const {
+    return text == other.text && sectionIndex == other.sectionIndex && sections == other.sections &&
+           maxWidth == other.maxWidth && lineHeight == other.lineHeight && spacing == other.spacing &&
+           translate == other.translate && textAnchor == other.textAnchor && textJustify == other.textJustify &&
+           writingMode == other.writingMode && allowVerticalPlacement == other.allowVerticalPlacement;
+}
+
+std::size_t ShapingCache::KeyHasher::operator()(const Key& key) const {
+    std::size_t seed = util::hash(key.text,
+                                  std::string_view(reinterpret_cast<const char*>(key.sectionIndex.data()),
+                                                   key.sectionIndex.size()),
+                                  key.maxWidth,
+                                  key.lineHeight,
+                                  key.spacing,
+                                  key.translate[0],
+                                  key.translate[1],
+                                  static_cast<uint8_t>(key.textAnchor),
+                                  static_cast<uint8_t>(key.textJustify),
+                                  static_cast<uint8_t>(key.writingMode),
+                                  key.allowVerticalPlacement);
+    for (const auto& section : key.sections) {
+        util::hash_combine(seed, section.first);
+        util::hash_combine(seed, section.second);
+    }
+    return seed;
+}
+
+ShapingCache::ShapingCache(std::size_t capacity_)
+    : capacity(std::max<std::size_t>(capacity_, 1)) {}
+
+ShapingCache& ShapingCache::get() {
+    static ShapingCache instance;
+    return instance;
+}
+
+Shaping ShapingCache::getShaping(const TaggedString& string,
+                                 const float maxWidth,
+                                 const float lineHeight,
+                                 const style::SymbolAnchorType textAnchor,
+                                 const style::TextJustifyType textJustify,
+                                 const float spacing,
+                                 const std::array<float, 2>& translate,
+                                 const WritingModeType writingMode,
+                                 BiDi& bidi,
+                                 const GlyphMap& glyphMap,
+                                 const GlyphPositions& glyphPositions,
+                                 const ImagePositions& imagePositions,
+                                 const float layoutTextSize,
+                                 const float layoutTextSizeAtBucketZoomLevel,
+                                 const bool allowVerticalPlacement) {
+    const auto shape = [&] {
+        return mbgl::getShaping(string,
+                                maxWidth,
+                                lineHeight,
+                                textAnchor,
+                                textJustify,
+                                spacing,
+                                translate,
+                                writingMode,
+                                bidi,
+                                glyphMap,
+                                glyphPositions,
+                                imagePositions,
+                                layoutTextSize,
+                                layoutTextSizeAtBucketZoomLevel,
+                                allowVerticalPlacement);
+    };
+
+    const auto& sections = string.getSections();
+    if (std::any_of(sections.begin(), sections.end(), [](const auto& section) { return section.imageID; })) {
+        return shape();
+    }
+
+    Key key{string.rawText(),
+            string.getStyledText().second,
+            {},
+            maxWidth,
+            lineHeight,
+            spacing,
+            translate,
+            textAnchor,
+            textJustify,
+            writingMode,
+            allowVerticalPlacement};
+    key.sections.reserve(sections.size());
+    for (const auto& section : sections) {
+        key.sections.emplace_back(section.scale, section.fontStackHash);
+    }
+
+    std::vector<std::optional<GlyphMetrics>> metrics;
+    metrics.reserve(string.length());
+    for (std::size_t i = 0; i < string.length(); ++i) {
+        metrics.push_back(
+            resolveGlyph(string.getCharCodeAt(i), string.getSection(i).fontStackHash, glyphMap, glyphPositions));
+    }
+
+    std::shared_ptr<const Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (auto it = items.find(key); it != items.end()) {
+            entry = it->second.entry;
+            order.splice(order.begin(), order, it->second.order);
+        }
+    }
+
+    if (entry && entry->metrics == metrics) {
+        // Line breaks and ordering still hold, only the atlas positions of
+        // the glyphs are specific to the caller.
+        Shaping shaping = entry->shaping;
+        bool valid = true;
+        for (auto& line : shaping.positionedLines) {
+            for (auto& glyph : line.positionedGlyphs) {
+                const auto current = resolveGlyph(glyph.glyph, glyph.font, glyphMap, glyphPositions, &glyph.rect);
+                // BiDi mirroring may have produced a character which was not
+                // part of the original text
+                valid = valid && current && *current == glyph.metrics;
+            }
+        }
+        if (valid) {
+            return shaping;
+        }
+    }
+
+    Shaping shaping = shape();
+
+    auto newEntry = std::make_shared<Entry>();
+    newEntry->shaping = shaping;
+    newEntry->metrics = std::move(metrics);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto result = items.try_emplace(std::move(key));
+    auto& item = result.first->second;
+    item.entry = std::move(newEntry);
+    if (result.second) {
+        order.push_front(&result.first->first);
+        item.order = order.begin();
+        if (items.size() > capacity) {
+            items.erase(*order.back());
+            order.pop_back();
+        }
+    } else {
+        order.splice(order.begin(), order, item.order);
+    }
+
+    return shaping;
+}
+
+std::size_t ShapingCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return items.size();
+}
+
+void ShapingCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    items.clear();
+    order.clear();
+}
+
+} // namespace mbgl
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <mbgl/text/shaping.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+/**
+ * A bounded cache of text shapings, shared by the tile workers so that labels
+ * repeated in neighbouring tiles and zoom levels only go through line breaking
+ * and BiDi reordering once.
+ *
+ * A shaping refers to glyph atlas positions, which differ between tiles. An
+ * entry is only reused when the caller resolves every character to the same
+ * glyph metrics it was shaped with; the atlas rectangles of the result are
+ * then taken from the caller's glyph positions. Text containing images is not
+ * cached, as image sizes can change with the style.
+ */
+class ShapingCache : private util::noncopyable {
+public:
+    static constexpr std::size_t defaultCapacity = 4096;
+
+    explicit ShapingCache(std::size_t capacity = defaultCapacity);
+
+    // The cache used by all symbol layouts in the process
+    static ShapingCache& get();
+
+    // Same as mbgl::getShaping(), reusing a previous result when possible
+    Shaping getShaping(const TaggedString& string,
+                       float maxWidth,
+                       float lineHeight,
+                       style::SymbolAnchorType textAnchor,
+                       style::TextJustifyType textJustify,
+                       float spacing,
+                       const std::array<float, 2>& translate,
+                       WritingModeType,
+                       BiDi& bidi,
+                       const GlyphMap& glyphMap,
+                       const GlyphPositions& glyphPositions,
+                       const ImagePositions& imagePositions,
+                       float layoutTextSize,
+                       float layoutTextSizeAtBucketZoomLevel,
+                       bool allowVerticalPlacement);
+
+    std::size_t size() const;
+    void clear();
+
+private:
+    struct Key {
+        std::u16string text;
+        std::vector<uint8_t> sectionIndex;
+        std::vector<std::pair<double, FontStackHash>> sections;
+        float maxWidth;
+        float lineHeight;
+        float spacing;
+        std::array<float, 2> translate;
+        style::SymbolAnchorType textAnchor;
+        style::TextJustifyType textJustify;
+        WritingModeType writingMode;
+        bool allowVerticalPlacement;
+
+        bool operator==(const Key&) const;
+    };
+
+    struct KeyHasher {
+        std::size_t operator()(const Key&) const;
+    };
+
+    struct Entry {
+        Shaping shaping;
+        // Metrics of each character of the text, as seen when it was shaped
+        std::vector<std::optional<GlyphMetrics>> metrics;
+    };
+
+    struct Item {
+        std::shared_ptr<const Entry> entry;
+        std::list<const Key*>::iterator order;
+    };
+
+    const std::size_t capacity;
+    mutable std::mutex mutex;
+    std::unordered_map<Key, Item, KeyHasher> items;
+    // Most recently used first
+    std::list<const Key*> order;
+};
+
+} // namespace mbgl
@@ -16,16 +16,21 @@ GeoJSONTile::GeoJSONTile(const OverscaledTileID& overscaledTileID,
 
 void GeoJSONTile::updateData(std::shared_ptr<style::GeoJSONData> data_, bool needsRelayout) {
     assert(data_);
+    auto previous = std::move(data);
     data = std::move(data_);
+    if (!needsRelayout && previous && !data->isTileChanged(id.canonical, *previous)) {
+        // Same features, keep the tile and any pending request
+        return;
+    }
     if (needsRelayout) reset();
-    data->getTile(
-        id.canonical,
-        [this, self = weakFactory.makeWeakPtr(), capturedData = data.get()](style::GeoJSONData::TileFeatures features) {
-            if (!self) return;
-            if (data.get() != capturedData) return;
-            auto tileData = std::make_unique<GeoJSONTileData>(std::move(features));
-            setData(std::move(tileData));
-        });
+    data->getTile(id.canonical,
+                  [this, self = weakFactory.makeWeakPtr(), capturedRequest = ++dataRequest](
+                      style::GeoJSONData::TileFeatures features) {
+                      if (!self) return;
+                      if (dataRequest != capturedRequest) return;
+                      auto tileData = std::make_unique<GeoJSONTileData>(std::move(features));
+                      setData(std::move(tileData));
+                  });
 }
 
 void GeoJSONTile::querySourceFeatures(std::vector<Feature>& result, const SourceQueryOptions& options) {
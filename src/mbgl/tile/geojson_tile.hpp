@@ -23,6 +23,8 @@ public:
 
 private:
     std::shared_ptr<style::GeoJSONData> data;
+    // Increased by each tile request, so that replies for older data are ignored
+    std::uint64_t dataRequest = 0;
     mapbox::base::WeakPtrFactory<GeoJSONTile> weakFactory{this};
 };
 
@@ -15,11 +15,13 @@
 #include <mbgl/renderer/tile_render_data.hpp>
 #include <mbgl/style/layer_impl.hpp>
 #include <mbgl/style/layers/background_layer.hpp>
+#include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/tile/geometry_tile_worker.hpp>
 #include <mbgl/tile/tile_observer.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/string.hpp>
 
 #include <mbgl/gfx/upload_pass.hpp>
 #include <utility>
@@ -86,6 +88,13 @@ void GeometryTileRenderData::upload(gfx::UploadPass& uploadPass) {
 
     assert(atlasTextures);
 
+#if MLN_DRAWABLE_RENDERER
+    // The shared atlas may have been patched or reallocated by other tiles
+    if (const auto sharedGlyphAtlas = layoutResult->sharedGlyphs ? layoutResult->sharedGlyphs->getAtlas() : nullptr) {
+        atlasTextures->glyph = sharedGlyphAtlas->upload(uploadPass);
+    }
+#endif
+
     if (layoutResult->glyphAtlasImage && layoutResult->glyphAtlasImage->valid()) {
 #if MLN_DRAWABLE_RENDERER
         atlasTextures->glyph = uploadPass.getContext().createTexture2D();
@@ -167,7 +176,13 @@ GeometryTile::GeometryTile(const OverscaledTileID& id_, std::string sourceID_, c
              obsolete,
              parameters.mode,
              parameters.pixelRatio,
-             parameters.debugOptions & MapDebugOptions::Collision),
+             parameters.debugOptions & MapDebugOptions::Collision,
+#if MLN_DRAWABLE_RENDERER
+             parameters.glyphManager.getSharedAtlas()),
+#else
+             // Legacy textures can't be shared between tiles
+             nullptr),
+#endif
       fileSource(parameters.fileSource),
       glyphManager(parameters.glyphManager),
       imageManager(parameters.imageManager),
@@ -449,4 +464,22 @@ void GeometryTile::setFeatureState(const LayerFeatureStates& states) {
     }
 }
 
+void GeometryTile::dumpDebugLogs() const {
+    Tile::dumpDebugLogs();
+    if (!layoutResult) {
+        return;
+    }
+    for (const auto& entry : layoutResult->layerRenderData) {
+        const LayerRenderData& renderData = entry.second;
+        if (!renderData.bucket ||
+            renderData.layerProperties->baseImpl->getTypeInfo() != style::SymbolLayer::Impl::staticTypeInfo()) {
+            continue;
+        }
+        const auto& bucket = static_cast<const SymbolBucket&>(*renderData.bucket);
+        Log::Info(Event::General,
+                  "GeometryTile::symbols[" + entry.first + "]: " + util::toString(bucket.symbolInstances.size()) +
+                      " instances, " + util::toString(bucket.getSymbolInstancesMemoryUsage()) + " bytes");
+    }
+}
+
 } // namespace mbgl
@@ -68,6 +68,8 @@ public:
         std::unordered_map<std::string, LayerRenderData> layerRenderData;
         std::shared_ptr<FeatureIndex> featureIndex;
         std::optional<AlphaImage> glyphAtlasImage;
+        // Set instead of `glyphAtlasImage` when glyphs are in the shared atlas
+        std::unique_ptr<SharedGlyphAtlas::Reference> sharedGlyphs;
         ImageAtlas iconAtlas;
 
         LayerRenderData* getLayerRenderData(const style::Layer::Impl&);
@@ -75,10 +77,12 @@ public:
         LayoutResult(std::unordered_map<std::string, LayerRenderData> renderData_,
                      std::unique_ptr<FeatureIndex> featureIndex_,
                      std::optional<AlphaImage> glyphAtlasImage_,
+                     std::unique_ptr<SharedGlyphAtlas::Reference> sharedGlyphs_,
                      ImageAtlas iconAtlas_)
             : layerRenderData(std::move(renderData_)),
               featureIndex(std::move(featureIndex_)),
               glyphAtlasImage(std::move(glyphAtlasImage_)),
+              sharedGlyphs(std::move(sharedGlyphs_)),
               iconAtlas(std::move(iconAtlas_)) {}
     };
     void onLayout(std::shared_ptr<LayoutResult>, uint64_t correlationID);
@@ -95,6 +99,8 @@ public:
 
     void setFeatureState(const LayerFeatureStates&) override;
 
+    void dumpDebugLogs() const override;
+
 protected:
     const GeometryTileData* getData() const;
     LayerRenderData* getLayerRenderData(const style::Layer::Impl&);
@@ -34,7 +34,8 @@ GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
                                        const std::atomic<bool>& obsolete_,
                                        const MapMode mode_,
                                        const float pixelRatio_,
-                                       const bool showCollisionBoxes_)
+                                       const bool showCollisionBoxes_,
+                                       std::shared_ptr<SharedGlyphAtlas> sharedGlyphAtlas_)
     : self(std::move(self_)),
       parent(std::move(parent_)),
       id(id_),
@@ -42,6 +43,7 @@ GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
       obsolete(obsolete_),
       mode(mode_),
       pixelRatio(pixelRatio_),
+      sharedGlyphAtlas(std::move(sharedGlyphAtlas_)),
       showCollisionBoxes(showCollisionBoxes_) {}
 
 GeometryTileWorker::~GeometryTileWorker() = default;
@@ -458,17 +460,27 @@ void GeometryTileWorker::finalizeLayout() {
 
     MBGL_TIMING_START(watch)
     std::optional<AlphaImage> glyphAtlasImage;
+    std::unique_ptr<SharedGlyphAtlas::Reference> sharedGlyphs;
     ImageAtlas iconAtlas = makeImageAtlas(imageMap, patternMap, versionMap);
     if (!layouts.empty()) {
-        GlyphAtlas glyphAtlas = makeGlyphAtlas(glyphMap);
-        glyphAtlasImage = std::move(glyphAtlas.image);
+        // Prefer the renderer's shared atlas, and only build a private one
+        // for this tile if the glyphs don't fit.
+        GlyphAtlas glyphAtlas;
+        if (sharedGlyphAtlas) {
+            sharedGlyphs = sharedGlyphAtlas->acquire(glyphMap);
+        }
+        if (!sharedGlyphs) {
+            glyphAtlas = makeGlyphAtlas(glyphMap);
+            glyphAtlasImage = std::move(glyphAtlas.image);
+        }
+        const GlyphPositions& glyphPositions = sharedGlyphs ? sharedGlyphs->getPositions() : glyphAtlas.positions;
 
         for (auto& layout : layouts) {
             if (obsolete) {
                 return;
             }
 
-            layout->prepareSymbols(glyphMap, glyphAtlas.positions, imageMap, iconAtlas.iconPositions);
+            layout->prepareSymbols(glyphMap, glyphPositions, imageMap, iconAtlas.iconPositions);
 
             if (!layout->hasSymbolInstances()) {
                 continue;
@@ -491,8 +503,11 @@ void GeometryTileWorker::finalizeLayout() {
                            << "/" << id.canonical.x << "/" << id.canonical.y << " Time");
 
     parent.invoke(&GeometryTile::onLayout,
-                  std::make_shared<GeometryTile::LayoutResult>(
-                      std::move(renderData), std::move(featureIndex), std::move(glyphAtlasImage), std::move(iconAtlas)),
+                  std::make_shared<GeometryTile::LayoutResult>(std::move(renderData),
+                                                               std::move(featureIndex),
+                                                               std::move(glyphAtlasImage),
+                                                               std::move(sharedGlyphs),
+                                                               std::move(iconAtlas)),
                   correlationID);
 }
 
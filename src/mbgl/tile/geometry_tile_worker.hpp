@@ -18,6 +18,7 @@
 namespace mbgl {
 
 class GeometryTile;
+class SharedGlyphAtlas;
 class GeometryTileData;
 class Layout;
 
@@ -34,7 +35,8 @@ public:
                        const std::atomic<bool>&,
                        MapMode,
                        float pixelRatio,
-                       bool showCollisionBoxes_);
+                       bool showCollisionBoxes_,
+                       std::shared_ptr<SharedGlyphAtlas> sharedGlyphAtlas_);
     ~GeometryTileWorker();
 
     void setLayers(std::vector<Immutable<style::LayerProperties>>,
@@ -76,6 +78,8 @@ private:
     const std::atomic<bool>& obsolete;
     const MapMode mode;
     const float pixelRatio;
+    // Null if each tile should build its own glyph atlas
+    const std::shared_ptr<SharedGlyphAtlas> sharedGlyphAtlas;
 
     std::unique_ptr<FeatureIndex> featureIndex;
     std::unordered_map<std::string, LayerRenderData> renderData;
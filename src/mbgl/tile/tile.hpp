@@ -133,7 +133,7 @@ public:
 
     virtual void setFeatureState(const LayerFeatureStates&) {}
 
-    void dumpDebugLogs() const;
+    virtual void dumpDebugLogs() const;
 
     const Kind kind;
     OverscaledTileID id;
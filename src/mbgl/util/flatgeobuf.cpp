@@ -0,0 +1,470 @@
+#include <mbgl/util/flatgeobuf.hpp>
+#include <mbgl/util/mapped_file.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+// "fgb", major version 3, "fgb", then any patch version
+constexpr char magicBytes[] = {0x66, 0x67, 0x62, 0x03, 0x66, 0x67, 0x62};
+constexpr std::size_t magicSize = 8;
+// Bounding box and offset of an R-tree node
+constexpr std::size_t nodeItemSize = 40;
+
+enum class GeometryType : std::uint8_t {
+    Unknown,
+    Point,
+    LineString,
+    Polygon,
+    MultiPoint,
+    MultiLineString,
+    MultiPolygon,
+    GeometryCollection
+};
+
+enum class ColumnType : std::uint8_t {
+    Byte,
+    UByte,
+    Bool,
+    Short,
+    UShort,
+    Int,
+    UInt,
+    Long,
+    ULong,
+    Float,
+    Double,
+    String,
+    Json,
+    DateTime,
+    Binary
+};
+
+// Fields of the tables, by position in the schema
+namespace field {
+constexpr std::uint16_t headerGeometryType = 2;
+constexpr std::uint16_t headerColumns = 7;
+constexpr std::uint16_t headerFeaturesCount = 8;
+constexpr std::uint16_t headerIndexNodeSize = 9;
+constexpr std::uint16_t columnName = 0;
+constexpr std::uint16_t columnType = 1;
+constexpr std::uint16_t featureGeometry = 0;
+constexpr std::uint16_t featureProperties = 1;
+constexpr std::uint16_t featureColumns = 2;
+constexpr std::uint16_t geometryEnds = 0;
+constexpr std::uint16_t geometryXY = 1;
+constexpr std::uint16_t geometryType = 6;
+constexpr std::uint16_t geometryParts = 7;
+} // namespace field
+
+// Bytes of the file, read with bounds checks since the file may be corrupt
+class Bytes {
+public:
+    Bytes(const char* data_, std::size_t size_)
+        : data(data_),
+          size(size_) {}
+
+    void check(std::size_t offset, std::size_t length) const {
+        if (offset > size || length > size - offset) {
+            throw std::runtime_error("FlatGeobuf data out of bounds");
+        }
+    }
+
+    template <typename T>
+    T read(std::size_t offset) const {
+        check(offset, sizeof(T));
+        T value;
+        std::memcpy(&value, data + offset, sizeof(T));
+        return value;
+    }
+
+    Bytes slice(std::size_t offset, std::size_t length) const {
+        check(offset, length);
+        return {data + offset, length};
+    }
+
+    std::string string(std::size_t offset, std::size_t length) const {
+        check(offset, length);
+        return {data + offset, length};
+    }
+
+private:
+    const char* data;
+    std::size_t size;
+};
+
+// Elements of a FlatBuffers vector
+struct Vector {
+    std::size_t start;
+    std::uint32_t length;
+};
+
+// FlatBuffers table, read in place
+class Table {
+public:
+    Table(const Bytes& bytes_, std::size_t position_)
+        : bytes(bytes_),
+          position(position_),
+          vtable(position - static_cast<std::size_t>(static_cast<std::ptrdiff_t>(bytes.read<std::int32_t>(position)))),
+          vtableSize(bytes.read<std::uint16_t>(vtable)) {}
+
+    static Table root(const Bytes& bytes) { return {bytes, bytes.read<std::uint32_t>(0)}; }
+
+    template <typename T>
+    T scalar(std::uint16_t index, T fallback) const {
+        const std::uint16_t offset = fieldOffset(index);
+        return offset ? bytes.read<T>(position + offset) : fallback;
+    }
+
+    std::optional<Table> table(std::uint16_t index) const {
+        if (auto target = indirect(index)) {
+            return Table(bytes, *target);
+        }
+        return std::nullopt;
+    }
+
+    std::optional<Vector> vector(std::uint16_t index, std::size_t elementSize) const {
+        auto target = indirect(index);
+        if (!target) {
+            return std::nullopt;
+        }
+        Vector result{*target + 4, bytes.read<std::uint32_t>(*target)};
+        bytes.check(result.start, result.length * elementSize);
+        return result;
+    }
+
+    std::string string(std::uint16_t index) const {
+        auto chars = vector(index, 1);
+        return chars ? bytes.string(chars->start, chars->length) : std::string();
+    }
+
+    // Table at the position of a vector of tables
+    Table element(const Vector& tables, std::uint32_t i) const {
+        const std::size_t offset = tables.start + std::size_t(i) * 4;
+        return {bytes, offset + bytes.read<std::uint32_t>(offset)};
+    }
+
+    const Bytes& getBytes() const { return bytes; }
+
+private:
+    std::uint16_t fieldOffset(std::uint16_t index) const {
+        const std::size_t entry = 4 + 2 * std::size_t(index);
+        return entry + 2 <= vtableSize ? bytes.read<std::uint16_t>(vtable + entry) : 0;
+    }
+
+    std::optional<std::size_t> indirect(std::uint16_t index) const {
+        const std::uint16_t offset = fieldOffset(index);
+        if (!offset) {
+            return std::nullopt;
+        }
+        return position + offset + bytes.read<std::uint32_t>(position + offset);
+    }
+
+    Bytes bytes;
+    std::size_t position;
+    std::size_t vtable;
+    std::uint16_t vtableSize;
+};
+
+template <typename Points>
+Points readPoints(const Bytes& bytes, const Vector& xy, std::size_t begin, std::size_t end) {
+    Points points;
+    points.reserve(end - begin);
+    for (std::size_t i = begin; i < end; ++i) {
+        points.emplace_back(bytes.read<double>(xy.start + i * 16), bytes.read<double>(xy.start + i * 16 + 8));
+    }
+    return points;
+}
+
+// Lines or rings split at the ends, which are point positions
+template <typename Lines>
+Lines readLines(const Table& geometry, const Vector& xy) {
+    const Bytes& bytes = geometry.getBytes();
+    const std::size_t count = xy.length / 2;
+    Lines lines;
+    auto ends = geometry.vector(field::geometryEnds, 4);
+    if (!ends || ends->length == 0) {
+        lines.push_back(readPoints<typename Lines::value_type>(bytes, xy, 0, count));
+        return lines;
+    }
+    lines.reserve(ends->length);
+    std::size_t begin = 0;
+    for (std::uint32_t i = 0; i < ends->length; ++i) {
+        const std::size_t end = bytes.read<std::uint32_t>(ends->start + std::size_t(i) * 4);
+        if (end < begin || end > count) {
+            throw std::runtime_error("Invalid FlatGeobuf geometry ends");
+        }
+        lines.push_back(readPoints<typename Lines::value_type>(bytes, xy, begin, end));
+        begin = end;
+    }
+    return lines;
+}
+
+mapbox::geometry::geometry<double> readGeometry(const Table& geometry, GeometryType type) {
+    if (type == GeometryType::Unknown) {
+        type = static_cast<GeometryType>(geometry.scalar<std::uint8_t>(field::geometryType, 0));
+    }
+
+    if (auto parts = geometry.vector(field::geometryParts, 4)) {
+        if (type == GeometryType::MultiPolygon) {
+            mapbox::geometry::multi_polygon<double> polygons;
+            polygons.reserve(parts->length);
+            for (std::uint32_t i = 0; i < parts->length; ++i) {
+                auto part = readGeometry(geometry.element(*parts, i), GeometryType::Polygon);
+                if (part.is<mapbox::geometry::polygon<double>>()) {
+                    polygons.push_back(std::move(part.get<mapbox::geometry::polygon<double>>()));
+                }
+            }
+            return polygons;
+        }
+        if (type == GeometryType::GeometryCollection) {
+            mapbox::geometry::geometry_collection<double> geometries;
+            geometries.reserve(parts->length);
+            for (std::uint32_t i = 0; i < parts->length; ++i) {
+                geometries.push_back(readGeometry(geometry.element(*parts, i), GeometryType::Unknown));
+            }
+            return geometries;
+        }
+    }
+
+    auto xy = geometry.vector(field::geometryXY, 8);
+    if (!xy) {
+        return mapbox::geometry::empty();
+    }
+    const Bytes& bytes = geometry.getBytes();
+    const std::size_t count = xy->length / 2;
+    switch (type) {
+        case GeometryType::Point:
+            if (count == 0) {
+                return mapbox::geometry::empty();
+            }
+            return mapbox::geometry::point<double>(bytes.read<double>(xy->start), bytes.read<double>(xy->start + 8));
+        case GeometryType::MultiPoint:
+            return readPoints<mapbox::geometry::multi_point<double>>(bytes, *xy, 0, count);
+        case GeometryType::LineString:
+            return readPoints<mapbox::geometry::line_string<double>>(bytes, *xy, 0, count);
+        case GeometryType::MultiLineString:
+            return readLines<mapbox::geometry::multi_line_string<double>>(geometry, *xy);
+        case GeometryType::Polygon:
+            return readLines<mapbox::geometry::polygon<double>>(geometry, *xy);
+        case GeometryType::MultiPolygon:
+            // Single polygon written without parts
+            return mapbox::geometry::multi_polygon<double>{readLines<mapbox::geometry::polygon<double>>(geometry, *xy)};
+        default:
+            // Curves and surfaces are not supported
+            return mapbox::geometry::empty();
+    }
+}
+
+template <typename Column>
+std::vector<Column> readColumns(const Table& table, std::uint16_t index) {
+    std::vector<Column> columns;
+    if (auto vector = table.vector(index, 4)) {
+        columns.reserve(vector->length);
+        for (std::uint32_t i = 0; i < vector->length; ++i) {
+            const Table column = table.element(*vector, i);
+            columns.push_back(
+                {column.string(field::columnName), column.scalar<std::uint8_t>(field::columnType, 0)});
+        }
+    }
+    return columns;
+}
+
+// Properties are pairs of column index and value
+template <typename Column>
+PropertyMap readProperties(const Bytes& bytes, const Vector& properties, const std::vector<Column>& columns) {
+    PropertyMap result;
+    std::size_t position = properties.start;
+    const std::size_t end = properties.start + properties.length;
+    while (position < end) {
+        const auto index = bytes.read<std::uint16_t>(position);
+        position += 2;
+        if (index >= columns.size()) {
+            throw std::runtime_error("Invalid FlatGeobuf property column");
+        }
+        const auto& column = columns[index];
+        Value value;
+        switch (static_cast<ColumnType>(column.type)) {
+            case ColumnType::Byte:
+                value = static_cast<int64_t>(bytes.read<int8_t>(position));
+                position += 1;
+                break;
+            case ColumnType::UByte:
+                value = static_cast<uint64_t>(bytes.read<uint8_t>(position));
+                position += 1;
+                break;
+            case ColumnType::Bool:
+                value = bytes.read<uint8_t>(position) != 0;
+                position += 1;
+                break;
+            case ColumnType::Short:
+                value = static_cast<int64_t>(bytes.read<int16_t>(position));
+                position += 2;
+                break;
+            case ColumnType::UShort:
+                value = static_cast<uint64_t>(bytes.read<uint16_t>(position));
+                position += 2;
+                break;
+            case ColumnType::Int:
+                value = static_cast<int64_t>(bytes.read<int32_t>(position));
+                position += 4;
+                break;
+            case ColumnType::UInt:
+                value = static_cast<uint64_t>(bytes.read<uint32_t>(position));
+                position += 4;
+                break;
+            case ColumnType::Long:
+                value = bytes.read<int64_t>(position);
+                position += 8;
+                break;
+            case ColumnType::ULong:
+                value = bytes.read<uint64_t>(position);
+                position += 8;
+                break;
+            case ColumnType::Float:
+                value = static_cast<double>(bytes.read<float>(position));
+                position += 4;
+                break;
+            case ColumnType::Double:
+                value = bytes.read<double>(position);
+                position += 8;
+                break;
+            case ColumnType::String:
+            case ColumnType::Json:
+            case ColumnType::DateTime: {
+                const auto length = bytes.read<uint32_t>(position);
+                value = bytes.string(position + 4, length);
+                position += 4 + std::size_t(length);
+                break;
+            }
+            case ColumnType::Binary:
+                // Skipped, since values cannot hold bytes
+                position += 4 + std::size_t(bytes.read<uint32_t>(position));
+                continue;
+            default:
+                throw std::runtime_error("Invalid FlatGeobuf property type");
+        }
+        result[column.name] = std::move(value);
+    }
+    return result;
+}
+
+} // namespace
+
+FlatGeobufFile::FlatGeobufFile(const std::string& path)
+    : file(std::make_unique<MappedFile>(path)) {
+    const Bytes bytes(file->data(), file->size());
+    if (file->size() < magicSize + 4 || std::memcmp(file->data(), magicBytes, sizeof(magicBytes)) != 0) {
+        throw std::runtime_error(path + " is not a FlatGeobuf file");
+    }
+
+    const auto headerSize = bytes.read<std::uint32_t>(magicSize);
+    const Table header = Table::root(bytes.slice(magicSize + 4, headerSize));
+    geometryType = header.scalar<std::uint8_t>(field::headerGeometryType, 0);
+    columns = readColumns<Column>(header, field::headerColumns);
+    featureCount = header.scalar<std::uint64_t>(field::headerFeaturesCount, 0);
+    nodeSize = header.scalar<std::uint16_t>(field::headerIndexNodeSize, 16);
+    if (nodeSize < 2) {
+        throw std::runtime_error(path + " has no spatial index");
+    }
+
+    indexStart = magicSize + 4 + headerSize;
+    std::uint64_t nodeCount = 0;
+    if (featureCount > 0) {
+        // Node count of each level, from the leaves up to the root
+        std::vector<std::uint64_t> levelSizes;
+        std::uint64_t size = featureCount;
+        levelSizes.push_back(size);
+        nodeCount = size;
+        do {
+            size = (size + nodeSize - 1) / nodeSize;
+            levelSizes.push_back(size);
+            nodeCount += size;
+        } while (size != 1);
+
+        // Levels are stored from the root
+        std::uint64_t end = nodeCount;
+        for (const std::uint64_t levelSize : levelSizes) {
+            levels.emplace_back(end - levelSize, end);
+            end -= levelSize;
+        }
+    }
+    if (nodeCount > (file->size() - indexStart) / nodeItemSize) {
+        throw std::runtime_error(path + " has an incomplete spatial index");
+    }
+    featuresStart = indexStart + static_cast<std::size_t>(nodeCount) * nodeItemSize;
+}
+
+FlatGeobufFile::~FlatGeobufFile() = default;
+
+FlatGeobufFile::Features FlatGeobufFile::query(const Box& box) const {
+    Features result;
+    if (levels.empty()) {
+        return result;
+    }
+
+    const Bytes bytes(file->data(), file->size());
+    const std::uint64_t nodeCount = levels.front().second;
+    // Offsets and positions of the features found
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> found;
+    // First nodes of the groups of siblings to visit, with their level
+    std::vector<std::pair<std::uint64_t, std::size_t>> queue{{0, levels.size() - 1}};
+    while (!queue.empty()) {
+        const auto [first, level] = queue.back();
+        queue.pop_back();
+        const std::uint64_t end = std::min<std::uint64_t>(first + nodeSize, levels[level].second);
+        for (std::uint64_t node = first; node < end; ++node) {
+            const std::size_t item = indexStart + static_cast<std::size_t>(node) * nodeItemSize;
+            if (bytes.read<double>(item) > box.max.x || bytes.read<double>(item + 8) > box.max.y ||
+                bytes.read<double>(item + 16) < box.min.x || bytes.read<double>(item + 24) < box.min.y) {
+                continue;
+            }
+            const auto offset = bytes.read<std::uint64_t>(item + 32);
+            if (level == 0) {
+                found.emplace_back(offset, node - levels[0].first);
+            } else if (offset < nodeCount) {
+                // Offset of the first child
+                queue.emplace_back(offset, level - 1);
+            } else {
+                throw std::runtime_error("Invalid FlatGeobuf spatial index");
+            }
+        }
+    }
+
+    // Reading in order keeps the reads of the file sequential
+    std::sort(found.begin(), found.end());
+    result.reserve(found.size());
+    for (const auto& feature : found) {
+        result.push_back(readFeature(feature.first));
+        result.back().id = feature.second;
+    }
+    return result;
+}
+
+GeoJSONFeature FlatGeobufFile::readFeature(std::uint64_t offset) const {
+    const Bytes bytes(file->data(), file->size());
+    const std::size_t position = featuresStart + static_cast<std::size_t>(offset);
+    const auto size = bytes.read<std::uint32_t>(position);
+    const Table feature = Table::root(bytes.slice(position + 4, size));
+
+    GeoJSONFeature result;
+    if (auto geometry = feature.table(field::featureGeometry)) {
+        result.geometry = readGeometry(*geometry, static_cast<GeometryType>(geometryType));
+    }
+    if (auto properties = feature.vector(field::featureProperties, 1)) {
+        // Features may have their own columns
+        auto featureColumns = readColumns<Column>(feature, field::featureColumns);
+        result.properties = readProperties(
+            feature.getBytes(), *properties, featureColumns.empty() ? columns : featureColumns);
+    }
+    return result;
+}
+
+} // namespace util
+} // namespace mbgl
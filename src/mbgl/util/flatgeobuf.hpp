@@ -0,0 +1,60 @@
+#pragma once
+
+#include <mbgl/util/feature.hpp>
+
+#include <mapbox/geometry/box.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+class MappedFile;
+
+// Reader of FlatGeobuf files with a spatial index. The file is mapped in
+// memory, and only the features asked for are decoded, so that reading
+// does not depend on the size of the file. Coordinates are taken as
+// longitude and latitude. Features get their position in the file as ID.
+// Reading is thread-safe.
+class FlatGeobufFile {
+public:
+    using Box = mapbox::geometry::box<double>;
+    using Features = mapbox::feature::feature_collection<double>;
+
+    // Throws std::runtime_error if the file cannot be read, is not
+    // FlatGeobuf or has no spatial index
+    explicit FlatGeobufFile(const std::string& path);
+    ~FlatGeobufFile();
+
+    std::uint64_t getFeatureCount() const { return featureCount; }
+
+    // Decodes the features whose bounding box intersects the box, in the
+    // order of the file
+    Features query(const Box&) const;
+
+private:
+    struct Column {
+        std::string name;
+        std::uint8_t type;
+    };
+
+    GeoJSONFeature readFeature(std::uint64_t offset) const;
+
+    std::unique_ptr<MappedFile> file;
+    std::uint8_t geometryType = 0;
+    std::vector<Column> columns;
+    std::uint64_t featureCount = 0;
+    std::uint16_t nodeSize = 0;
+    // First and last node of each level of the R-tree, from the leaves to
+    // the root
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> levels;
+    std::size_t indexStart = 0;
+    std::size_t featuresStart = 0;
+};
+
+} // namespace util
+} // namespace mbgl
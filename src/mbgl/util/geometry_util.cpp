@@ -1,6 +1,7 @@
 #include <mbgl/util/geometry_util.hpp>
 
 #include <algorithm>
+#include <cmath>
 
 namespace mbgl {
 
@@ -140,6 +141,140 @@ bool lineStringWithinPolygons(const LineString<T>& line, const MultiPolygon<T>&
     return false;
 }
 
+template <typename T>
+IndexedPolygon<T>::IndexedPolygon(const Polygon<T>& polygon)
+    : bbox({{std::numeric_limits<T>::max(),
+             std::numeric_limits<T>::max(),
+             std::numeric_limits<T>::lowest(),
+             std::numeric_limits<T>::lowest()}}) {
+    std::size_t edgeCount = 0;
+    for (const auto& ring : polygon) {
+        for (const auto& p : ring) {
+            updateBBox(bbox, p);
+        }
+        if (ring.size() > 1) {
+            edgeCount += ring.size() - 1;
+        }
+    }
+    if (edgeCount == 0) {
+        bandOffsets.assign(2, 0);
+        return;
+    }
+
+    // With about as many bands as edges in a band, a query costs O(sqrt(n))
+    // for reasonably shaped polygons
+    const auto bandCount = static_cast<std::size_t>(std::sqrt(static_cast<double>(edgeCount))) + 1;
+    bandHeight = (bbox[3] - bbox[1]) / static_cast<T>(bandCount);
+    if (bandHeight <= 0) {
+        bandHeight = 1;
+    }
+
+    bandOffsets.assign(bandCount + 1, 0);
+    const auto eachEdge = [&](auto&& fn) {
+        for (const auto& ring : polygon) {
+            for (std::size_t i = 0; i + 1 < ring.size(); ++i) {
+                const auto& a = ring[i];
+                const auto& b = ring[i + 1];
+                const std::size_t last = bandOf(std::max(a.y, b.y));
+                for (std::size_t band = bandOf(std::min(a.y, b.y)); band <= last; ++band) {
+                    fn(band, a, b);
+                }
+            }
+        }
+    };
+    eachEdge([&](std::size_t band, const auto&, const auto&) { bandOffsets[band + 1]++; });
+    for (std::size_t band = 0; band < bandCount; ++band) {
+        bandOffsets[band + 1] += bandOffsets[band];
+    }
+    bandEdges.resize(bandOffsets.back());
+    std::vector<uint32_t> next(bandOffsets.begin(), bandOffsets.end() - 1);
+    eachEdge([&](std::size_t band, const auto& a, const auto& b) { bandEdges[next[band]++] = {a, b}; });
+}
+
+template <typename T>
+std::size_t IndexedPolygon<T>::bandOf(T y) const {
+    if (y <= bbox[1]) {
+        return 0;
+    }
+    return std::min(bandOffsets.size() - 2, static_cast<std::size_t>((y - bbox[1]) / bandHeight));
+}
+
+template <typename T>
+bool IndexedPolygon<T>::pointWithin(const Point<T>& point, bool trueOnBoundary) const {
+    // Points left of the polygon are still tested, so that unclosed rings
+    // give the same result as pointWithinPolygon()
+    if (point.y < bbox[1] || point.y > bbox[3] || point.x > bbox[2]) {
+        return false;
+    }
+    const std::size_t band = bandOf(point.y);
+    bool within = false;
+    for (uint32_t i = bandOffsets[band]; i < bandOffsets[band + 1]; ++i) {
+        const auto& edge = bandEdges[i];
+        if (pointOnBoundary(point, edge.first, edge.second)) return trueOnBoundary;
+        if (rayIntersect(point, edge.first, edge.second)) {
+            within = !within;
+        }
+    }
+    return within;
+}
+
+template <typename T>
+bool IndexedPolygon<T>::lineIntersects(const Point<T>& p1, const Point<T>& p2) const {
+    const T minX = std::min(p1.x, p2.x);
+    const T maxX = std::max(p1.x, p2.x);
+    const T minY = std::min(p1.y, p2.y);
+    const T maxY = std::max(p1.y, p2.y);
+    // Crossing segments have overlapping bounding boxes
+    if (maxY < bbox[1] || minY > bbox[3] || maxX < bbox[0] || minX > bbox[2]) {
+        return false;
+    }
+    const std::size_t last = bandOf(std::min(maxY, bbox[3]));
+    for (std::size_t band = bandOf(minY); band <= last; ++band) {
+        for (uint32_t i = bandOffsets[band]; i < bandOffsets[band + 1]; ++i) {
+            const auto& edge = bandEdges[i];
+            if (std::max(edge.first.x, edge.second.x) < minX || std::min(edge.first.x, edge.second.x) > maxX ||
+                std::max(edge.first.y, edge.second.y) < minY || std::min(edge.first.y, edge.second.y) > maxY) {
+                continue;
+            }
+            if (segmentIntersectSegment(p1, p2, edge.first, edge.second)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <typename T>
+bool IndexedPolygon<T>::lineStringWithin(const LineString<T>& line) const {
+    for (const auto& point : line) {
+        if (!pointWithin(point)) {
+            return false;
+        }
+    }
+    for (std::size_t i = 0; i + 1 < line.size(); ++i) {
+        if (lineIntersects(line[i], line[i + 1])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool pointWithinPolygons(const Point<T>& point, const std::vector<IndexedPolygon<T>>& polygons, bool trueOnBoundary) {
+    for (const auto& polygon : polygons) {
+        if (polygon.pointWithin(point, trueOnBoundary)) return true;
+    }
+    return false;
+}
+
+template <typename T>
+bool lineStringWithinPolygons(const LineString<T>& line, const std::vector<IndexedPolygon<T>>& polygons) {
+    for (const auto& polygon : polygons) {
+        if (polygon.lineStringWithin(line)) return true;
+    }
+    return false;
+}
+
 template void updateBBox(GeometryBBox<int64_t>& bbox, const Point<int64_t>& p);
 template bool boxWithinBox(const GeometryBBox<int64_t>& bbox1, const GeometryBBox<int64_t>& bbox2);
 template bool segmentIntersectSegment(const Point<int64_t>& a,
@@ -155,6 +290,12 @@ template bool pointWithinPolygons(const Point<int64_t>& point,
                                   bool trueOnBoundary);
 template bool lineStringWithinPolygon(const LineString<int64_t>& line, const Polygon<int64_t>& polygon);
 template bool lineStringWithinPolygons(const LineString<int64_t>& line, const MultiPolygon<int64_t>& polygons);
+template class IndexedPolygon<int64_t>;
+template bool pointWithinPolygons(const Point<int64_t>& point,
+                                  const std::vector<IndexedPolygon<int64_t>>& polygons,
+                                  bool trueOnBoundary);
+template bool lineStringWithinPolygons(const LineString<int64_t>& line,
+                                       const std::vector<IndexedPolygon<int64_t>>& polygons);
 
 template void updateBBox(GeometryBBox<double>& bbox, const Point<double>& p);
 template bool boxWithinBox(const GeometryBBox<double>& bbox1, const GeometryBBox<double>& bbox2);
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <limits>
+#include <vector>
 #include <mbgl/util/geometry.hpp>
 
 namespace mbgl {
@@ -50,4 +52,41 @@ bool lineStringWithinPolygon(const LineString<T>& line, const Polygon<T>& polygo
 template <typename T>
 bool lineStringWithinPolygons(const LineString<T>& line, const MultiPolygon<T>& polygons);
 
+// A polygon with its edges bucketed into horizontal bands, so that a query
+// only visits the edges overlapping its y range instead of every edge of every
+// ring. Results are the same as those of the functions above.
+template <typename T>
+class IndexedPolygon {
+public:
+    explicit IndexedPolygon(const Polygon<T>&);
+
+    const GeometryBBox<T>& getBBox() const { return bbox; }
+
+    // Same as pointWithinPolygon()
+    bool pointWithin(const Point<T>& point, bool trueOnBoundary = false) const;
+    // Same as lineIntersectPolygon()
+    bool lineIntersects(const Point<T>& p1, const Point<T>& p2) const;
+    // Same as lineStringWithinPolygon()
+    bool lineStringWithin(const LineString<T>& line) const;
+
+private:
+    using Edge = std::pair<Point<T>, Point<T>>;
+
+    std::size_t bandOf(T y) const;
+
+    GeometryBBox<T> bbox;
+    T bandHeight = 1;
+    // Edges of band i are bandEdges[bandOffsets[i]] to bandEdges[bandOffsets[i + 1]]
+    std::vector<uint32_t> bandOffsets;
+    std::vector<Edge> bandEdges;
+};
+
+template <typename T>
+bool pointWithinPolygons(const Point<T>& point,
+                         const std::vector<IndexedPolygon<T>>& polygons,
+                         bool trueOnBoundary = false);
+
+template <typename T>
+bool lineStringWithinPolygons(const LineString<T>& line, const std::vector<IndexedPolygon<T>>& polygons);
+
 } // namespace mbgl
@@ -4,13 +4,14 @@
 #include <mapbox/geometry/box.hpp>
 #include <mbgl/math/minmax.hpp>
 
-#include <unordered_set>
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <cstddef>
+#include <limits>
+#include <utility>
 #include <vector>
-#include <functional>
-#include <optional>
 #include <cassert>
 
 namespace mbgl {
@@ -51,6 +52,13 @@ constexpr bool operator!=(circle<T> const& lhs, circle<T> const& rhs) {
  at least one cell. As long as the geometries are relatively
  uniformly distributed across the plane, this greatly reduces
  the number of comparisons necessary.
+
+ Geometries are stored as separate coordinate arrays and cells as
+ chains of fixed size blocks in a single array, so neither inserting
+ nor querying allocates beyond amortized growth of those arrays.
+ An item spanning several cells is reported from the first of its
+ cells covered by the query, which makes queries free of any
+ "already seen" bookkeeping.
 */
 
 template <class T>
@@ -67,25 +75,83 @@ public:
     std::vector<T> query(const BBox&) const;
     std::vector<std::pair<T, BBox>> queryWithBoxes(const BBox&) const;
 
-    bool hitTest(const BBox&, std::optional<std::function<bool(const T&)>> predicate = std::nullopt) const;
-    bool hitTest(const BCircle&, std::optional<std::function<bool(const T&)>> predicate = std::nullopt) const;
+    // Calls `resultFn(const T&, const BBox&)` for every item intersecting the
+    // box, in insertion order per cell, until it returns `true`.
+    template <typename ResultFn>
+    void query(const BBox&, ResultFn&& resultFn) const;
+
+    bool hitTest(const BBox&) const;
+    bool hitTest(const BCircle&) const;
+
+    // Returns true if an item accepted by `predicate(const T&)` intersects the geometry
+    template <typename Predicate>
+    bool hitTest(const BBox&, Predicate&& predicate) const;
+    template <typename Predicate>
+    bool hitTest(const BCircle&, Predicate&& predicate) const;
 
     bool empty() const;
 
 private:
+    static constexpr uint32_t noBlock = std::numeric_limits<uint32_t>::max();
+    static constexpr std::size_t blockCapacity = 6;
+
+    // A run of item indices in a cell, 32 bytes
+    struct CellBlock {
+        uint32_t next;
+        uint32_t count;
+        std::array<uint32_t, blockCapacity> items;
+    };
+
+    struct Cell {
+        uint32_t first = noBlock;
+        uint32_t last = noBlock;
+    };
+
+    struct CellRange {
+        std::size_t x1, y1, x2, y2;
+    };
+
+    struct Boxes {
+        std::vector<T> keys;
+        std::vector<float> minX, minY, maxX, maxY;
+        // First cell of each box, used to report a box only once per query
+        std::vector<uint32_t> cellX, cellY;
+    };
+
+    struct Circles {
+        std::vector<T> keys;
+        std::vector<float> x, y, radius;
+        std::vector<uint32_t> cellX, cellY;
+    };
+
     bool noIntersection(const BBox& queryBBox) const;
     bool completeIntersection(const BBox& queryBBox) const;
-    BBox convertToBox(const BCircle& circle) const;
-
-    void query(const BBox&, std::function<bool(const T&, const BBox&)>) const;
-    void query(const BCircle&, std::function<bool(const T&, const BBox&)>) const;
-
+    static BBox convertToBox(const BCircle& circle);
+    BBox circleBox(std::size_t i) const;
+    BBox boxAt(std::size_t i) const;
+
+    template <typename ResultFn>
+    bool forEach(ResultFn& resultFn) const;
+    template <typename Collides, typename ResultFn>
+    bool forEachInCell(const std::vector<Cell>&,
+                       const std::vector<uint32_t>& cellX,
+                       const std::vector<uint32_t>& cellY,
+                       const CellRange&,
+                       std::size_t x,
+                       std::size_t y,
+                       Collides& collides,
+                       ResultFn& resultFn) const;
+    template <typename ResultFn>
+    void query(const BCircle&, ResultFn& resultFn) const;
+
+    void addToCells(std::vector<Cell>&, const CellRange&, uint32_t item);
+    CellRange cellRange(const BBox&) const;
     std::size_t convertToXCellCoord(float x) const;
     std::size_t convertToYCellCoord(float y) const;
 
-    bool boxesCollide(const BBox&, const BBox&) const;
-    bool circlesCollide(const BCircle&, const BCircle&) const;
-    bool circleAndBoxCollide(const BCircle&, const BBox&) const;
+    static bool boxesCollide(const BBox&, float minX, float minY, float maxX, float maxY);
+    static bool circlesCollide(const BCircle&, float x, float y, float radius);
+    static bool circleAndBoxCollide(float x, float y, float radius, const BBox&);
 
     const float width;
     const float height;
@@ -95,11 +161,12 @@ private:
     const double xScale;
     const double yScale;
 
-    std::vector<std::pair<T, BBox>> boxElements;
-    std::vector<std::pair<T, BCircle>> circleElements;
+    Boxes boxes;
+    Circles circles;
 
-    std::vector<std::vector<size_t>> boxCells;
-    std::vector<std::vector<size_t>> circleCells;
+    std::vector<Cell> boxCells;
+    std::vector<Cell> circleCells;
+    std::vector<CellBlock> blocks;
 };
 
 template <class T>
@@ -118,46 +185,52 @@ GridIndex<T>::GridIndex(const float width_, const float height_, const uint32_t
 
 template <class T>
 void GridIndex<T>::insert(T&& t, const BBox& bbox) {
-    size_t uid = boxElements.size();
-
-    auto cx1 = convertToXCellCoord(bbox.min.x);
-    auto cy1 = convertToYCellCoord(bbox.min.y);
-    auto cx2 = convertToXCellCoord(bbox.max.x);
-    auto cy2 = convertToYCellCoord(bbox.max.y);
-
-    std::size_t x;
-    std::size_t y;
-    std::size_t cellIndex;
-    for (x = cx1; x <= cx2; ++x) {
-        for (y = cy1; y <= cy2; ++y) {
-            cellIndex = xCellCount * y + x;
-            boxCells[cellIndex].push_back(uid);
-        }
-    }
-
-    boxElements.emplace_back(t, bbox);
+    const auto uid = static_cast<uint32_t>(boxes.keys.size());
+    const auto range = cellRange(bbox);
+    addToCells(boxCells, range, uid);
+
+    boxes.keys.emplace_back(std::move(t));
+    boxes.minX.push_back(bbox.min.x);
+    boxes.minY.push_back(bbox.min.y);
+    boxes.maxX.push_back(bbox.max.x);
+    boxes.maxY.push_back(bbox.max.y);
+    boxes.cellX.push_back(static_cast<uint32_t>(range.x1));
+    boxes.cellY.push_back(static_cast<uint32_t>(range.y1));
 }
 
 template <class T>
 void GridIndex<T>::insert(T&& t, const BCircle& bcircle) {
-    size_t uid = circleElements.size();
-
-    auto cx1 = convertToXCellCoord(bcircle.center.x - bcircle.radius);
-    auto cy1 = convertToYCellCoord(bcircle.center.y - bcircle.radius);
-    auto cx2 = convertToXCellCoord(bcircle.center.x + bcircle.radius);
-    auto cy2 = convertToYCellCoord(bcircle.center.y + bcircle.radius);
-
-    std::size_t x;
-    std::size_t y;
-    std::size_t cellIndex;
-    for (x = cx1; x <= cx2; ++x) {
-        for (y = cy1; y <= cy2; ++y) {
-            cellIndex = xCellCount * y + x;
-            circleCells[cellIndex].push_back(uid);
+    const auto uid = static_cast<uint32_t>(circles.keys.size());
+    const auto range = cellRange(convertToBox(bcircle));
+    addToCells(circleCells, range, uid);
+
+    circles.keys.emplace_back(std::move(t));
+    circles.x.push_back(bcircle.center.x);
+    circles.y.push_back(bcircle.center.y);
+    circles.radius.push_back(bcircle.radius);
+    circles.cellX.push_back(static_cast<uint32_t>(range.x1));
+    circles.cellY.push_back(static_cast<uint32_t>(range.y1));
+}
+
+template <class T>
+void GridIndex<T>::addToCells(std::vector<Cell>& cells, const CellRange& range, const uint32_t item) {
+    for (std::size_t x = range.x1; x <= range.x2; ++x) {
+        for (std::size_t y = range.y1; y <= range.y2; ++y) {
+            Cell& cell = cells[xCellCount * y + x];
+            if (cell.last == noBlock || blocks[cell.last].count == blockCapacity) {
+                const auto block = static_cast<uint32_t>(blocks.size());
+                blocks.push_back({noBlock, 0, {}});
+                if (cell.last == noBlock) {
+                    cell.first = block;
+                } else {
+                    blocks[cell.last].next = block;
+                }
+                cell.last = block;
+            }
+            CellBlock& last = blocks[cell.last];
+            last.items[last.count++] = item;
         }
     }
-
-    circleElements.emplace_back(t, bcircle);
 }
 
 template <class T>
@@ -181,30 +254,35 @@ std::vector<std::pair<T, typename GridIndex<T>::BBox>> GridIndex<T>::queryWithBo
 }
 
 template <class T>
-bool GridIndex<T>::hitTest(const BBox& queryBBox, std::optional<std::function<bool(const T&)>> predicate) const {
+bool GridIndex<T>::hitTest(const BBox& queryBBox) const {
+    return hitTest(queryBBox, [](const T&) { return true; });
+}
+
+template <class T>
+bool GridIndex<T>::hitTest(const BCircle& queryBCircle) const {
+    return hitTest(queryBCircle, [](const T&) { return true; });
+}
+
+template <class T>
+template <typename Predicate>
+bool GridIndex<T>::hitTest(const BBox& queryBBox, Predicate&& predicate) const {
     bool hit = false;
     query(queryBBox, [&](const T& t, const BBox&) -> bool {
-        if (!predicate || (*predicate)(t)) {
-            hit = true;
-            return true;
-        } else {
-            return false;
-        }
+        hit = predicate(t);
+        return hit;
     });
     return hit;
 }
 
 template <class T>
-bool GridIndex<T>::hitTest(const BCircle& queryBCircle, std::optional<std::function<bool(const T&)>> predicate) const {
+template <typename Predicate>
+bool GridIndex<T>::hitTest(const BCircle& queryBCircle, Predicate&& predicate) const {
     bool hit = false;
-    query(queryBCircle, [&](const T& t, const BBox&) -> bool {
-        if (!predicate || (*predicate)(t)) {
-            hit = true;
-            return true;
-        } else {
-            return false;
-        }
-    });
+    auto resultFn = [&](const T& t, const BBox&) -> bool {
+        hit = predicate(t);
+        return hit;
+    };
+    query(queryBCircle, resultFn);
     return hit;
 }
 
@@ -219,141 +297,148 @@ bool GridIndex<T>::completeIntersection(const BBox& queryBBox) const {
 }
 
 template <class T>
-typename GridIndex<T>::BBox GridIndex<T>::convertToBox(const BCircle& circle) const {
+typename GridIndex<T>::BBox GridIndex<T>::convertToBox(const BCircle& circle) {
     return BBox{{circle.center.x - circle.radius, circle.center.y - circle.radius},
                 {circle.center.x + circle.radius, circle.center.y + circle.radius}};
 }
 
 template <class T>
-void GridIndex<T>::query(const BBox& queryBBox, std::function<bool(const T&, const BBox&)> resultFn) const {
-    std::unordered_set<size_t> seenBoxes;
-    std::unordered_set<size_t> seenCircles;
+typename GridIndex<T>::BBox GridIndex<T>::boxAt(const std::size_t i) const {
+    return BBox{{boxes.minX[i], boxes.minY[i]}, {boxes.maxX[i], boxes.maxY[i]}};
+}
 
-    if (noIntersection(queryBBox)) {
-        return;
-    } else if (completeIntersection(queryBBox)) {
-        for (auto& element : boxElements) {
-            if (resultFn(element.first, element.second)) {
-                return;
-            }
+template <class T>
+typename GridIndex<T>::BBox GridIndex<T>::circleBox(const std::size_t i) const {
+    return BBox{{circles.x[i] - circles.radius[i], circles.y[i] - circles.radius[i]},
+                {circles.x[i] + circles.radius[i], circles.y[i] + circles.radius[i]}};
+}
+
+template <class T>
+template <typename ResultFn>
+bool GridIndex<T>::forEach(ResultFn& resultFn) const {
+    for (std::size_t i = 0; i < boxes.keys.size(); ++i) {
+        if (resultFn(boxes.keys[i], boxAt(i))) {
+            return true;
         }
-        for (auto& element : circleElements) {
-            if (resultFn(element.first, convertToBox(element.second))) {
-                return;
-            }
+    }
+    for (std::size_t i = 0; i < circles.keys.size(); ++i) {
+        if (resultFn(circles.keys[i], circleBox(i))) {
+            return true;
         }
-        return;
     }
+    return false;
+}
 
-    auto cx1 = convertToXCellCoord(queryBBox.min.x);
-    auto cy1 = convertToYCellCoord(queryBBox.min.y);
-    auto cx2 = convertToXCellCoord(queryBBox.max.x);
-    auto cy2 = convertToYCellCoord(queryBBox.max.y);
-
-    std::size_t x;
-    std::size_t y;
-    std::size_t cellIndex;
-    for (x = cx1; x <= cx2; ++x) {
-        for (y = cy1; y <= cy2; ++y) {
-            cellIndex = xCellCount * y + x;
-            // Look up other boxes
-            for (auto uid : boxCells[cellIndex]) {
-                if (seenBoxes.count(uid) == 0) {
-                    seenBoxes.insert(uid);
-
-                    auto& pair = boxElements.at(uid);
-                    auto& bbox = pair.second;
-                    if (boxesCollide(queryBBox, bbox)) {
-                        if (resultFn(pair.first, bbox)) {
-                            return;
-                        }
-                    }
-                }
-            }
-
-            // Look up circles
-            for (auto uid : circleCells[cellIndex]) {
-                if (seenCircles.count(uid) == 0) {
-                    seenCircles.insert(uid);
-
-                    auto& pair = circleElements.at(uid);
-                    auto& bcircle = pair.second;
-                    if (circleAndBoxCollide(bcircle, queryBBox)) {
-                        if (resultFn(pair.first, convertToBox(bcircle))) {
-                            return;
-                        }
-                    }
-                }
+template <class T>
+template <typename Collides, typename ResultFn>
+bool GridIndex<T>::forEachInCell(const std::vector<Cell>& cells,
+                                 const std::vector<uint32_t>& cellX,
+                                 const std::vector<uint32_t>& cellY,
+                                 const CellRange& range,
+                                 const std::size_t x,
+                                 const std::size_t y,
+                                 Collides& collides,
+                                 ResultFn& resultFn) const {
+    for (uint32_t b = cells[xCellCount * y + x].first; b != noBlock; b = blocks[b].next) {
+        const CellBlock& block = blocks[b];
+        // Test the whole block before reporting, keeping the loop free of calls
+        std::array<bool, blockCapacity> hits;
+        for (std::size_t i = 0; i < block.count; ++i) {
+            const uint32_t uid = block.items[i];
+            // Only report items from the first of their cells within the query range
+            const bool firstCell = std::max<std::size_t>(cellX[uid], range.x1) == x &&
+                                   std::max<std::size_t>(cellY[uid], range.y1) == y;
+            hits[i] = firstCell && collides(uid);
+        }
+        for (std::size_t i = 0; i < block.count; ++i) {
+            if (hits[i] && resultFn(block.items[i])) {
+                return true;
             }
         }
     }
+    return false;
 }
 
 template <class T>
-void GridIndex<T>::query(const BCircle& queryBCircle, std::function<bool(const T&, const BBox&)> resultFn) const {
-    std::unordered_set<size_t> seenBoxes;
-    std::unordered_set<size_t> seenCircles;
-
-    BBox queryBBox = convertToBox(queryBCircle);
+template <typename ResultFn>
+void GridIndex<T>::query(const BBox& queryBBox, ResultFn&& resultFn) const {
     if (noIntersection(queryBBox)) {
         return;
     } else if (completeIntersection(queryBBox)) {
-        for (auto& element : boxElements) {
-            if (resultFn(element.first, element.second)) {
-                return;
-            }
-        }
-        for (auto& element : circleElements) {
-            if (resultFn(element.first, convertToBox(element.second))) {
+        forEach(resultFn);
+        return;
+    }
+
+    const auto range = cellRange(queryBBox);
+    auto boxCollides = [&](uint32_t uid) {
+        return boxesCollide(queryBBox, boxes.minX[uid], boxes.minY[uid], boxes.maxX[uid], boxes.maxY[uid]);
+    };
+    auto boxResult = [&](uint32_t uid) {
+        return resultFn(boxes.keys[uid], boxAt(uid));
+    };
+    auto circleCollides = [&](uint32_t uid) {
+        return circleAndBoxCollide(circles.x[uid], circles.y[uid], circles.radius[uid], queryBBox);
+    };
+    auto circleResult = [&](uint32_t uid) {
+        return resultFn(circles.keys[uid], circleBox(uid));
+    };
+
+    for (std::size_t x = range.x1; x <= range.x2; ++x) {
+        for (std::size_t y = range.y1; y <= range.y2; ++y) {
+            if (forEachInCell(boxCells, boxes.cellX, boxes.cellY, range, x, y, boxCollides, boxResult) ||
+                forEachInCell(circleCells, circles.cellX, circles.cellY, range, x, y, circleCollides, circleResult)) {
                 return;
             }
         }
     }
+}
 
-    auto cx1 = convertToXCellCoord(queryBCircle.center.x - queryBCircle.radius);
-    auto cy1 = convertToYCellCoord(queryBCircle.center.y - queryBCircle.radius);
-    auto cx2 = convertToXCellCoord(queryBCircle.center.x + queryBCircle.radius);
-    auto cy2 = convertToYCellCoord(queryBCircle.center.y + queryBCircle.radius);
-
-    std::size_t x;
-    std::size_t y;
-    std::size_t cellIndex;
-    for (x = cx1; x <= cx2; ++x) {
-        for (y = cy1; y <= cy2; ++y) {
-            cellIndex = xCellCount * y + x;
-            // Look up boxes
-            for (auto uid : boxCells[cellIndex]) {
-                if (seenBoxes.count(uid) == 0) {
-                    seenBoxes.insert(uid);
-
-                    auto& pair = boxElements.at(uid);
-                    auto& bbox = pair.second;
-                    if (circleAndBoxCollide(queryBCircle, bbox)) {
-                        if (resultFn(pair.first, bbox)) {
-                            return;
-                        }
-                    }
-                }
-            }
+template <class T>
+template <typename ResultFn>
+void GridIndex<T>::query(const BCircle& queryBCircle, ResultFn& resultFn) const {
+    const BBox queryBBox = convertToBox(queryBCircle);
+    if (noIntersection(queryBBox)) {
+        return;
+    } else if (completeIntersection(queryBBox)) {
+        forEach(resultFn);
+        return;
+    }
 
-            // Look up other circles
-            for (auto uid : circleCells[cellIndex]) {
-                if (seenCircles.count(uid) == 0) {
-                    seenCircles.insert(uid);
-
-                    auto& pair = circleElements.at(uid);
-                    auto& bcircle = pair.second;
-                    if (circlesCollide(queryBCircle, bcircle)) {
-                        if (resultFn(pair.first, convertToBox(bcircle))) {
-                            return;
-                        }
-                    }
-                }
+    const auto range = cellRange(queryBBox);
+    auto boxCollides = [&](uint32_t uid) {
+        return circleAndBoxCollide(queryBCircle.center.x,
+                                   queryBCircle.center.y,
+                                   queryBCircle.radius,
+                                   BBox{{boxes.minX[uid], boxes.minY[uid]}, {boxes.maxX[uid], boxes.maxY[uid]}});
+    };
+    auto boxResult = [&](uint32_t uid) {
+        return resultFn(boxes.keys[uid], boxAt(uid));
+    };
+    auto circleCollides = [&](uint32_t uid) {
+        return circlesCollide(queryBCircle, circles.x[uid], circles.y[uid], circles.radius[uid]);
+    };
+    auto circleResult = [&](uint32_t uid) {
+        return resultFn(circles.keys[uid], circleBox(uid));
+    };
+
+    for (std::size_t x = range.x1; x <= range.x2; ++x) {
+        for (std::size_t y = range.y1; y <= range.y2; ++y) {
+            if (forEachInCell(boxCells, boxes.cellX, boxes.cellY, range, x, y, boxCollides, boxResult) ||
+                forEachInCell(circleCells, circles.cellX, circles.cellY, range, x, y, circleCollides, circleResult)) {
+                return;
             }
         }
     }
 }
 
+template <class T>
+typename GridIndex<T>::CellRange GridIndex<T>::cellRange(const BBox& bbox) const {
+    return {convertToXCellCoord(bbox.min.x),
+            convertToYCellCoord(bbox.min.y),
+            convertToXCellCoord(bbox.max.x),
+            convertToYCellCoord(bbox.max.y)};
+}
+
 template <class T>
 std::size_t GridIndex<T>::convertToXCellCoord(const float x) const {
     return static_cast<size_t>(util::max(0.0, util::min(xCellCount - 1.0, std::floor(x * xScale))));
@@ -365,30 +450,30 @@ std::size_t GridIndex<T>::convertToYCellCoord(const float y) const {
 }
 
 template <class T>
-bool GridIndex<T>::boxesCollide(const BBox& first, const BBox& second) const {
-    return first.min.x <= second.max.x && first.min.y <= second.max.y && first.max.x >= second.min.x &&
-           first.max.y >= second.min.y;
+bool GridIndex<T>::boxesCollide(const BBox& first, float minX, float minY, float maxX, float maxY) {
+    // Non-short-circuiting so the comparisons compile to straight-line code
+    return (first.min.x <= maxX) & (first.min.y <= maxY) & (first.max.x >= minX) & (first.max.y >= minY);
 }
 
 template <class T>
-bool GridIndex<T>::circlesCollide(const BCircle& first, const BCircle& second) const {
-    auto dx = second.center.x - first.center.x;
-    auto dy = second.center.y - first.center.y;
-    auto bothRadii = first.radius + second.radius;
+bool GridIndex<T>::circlesCollide(const BCircle& first, float x, float y, float radius) {
+    auto dx = x - first.center.x;
+    auto dy = y - first.center.y;
+    auto bothRadii = first.radius + radius;
     return (bothRadii * bothRadii) > (dx * dx + dy * dy);
 }
 
 template <class T>
-bool GridIndex<T>::circleAndBoxCollide(const BCircle& circle, const BBox& box) const {
+bool GridIndex<T>::circleAndBoxCollide(float x, float y, float radius, const BBox& box) {
     auto halfRectWidth = (box.max.x - box.min.x) / 2;
-    auto distX = std::abs(circle.center.x - (box.min.x + halfRectWidth));
-    if (distX > (halfRectWidth + circle.radius)) {
+    auto distX = std::abs(x - (box.min.x + halfRectWidth));
+    if (distX > (halfRectWidth + radius)) {
         return false;
     }
 
     auto halfRectHeight = (box.max.y - box.min.y) / 2;
-    auto distY = std::abs(circle.center.y - (box.min.y + halfRectHeight));
-    if (distY > (halfRectHeight + circle.radius)) {
+    auto distY = std::abs(y - (box.min.y + halfRectHeight));
+    if (distY > (halfRectHeight + radius)) {
         return false;
     }
 
@@ -398,12 +483,12 @@ bool GridIndex<T>::circleAndBoxCollide(const BCircle& circle, const BBox& box) c
 
     auto dx = distX - halfRectWidth;
     auto dy = distY - halfRectHeight;
-    return (dx * dx + dy * dy) <= (circle.radius * circle.radius);
+    return (dx * dx + dy * dy) <= (radius * radius);
 }
 
 template <class T>
 bool GridIndex<T>::empty() const {
-    return boxElements.empty() && circleElements.empty();
+    return boxes.keys.empty() && circles.keys.empty();
 }
 
 } // namespace mbgl
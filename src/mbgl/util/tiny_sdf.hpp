@@ -2,6 +2,8 @@
 
 #include <mbgl/util/image.hpp>
 
+#include <vector>
+
 namespace mbgl {
 namespace util {
 
@@ -17,5 +19,28 @@ namespace util {
 */
 AlphaImage transformRasterToSDF(const AlphaImage& rasterInput, double radius, double cutoff);
 
+/*
+    Same transform as transformRasterToSDF, keeping its scratch buffers
+    between calls so that transforming many glyphs does not allocate for each
+    of them. An instance must not be used from several threads at once.
+*/
+class TinySDF {
+public:
+    AlphaImage transform(const AlphaImage& rasterInput, double radius, double cutoff);
+
+private:
+    void edt(std::vector<double>& data, uint32_t width, uint32_t height);
+    void edt1d(uint32_t n);
+
+    std::vector<double> gridOuter;
+    std::vector<double> gridInner;
+    std::vector<double> f;
+    std::vector<double> d;
+    std::vector<double> z;
+    // f[v[k]] + v[k]^2 of each parabola of the lower envelope
+    std::vector<double> h;
+    std::vector<uint32_t> v;
+};
+
 } // namespace util
 } // namespace mbgl
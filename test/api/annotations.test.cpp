@@ -201,6 +201,21 @@ TEST(Annotations, UpdateSymbolAnnotationGeometry) {
     test.checkRendering("update_point");
 }
 
+TEST(Annotations, UpdateSymbolAnnotations) {
+    AnnotationTest test;
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+    test.map.addAnnotationImage(namedMarker("default_marker"));
+    AnnotationID left = test.map.addAnnotation(SymbolAnnotation{Point<double>{-10, 0}, "default_marker"});
+    AnnotationID right = test.map.addAnnotation(SymbolAnnotation{Point<double>{20, 0}, "default_marker"});
+
+    test.frontend.render(test.map);
+
+    test.map.updateAnnotations({{left, SymbolAnnotation{Point<double>{-10, 0}, "default_marker"}},
+                                {right, SymbolAnnotation{Point<double>{10, 0}, "default_marker"}}});
+    test.checkRendering("add_multiple");
+}
+
 TEST(Annotations, UpdateSymbolAnnotationIcon) {
     AnnotationTest test;
 
@@ -14,6 +14,8 @@
 
 #include <mbgl/map/mode.hpp>
 
+#include <limits>
+
 namespace mbgl {
 
 template <class Attributes>
@@ -99,6 +101,56 @@ TEST(Buckets, FillBucket) {
     ASSERT_FALSE(bucket.needsUpload());
 }
 
+TEST(Buckets, FillBucketLargePolygon) {
+    FillBucket::PossiblyEvaluatedLayoutProperties layout;
+    FillBucket bucket{layout, {}, 5.0f, 1};
+
+    // A jagged square with more vertices than a segment can index
+    constexpr int16_t side = 20000;
+    GeometryCoordinates ring{{0, 0}};
+    for (int16_t i = 2; i < side - 1; ++i) ring.emplace_back(i, i % 2);
+    ring.emplace_back(side, 0);
+    for (int16_t i = 2; i < side - 1; ++i) ring.emplace_back(side - i % 2, i);
+    ring.emplace_back(side, side);
+    for (int16_t i = 2; i < side - 1; ++i) ring.emplace_back(side - i, side - i % 2);
+    ring.emplace_back(0, side);
+    for (int16_t i = 2; i < side - 1; ++i) ring.emplace_back(i % 2, side - i);
+    GeometryCollection polygon{ring};
+    GeometryCollection square{{{0, 0}, {0, 10}, {10, 10}, {10, 0}, {0, 0}}};
+
+    for (const auto& geometry : {polygon, square}) {
+        bucket.addFeature(StubGeometryTileFeature{{}, FeatureType::Polygon, geometry, properties},
+                          geometry,
+                          {},
+                          PatternLayerMap(),
+                          0,
+                          CanonicalTileID(0, 0, 0));
+    }
+    ASSERT_TRUE(bucket.hasData());
+
+    // Each segment indexes its own vertices only
+    const auto checkSegments = [&](const auto& segments, const auto& indexes) {
+        std::size_t indexLength = 0;
+        for (const auto& segment : segments) {
+            EXPECT_LE(segment.vertexLength, std::numeric_limits<uint16_t>::max());
+            EXPECT_LE(segment.vertexOffset + segment.vertexLength, bucket.vertices.elements());
+            EXPECT_EQ(indexLength, segment.indexOffset);
+            for (std::size_t i = segment.indexOffset; i < segment.indexOffset + segment.indexLength; ++i) {
+                ASSERT_LT(indexes.at(i), segment.vertexLength);
+            }
+            indexLength += segment.indexLength;
+        }
+        EXPECT_EQ(indexes.elements(), indexLength);
+        return segments.size();
+    };
+    EXPECT_LT(1u, checkSegments(bucket.triangleSegments, bucket.triangles));
+    EXPECT_LT(1u, checkSegments(bucket.lineSegments, bucket.lines));
+    // Every edge of the outline is kept
+    EXPECT_EQ(2 * (ring.size() + square[0].size()), bucket.lines.elements());
+    // The outline of the square starts a segment after the copied vertices
+    EXPECT_EQ(5u, bucket.lineSegments.back().vertexLength);
+}
+
 TEST(Buckets, LineBucket) {
     gl::HeadlessBackend backend({512, 256});
     gfx::BackendScope scope{backend};
@@ -0,0 +1,141 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/context.hpp>
+
+#if MLN_DRAWABLE_RENDERER
+
+#include <mbgl/gl/uniform_buffer_gl.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(GLUniformBuffer, Suballocation) {
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+
+    gl::UniformBufferAllocator allocator;
+    const auto alignment = allocator.getAlignment();
+    EXPECT_GE(alignment, 16u);
+
+    // Small buffers share a buffer object, at aligned offsets
+    std::vector<gl::UniformBufferAllocator::Range> ranges;
+    for (const std::size_t size : {16u, 20u, 64u, 100u}) {
+        const auto range = allocator.allocate(size);
+        ASSERT_TRUE(range);
+        EXPECT_EQ(0u, range->chunk);
+        EXPECT_EQ(0u, range->offset % alignment);
+        EXPECT_EQ(size, range->size);
+        if (!ranges.empty()) {
+            EXPECT_GE(range->offset, ranges.back().offset + ranges.back().size);
+        }
+        ranges.push_back(*range);
+    }
+    EXPECT_EQ(1u, allocator.getBufferCount());
+
+    // Large ones are left to dedicated buffers
+    EXPECT_FALSE(allocator.allocate(64 * 1024));
+    EXPECT_FALSE(allocator.allocate(0));
+
+    // Released ranges are reused for buffers of the same aligned size
+    allocator.release(ranges[2]);
+    const auto reused = allocator.allocate(64);
+    ASSERT_TRUE(reused);
+    EXPECT_EQ(ranges[2].offset, reused->offset);
+}
+
+TEST(GLUniformBuffer, ReleaseChunks) {
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+
+    gl::UniformBufferAllocator allocator;
+
+    // Fill more than one buffer object
+    std::vector<gl::UniformBufferAllocator::Range> ranges;
+    while (ranges.empty() || ranges.back().chunk < 2) {
+        ranges.push_back(*allocator.allocate(4096));
+    }
+    EXPECT_EQ(3u, allocator.getBufferCount());
+
+    // Emptying a buffer object other than the one in use deletes it
+    for (const auto& range : ranges) {
+        if (range.chunk == 0) {
+            allocator.release(range);
+        }
+    }
+    EXPECT_EQ(2u, allocator.getBufferCount());
+
+    // The one in use is kept and started over
+    for (const auto& range : ranges) {
+        if (range.chunk == 2) {
+            allocator.release(range);
+        }
+    }
+    EXPECT_EQ(2u, allocator.getBufferCount());
+    const auto range = allocator.allocate(4096);
+    ASSERT_TRUE(range);
+    EXPECT_EQ(2u, range->chunk);
+    EXPECT_EQ(0u, range->offset);
+}
+
+TEST(GLUniformBuffer, ScatteredWrites) {
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+
+    gl::UniformBufferAllocator allocator;
+
+    std::vector<gl::UniformBufferAllocator::Range> ranges;
+    for (std::size_t i = 0; i < 32; ++i) {
+        ranges.push_back(*allocator.allocate(4096));
+    }
+    allocator.bind(ranges.front(), 0);
+    EXPECT_EQ(0u, allocator.getDirtyRangeCount(0));
+
+    // Unchanged contents are not uploaded again
+    const std::vector<uint8_t> zeros(4096, 0);
+    EXPECT_FALSE(allocator.write(ranges[3], zeros.data(), zeros.size()));
+    EXPECT_EQ(0u, allocator.getDirtyRangeCount(0));
+
+    // Writes far apart are kept as separate ranges, rather than one span over the chunk
+    const std::vector<uint8_t> ones(4096, 1);
+    EXPECT_TRUE(allocator.write(ranges[3], ones.data(), ones.size()));
+    EXPECT_TRUE(allocator.write(ranges[30], ones.data(), ones.size()));
+    EXPECT_EQ(2u, allocator.getDirtyRangeCount(0));
+
+    // Neighbouring writes are merged
+    EXPECT_TRUE(allocator.write(ranges[4], ones.data(), ones.size()));
+    EXPECT_EQ(2u, allocator.getDirtyRangeCount(0));
+
+    // Past a few ranges, they are uploaded as one
+    for (std::size_t i = 6; i < 30; i += 2) {
+        allocator.write(ranges[i], ones.data(), ones.size());
+    }
+    EXPECT_EQ(1u, allocator.getDirtyRangeCount(0));
+
+    allocator.bind(ranges.front(), 0);
+    EXPECT_EQ(0u, allocator.getDirtyRangeCount(0));
+}
+
+TEST(GLUniformBuffer, OutlivesContext) {
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+
+    gfx::UniformBufferPtr buffer;
+    {
+        gl::Context context{backend};
+        const std::array<float, 4> data{1, 2, 3, 4};
+        buffer = context.createUniformBuffer(data.data(), sizeof(data));
+        buffer->update(data.data(), sizeof(data));
+    }
+
+    // Updating and releasing a buffer after its context is gone is harmless
+    const std::array<float, 4> data{4, 3, 2, 1};
+    buffer->update(data.data(), sizeof(data));
+    buffer.reset();
+}
+
+#endif
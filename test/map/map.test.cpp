@@ -36,6 +36,8 @@
 #include <mbgl/util/run_loop.hpp>
 
 #include <atomic>
+#include <map>
+#include <set>
 
 using namespace mbgl;
 using namespace mbgl::style;
@@ -1032,6 +1034,184 @@ TEST(Map, Issue15342) {
     test.runLoop.run();
 }
 
+TEST(Map, PlacementBudget) {
+    struct Result {
+        std::size_t placements = 0;
+        std::size_t placementFrames = 0;
+        std::map<std::string, std::set<std::string>> placed;
+    };
+
+    const auto place = [](std::optional<Duration> budget) {
+        MapTest<> test{1, MapMode::Continuous};
+        if (budget) {
+            test.frontend.getRenderer()->setPlacementBudget(*budget);
+        }
+
+        // The icons at [0, 0] and [5, 0] collide at this zoom level
+        test.map.getStyle().loadJSON(R"STYLE({
+          "version": 8,
+          "sources": {
+            "points": {
+              "type": "geojson",
+              "data": {
+                "type": "FeatureCollection",
+                "features": [
+                  { "type": "Feature", "properties": { "name": "a" }, "geometry": { "type": "Point", "coordinates": [0, 0] } },
+                  { "type": "Feature", "properties": { "name": "b" }, "geometry": { "type": "Point", "coordinates": [5, 0] } },
+                  { "type": "Feature", "properties": { "name": "c" }, "geometry": { "type": "Point", "coordinates": [40, 40] } }
+                ]
+              }
+            }
+          },
+          "layers": [{
+            "id": "first",
+            "type": "symbol",
+            "source": "points",
+            "layout": { "icon-image": "marker" }
+          }, {
+            "id": "second",
+            "type": "symbol",
+            "source": "points",
+            "layout": { "icon-image": "marker", "icon-allow-overlap": true, "icon-ignore-placement": true }
+          }]
+        })STYLE");
+        test.map.getStyle().addImage(std::make_unique<style::Image>("marker", PremultipliedImage({16, 16}), 1.0f));
+
+        Result result;
+        test.observer.didFinishRenderingFrameCallback = [&](MapObserver::RenderFrameStatus status) {
+            result.placements += status.placementChanged ? 1 : 0;
+            result.placementFrames += test.frontend.getRenderer()->getFrameTimings().placement > 0.0 ? 1 : 0;
+        };
+        test.observer.didBecomeIdleCallback = [&] {
+            test.runLoop.stop();
+        };
+        test.runLoop.run();
+
+        const auto size = test.frontend.getSize();
+        const ScreenBox screen{{0, 0}, {static_cast<double>(size.width), static_cast<double>(size.height)}};
+        for (const std::string layer : {"first", "second"}) {
+            for (const auto& feature : test.frontend.getRenderer()->queryRenderedFeatures(screen, {{{layer}}, {}})) {
+                result.placed[layer].insert(feature.properties.at("name").get<std::string>());
+            }
+        }
+        return result;
+    };
+
+    // Each frame places a single bucket, spreading placements over several
+    // frames
+    auto budgeted = place(Duration::zero());
+    EXPECT_GT(budgeted.placements, 0u);
+    EXPECT_GT(budgeted.placementFrames, budgeted.placements);
+    EXPECT_EQ(2u, budgeted.placed["first"].size());
+    EXPECT_EQ(3u, budgeted.placed["second"].size());
+
+    // The result is the same as placing everything at once
+    const auto unbudgeted = place(std::nullopt);
+    EXPECT_EQ(unbudgeted.placed, budgeted.placed);
+}
+
+TEST(Map, BackgroundPlacement) {
+    MapTest<> test{1, MapMode::Continuous};
+
+    test.map.getStyle().loadJSON(R"STYLE({
+      "version": 8,
+      "sources": {
+        "points": {
+          "type": "geojson",
+          "data": {
+            "type": "FeatureCollection",
+            "features": [
+              { "type": "Feature", "properties": {}, "geometry": { "type": "Point", "coordinates": [0, 0] } },
+              { "type": "Feature", "properties": {}, "geometry": { "type": "Point", "coordinates": [10, 10] } }
+            ]
+          }
+        }
+      },
+      "layers": [{
+        "id": "first",
+        "type": "symbol",
+        "source": "points",
+        "layout": { "icon-image": "marker", "icon-allow-overlap": true }
+      }, {
+        "id": "second",
+        "type": "symbol",
+        "source": "points",
+        "layout": { "icon-image": "marker", "icon-allow-overlap": true }
+      }]
+    })STYLE");
+    test.map.getStyle().addImage(std::make_unique<style::Image>("marker", PremultipliedImage({16, 16}), 1.0f));
+
+    // Each placement runs while the frame that started it is prepared and
+    // uploaded. Rotating the map makes that frame, and the ones after it,
+    // update and re-sort the symbol buckets being placed.
+    std::size_t frames = 0;
+    std::size_t placements = 0;
+    test.observer.didFinishRenderingFrameCallback = [&](MapObserver::RenderFrameStatus status) {
+        if (status.placementChanged) {
+            ++placements;
+        }
+        if (++frames < 30) {
+            test.map.jumpTo(CameraOptions().withBearing(frames * 15.0));
+        }
+    };
+    test.observer.didBecomeIdleCallback = [&] {
+        test.runLoop.stop();
+    };
+
+    test.runLoop.run();
+    EXPECT_GT(placements, 0u);
+    const auto center = test.map.pixelForLatLng({0, 0});
+    EXPECT_EQ(1u, test.frontend.getRenderer()->queryRenderedFeatures(center, {{{"first"}}, {}}).size());
+    EXPECT_EQ(1u, test.frontend.getRenderer()->queryRenderedFeatures(center, {{{"second"}}, {}}).size());
+}
+
+TEST(Map, FrameTimings) {
+    MapTest<> test;
+
+    test.map.getStyle().loadJSON(R"STYLE({
+      "version": 8,
+      "sources": {
+        "shapes": {
+          "type": "geojson",
+          "data": { "type": "Polygon", "coordinates": [[[-10, -10], [10, -10], [10, 10], [-10, 10], [-10, -10]]] }
+        }
+      },
+      "layers": [{
+        "id": "background",
+        "type": "background",
+        "paint": { "background-color": "white" }
+      }, {
+        "id": "fill",
+        "type": "fill",
+        "source": "shapes",
+        "paint": { "fill-color": "red" }
+      }, {
+        "id": "line",
+        "type": "line",
+        "source": "shapes"
+      }]
+    })STYLE");
+
+    for (int frame = 0; frame < 2; ++frame) {
+        const auto timings = test.frontend.render(test.map).timings;
+        EXPECT_GT(timings.createRenderTree, 0.0);
+        EXPECT_LE(timings.placement, timings.createRenderTree);
+        EXPECT_GT(timings.encoding, 0.0);
+        EXPECT_DOUBLE_EQ(timings.createRenderTree + timings.upload + timings.tweakers + timings.encoding,
+                         timings.total());
+
+        // Every layer is reported once, bottom to top
+        std::vector<std::string> ids;
+        double layers = 0.0;
+        for (const auto& layer : timings.layers) {
+            ids.push_back(layer.id);
+            layers += layer.encoding;
+        }
+        EXPECT_EQ((std::vector<std::string>{"background", "fill", "line"}), ids);
+        EXPECT_LE(layers, timings.encoding);
+    }
+}
+
 TEST(Map, UniversalStyleGetter) {
     MapTest<> test;
 
@@ -0,0 +1,78 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/programs/attributes.hpp>
+#include <mbgl/renderer/paint_property_binder.hpp>
+#include <mbgl/style/expression/dsl.hpp>
+
+#include <algorithm>
+
+using namespace mbgl;
+using namespace mbgl::style::expression::dsl;
+
+namespace {
+
+class StubGeometryTileLayer : public GeometryTileLayer {
+public:
+    explicit StubGeometryTileLayer(std::vector<StubGeometryTileFeature> features_)
+        : features(std::move(features_)) {}
+
+    std::size_t featureCount() const override { return features.size(); }
+
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
+        return std::make_unique<StubGeometryTileFeature>(features.at(i));
+    }
+
+    std::string getName() const override { return "layer"; }
+
+private:
+    std::vector<StubGeometryTileFeature> features;
+};
+
+} // namespace
+
+TEST(PaintPropertyBinder, FeatureStateDirtyRanges) {
+    SourceFunctionPaintPropertyBinder<float, attributes::radius> binder(
+        style::PropertyExpression<float>(createExpression(R"(["number", ["feature-state", "size"], 1])")), 1.0f);
+
+    // Four features of ten vertices each
+    std::vector<StubGeometryTileFeature> features;
+    for (const char* id : {"a", "b", "c", "d"}) {
+        features.emplace_back(std::string(id), FeatureType::Point, GeometryCollection(), PropertyMap());
+        const std::size_t index = features.size() - 1;
+        binder.populateVertexVector(features.back(), 10 * (index + 1), index, {}, {}, CanonicalTileID(0, 0, 0), {});
+    }
+    const StubGeometryTileLayer layer(features);
+
+    const auto vertices = binder.getSharedVertexVector();
+    ASSERT_EQ(40u, vertices->getRawCount());
+    EXPECT_TRUE(vertices->getDirty());
+    EXPECT_TRUE(vertices->getDirtyRanges().empty());
+
+    // Uploaded
+    vertices->setDirty(false);
+
+    binder.updateVertexVectors({{"b", {{"size", 4.0}}}}, layer, {});
+    EXPECT_TRUE(vertices->getDirty());
+    using Ranges = std::vector<std::pair<std::size_t, std::size_t>>;
+    EXPECT_EQ((Ranges{{10, 20}}), vertices->getDirtyRanges());
+    EXPECT_EQ(1.0f, std::get<0>(binder.getVertexValue(9)).a1[0]);
+    EXPECT_EQ(4.0f, std::get<0>(binder.getVertexValue(10)).a1[0]);
+    EXPECT_EQ(4.0f, std::get<0>(binder.getVertexValue(19)).a1[0]);
+
+    // Neighbouring ranges are merged
+    binder.updateVertexVectors({{"c", {{"size", 2.0}}}}, layer, {});
+    EXPECT_EQ((Ranges{{10, 30}}), vertices->getDirtyRanges());
+
+    vertices->setDirty(false);
+    binder.updateVertexVectors({{"a", {{"size", 2.0}}}, {"d", {{"size", 3.0}}}}, layer, {});
+    auto ranges = vertices->getDirtyRanges();
+    std::sort(ranges.begin(), ranges.end());
+    EXPECT_EQ((Ranges{{0, 10}, {30, 40}}), ranges);
+
+    // Once the whole vector is dirty, it is uploaded whole
+    vertices->setDirty();
+    binder.updateVertexVectors({{"b", {{"size", 5.0}}}}, layer, {});
+    EXPECT_TRUE(vertices->getDirty());
+    EXPECT_TRUE(vertices->getDirtyRanges().empty());
+}
@@ -206,6 +206,47 @@ TEST(ShaderRegistry, NamedReplace) {
     ASSERT_NE(progA, progB);
 }
 
+// Shaders registered with a factory are only constructed on first use
+TEST(ShaderRegistry, DeferredShader) {
+    gfx::ShaderRegistry registry;
+
+    int created = 0;
+    ASSERT_TRUE(registry.getLegacyGroup().registerShaderFactory(
+        [&]() -> std::shared_ptr<gfx::Shader> {
+            ++created;
+            return std::make_shared<StubProgram_1>();
+        },
+        std::string{StubProgram_1::Name}));
+    // Conflicting names are rejected for both factories and instances
+    ASSERT_FALSE(registry.getLegacyGroup().registerShaderFactory(
+        []() -> std::shared_ptr<gfx::Shader> { return std::make_shared<StubProgram_1>(); },
+        std::string{StubProgram_1::Name}));
+    ASSERT_FALSE(registry.getLegacyGroup().registerShader(std::make_shared<StubProgram_1>()));
+
+    ASSERT_TRUE(registry.getLegacyGroup().isShader(std::string{StubProgram_1::Name}));
+    ASSERT_TRUE(registry.getLegacyGroup().isShaderPending(std::string{StubProgram_1::Name}));
+    ASSERT_EQ(created, 0);
+
+    StubShaderConsumer consumer;
+    ASSERT_EQ(consumer.useShader<StubProgram_1>(registry), 10);
+    ASSERT_EQ(consumer.useShader<StubProgram_1>(registry), 10);
+    ASSERT_EQ(created, 1);
+    ASSERT_FALSE(registry.getLegacyGroup().isShaderPending(std::string{StubProgram_1::Name}));
+
+    // Replacing a pending shader drops its factory
+    ASSERT_TRUE(registry.getLegacyGroup().registerShaderFactory(
+        [&]() -> std::shared_ptr<gfx::Shader> {
+            ++created;
+            return std::make_shared<StubProgram_1>();
+        },
+        "Pending"));
+    auto program = std::make_shared<StubProgram_1>();
+    program->setToken(30);
+    ASSERT_TRUE(registry.getLegacyGroup().replaceShader(program, "Pending"));
+    ASSERT_EQ(registry.getLegacyGroup().get<StubProgram_1>("Pending"), program);
+    ASSERT_EQ(created, 1);
+}
+
 // Test replacing an actual program instance with a similar instance
 TEST(ShaderRegistry, GLSLReplacement_NoOp) {
     MapInstance::ShaderAndStyleObserver observer;
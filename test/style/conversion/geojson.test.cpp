@@ -0,0 +1,79 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/style/conversion/geojson.hpp>
+#include <mbgl/style/conversion/json.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style::conversion;
+
+TEST(GeoJSON, ParseMatchesConversion) {
+    const std::string json = R"JSON({
+        "features": [{
+            "id": 1,
+            "properties": {"name": "a", "rank": -2, "area": 1.5, "tags": [true, null, {"b": "c"}]},
+            "geometry": {"coordinates": [[[0, 0], [10, 0], [10, 10], [0, 0]]], "type": "Polygon"},
+            "type": "Feature"
+        }, {
+            "type": "Feature",
+            "id": "b",
+            "bbox": [0, 0, 1, 1],
+            "geometry": {"type": "GeometryCollection", "geometries": [
+                {"type": "Point", "coordinates": [1, 2, 3]},
+                {"type": "MultiLineString", "coordinates": [[[1, 2], [3, 4]], []]}
+            ]},
+            "properties": null
+        }, {
+            "type": "Feature",
+            "geometry": null,
+            "properties": {}
+        }],
+        "crs": {"type": "name", "properties": {"name": "EPSG:4326"}},
+        "type": "FeatureCollection"
+    })JSON";
+
+    Error error;
+    std::optional<GeoJSON> parsed = parseGeoJSON(json, error);
+    ASSERT_TRUE(parsed) << error.message;
+    std::optional<GeoJSON> converted = convertJSON<GeoJSON>(json, error);
+    ASSERT_TRUE(converted) << error.message;
+    EXPECT_EQ(*converted, *parsed);
+
+    const auto& features = parsed->get<mapbox::feature::feature_collection<double>>();
+    ASSERT_EQ(3u, features.size());
+    EXPECT_EQ(FeatureIdentifier(uint64_t(1)), features[0].id);
+    EXPECT_EQ(Value(int64_t(-2)), features[0].properties.at("rank"));
+    EXPECT_EQ(FeatureIdentifier(std::string("b")), features[1].id);
+    EXPECT_TRUE(features[1].properties.empty());
+    EXPECT_TRUE(features[2].geometry.is<mapbox::geometry::empty>());
+}
+
+TEST(GeoJSON, ParseGeometry) {
+    Error error;
+    std::optional<GeoJSON> parsed = parseGeoJSON(R"JSON({"type": "MultiPoint", "coordinates": [[1, 2], [3, 4]]})JSON",
+                                                 error);
+    ASSERT_TRUE(parsed) << error.message;
+    EXPECT_EQ(GeoJSON(mapbox::geometry::geometry<double>(mapbox::geometry::multi_point<double>{{1, 2}, {3, 4}})),
+              *parsed);
+}
+
+TEST(GeoJSON, ParseErrors) {
+    Error error;
+    EXPECT_FALSE(parseGeoJSON("[]", error));
+    EXPECT_EQ("GeoJSON must be an object", error.message);
+
+    EXPECT_FALSE(parseGeoJSON(R"JSON({"coordinates": [1, 2]})JSON", error));
+    EXPECT_EQ("GeoJSON must have a type property", error.message);
+
+    EXPECT_FALSE(parseGeoJSON(R"JSON({"type": "LineString"})JSON", error));
+    EXPECT_EQ("LineString geometry must have a coordinates property", error.message);
+
+    EXPECT_FALSE(parseGeoJSON(R"JSON({"type": "FeatureCollection"})JSON", error));
+    EXPECT_EQ("FeatureCollection must have features property", error.message);
+
+    EXPECT_FALSE(parseGeoJSON(R"JSON({"type": "Polygon", "coordinates": [[1, 2], [3, 4]]})JSON", error));
+    EXPECT_FALSE(parseGeoJSON(R"JSON({"type": "LineString", "coordinates": [[1, 2], [[3, 4]]]})JSON", error));
+    EXPECT_FALSE(parseGeoJSON(R"JSON({"type": "Feature", "id": [], "geometry": null})JSON", error));
+
+    EXPECT_FALSE(parseGeoJSON(R"JSON({"type": "Point", "coordinates": [1, 2])JSON", error));
+    EXPECT_NE(std::string::npos, error.message.find(" at offset "));
+}
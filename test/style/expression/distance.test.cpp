@@ -0,0 +1,68 @@
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/style/expression/distance.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <limits>
+#include <random>
+
+using namespace mbgl;
+using namespace mbgl::style::expression;
+
+namespace {
+
+const CanonicalTileID canonical(10, 531, 345);
+
+// Distance from the point to the nearest segment of the line, comparing
+// every segment
+double bruteForceDistance(const mapbox::geometry::point<double>& point,
+                          const mapbox::geometry::line_string<double>& line) {
+    mapbox::cheap_ruler::CheapRuler ruler(point.y, mapbox::cheap_ruler::CheapRuler::Unit::Meters);
+    double dist = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i + 1 < line.size(); ++i) {
+        const mapbox::geometry::line_string<double> segment{line[i], line[i + 1]};
+        dist = std::min(dist, ruler.distance(point, std::get<0>(ruler.pointOnLine(segment, point))));
+    }
+    return dist;
+}
+
+} // namespace
+
+TEST(Distance, LongReferenceLine) {
+    // A winding route crossing the tile
+    std::mt19937 random(11);
+    std::uniform_real_distribution<double> step(-0.0004, 0.0006);
+    mapbox::geometry::line_string<double> route;
+    mapbox::geometry::point<double> current(6.6, 50.45);
+    for (int i = 0; i < 5000; ++i) {
+        current.x += step(random);
+        current.y += step(random) / 4;
+        route.push_back(current);
+    }
+    const Distance distance(GeoJSON{mapbox::geometry::geometry<double>{route}}, route);
+
+    std::uniform_int_distribution<int16_t> coordinate(0, util::EXTENT);
+    for (int i = 0; i < 50; ++i) {
+        const StubGeometryTileFeature feature(FeatureType::Point, {{{coordinate(random), coordinate(random)}}});
+        const auto point = convertGeometry(feature, canonical).get<mapbox::geometry::point<double>>();
+
+        const auto result = distance.evaluate(EvaluationContext(&feature).withCanonicalTileID(&canonical));
+        ASSERT_TRUE(result);
+        EXPECT_NEAR(bruteForceDistance(point, route), result->get<double>(), 1e-6);
+    }
+}
+
+TEST(Distance, PointInsidePolygonFeature) {
+    const mapbox::geometry::multi_point<double> points{{6.8, 50.5}, {6.0, 50.0}};
+    const Distance distance(GeoJSON{mapbox::geometry::geometry<double>{points}}, points);
+
+    // The whole tile
+    const int16_t extent = util::EXTENT;
+    const StubGeometryTileFeature feature(FeatureType::Polygon,
+                                          {{{0, 0}, {extent, 0}, {extent, extent}, {0, extent}, {0, 0}}});
+    const auto result = distance.evaluate(EvaluationContext(&feature).withCanonicalTileID(&canonical));
+    ASSERT_TRUE(result);
+    EXPECT_EQ(0.0, result->get<double>());
+}
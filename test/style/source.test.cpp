@@ -4,6 +4,8 @@
 #include <mbgl/test/stub_style_observer.hpp>
 #include <mbgl/test/util.hpp>
 
+#include <mbgl/style/conversion/geojson_options.hpp>
+#include <mbgl/style/conversion/json.hpp>
 #include <mbgl/style/layers/circle_layer.hpp>
 #include <mbgl/style/layers/circle_layer_impl.hpp>
 #include <mbgl/style/layers/hillshade_layer.hpp>
@@ -14,6 +16,8 @@
 #include <mbgl/style/layers/raster_layer_impl.hpp>
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/sources/custom_geometry_source.hpp>
+#include <mbgl/style/sources/flatgeobuf_source.hpp>
+#include <mbgl/style/sources/flatgeobuf_source_impl.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
 #include <mbgl/style/sources/image_source.hpp>
 #include <mbgl/style/sources/raster_dem_source.hpp>
@@ -45,6 +49,7 @@
 #include <mbgl/renderer/tile_render_data.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <optional>
 #include <gmock/gmock.h>
@@ -950,6 +955,264 @@ TEST(Source, GeoJSONSourceTilesAfterDataReset) {
     EXPECT_TRUE(renderSource.isLoaded()); // Tiles are reset in static mode.
 }
 
+TEST(Source, GeoJSONSourceUpdateFeatures) {
+    SourceTest test;
+    GeoJSONSource source("source");
+    source.setObserver(&test.styleObserver);
+
+    const auto makeFeature = [](uint64_t id, double lng, double lat) {
+        GeoJSONFeature feature{Point<double>{lng, lat}};
+        feature.id = id;
+        return feature;
+    };
+
+    std::vector<std::shared_ptr<GeoJSONData>> data;
+    test.styleObserver.sourceLoaded = [&](Source&) {
+        data.push_back(source.impl().getData().lock());
+        test.end();
+    };
+
+    // The data are built in the background
+    source.updateFeatures({makeFeature(1, 10, 10), makeFeature(2, -100, 40)}, {}, {});
+    EXPECT_FALSE(source.loaded);
+    test.run();
+    EXPECT_TRUE(source.loaded);
+    ASSERT_EQ(1u, data.size());
+    ASSERT_TRUE(data[0]);
+
+    const CanonicalTileID moved{8, 135, 120};
+    const CanonicalTileID untouched{8, 56, 96};
+    const CanonicalTileID empty{8, 0, 0};
+
+    source.updateFeatures({}, {makeFeature(1, 10.5, 10), makeFeature(4, 0, 0)}, {});
+    test.run();
+    ASSERT_EQ(2u, data.size());
+    EXPECT_TRUE(data[1]->isTileChanged(moved, *data[0]));
+    EXPECT_TRUE(data[1]->isTileChanged({0, 0, 0}, *data[0]));
+    EXPECT_FALSE(data[1]->isTileChanged(untouched, *data[0]));
+    // Updates without a matching feature are ignored
+    EXPECT_FALSE(data[1]->isTileChanged({8, 128, 128}, *data[0]));
+
+    source.updateFeatures({makeFeature(3, -100.1, 40)}, {}, {FeatureIdentifier{uint64_t{1}}});
+    test.run();
+    ASSERT_EQ(3u, data.size());
+    EXPECT_TRUE(data[2]->isTileChanged(untouched, *data[1]));
+    EXPECT_TRUE(data[2]->isTileChanged(moved, *data[1]));
+    EXPECT_FALSE(data[2]->isTileChanged(empty, *data[1]));
+    // Changes add up when tiles skipped some data
+    EXPECT_TRUE(data[2]->isTileChanged(moved, *data[0]));
+    EXPECT_FALSE(data[2]->isTileChanged(empty, *data[0]));
+
+    // Data from another source change all the tiles
+    EXPECT_TRUE(data[2]->isTileChanged(empty, *GeoJSONData::create(GeoJSONData::Features{})));
+}
+
+TEST(Source, GeoJSONSourceUpdateFeaturesInOrder) {
+    SourceTest test;
+    GeoJSONSource source("source");
+    source.setObserver(&test.styleObserver);
+
+    const auto makeFeature = [](uint64_t id, double lng, double lat) {
+        GeoJSONFeature feature{Point<double>{lng, lat}};
+        feature.id = id;
+        return feature;
+    };
+
+    std::vector<std::shared_ptr<GeoJSONData>> data;
+    test.styleObserver.sourceLoaded = [&](Source&) {
+        data.push_back(source.impl().getData().lock());
+        test.end();
+    };
+
+    // The builds run on the thread pool, the changes still apply in order
+    source.setGeoJSON(GeoJSONData::Features{makeFeature(1, 10, 10), makeFeature(2, -100, 40)});
+    source.updateFeatures({}, {}, {FeatureIdentifier{uint64_t{1}}});
+    source.updateFeatures({makeFeature(1, -10, 10), makeFeature(3, 0, 0)}, {}, {});
+    source.updateFeatures({}, {}, {FeatureIdentifier{uint64_t{2}}});
+    test.run();
+    ASSERT_EQ(1u, data.size());
+    ASSERT_TRUE(data[0]);
+
+    std::vector<FeatureIdentifier> ids;
+    data[0]->getTile({0, 0, 0}, [&](GeoJSONData::TileFeatures features) {
+        for (const auto& feature : features) {
+            ids.push_back(feature.id);
+        }
+        test.end();
+    });
+    test.run();
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ((std::vector<FeatureIdentifier>{uint64_t{1}, uint64_t{3}}), ids);
+
+    // Data set directly have no features to update
+    auto direct = GeoJSONData::create(GeoJSONData::Features{makeFeature(4, 0, 0)});
+    source.setGeoJSONData(direct);
+    source.updateFeatures({makeFeature(5, 0, 0)}, {}, {});
+    EXPECT_EQ(direct, source.impl().getData().lock());
+    EXPECT_EQ(1u, data.size());
+
+    // Until new features are set
+    source.setGeoJSON(GeoJSONData::Features{makeFeature(6, 0, 0)});
+    source.updateFeatures({makeFeature(7, 0, 0)}, {}, {});
+    test.run();
+    ASSERT_EQ(2u, data.size());
+    EXPECT_NE(direct, data[1]);
+}
+
+TEST(Source, GeoJSONSourceUpdateDroppedFeatures) {
+    SourceTest test;
+    GeoJSONSource source("source");
+    source.setObserver(&test.styleObserver);
+
+    const auto makeFeature = [](uint64_t id, double lng, double lat) {
+        GeoJSONFeature feature{Point<double>{lng, lat}};
+        feature.id = id;
+        return feature;
+    };
+
+    std::vector<std::shared_ptr<GeoJSONData>> data;
+    test.styleObserver.sourceLoaded = [&](Source&) {
+        data.push_back(source.impl().getData().lock());
+        test.end();
+    };
+
+    const auto getIDs = [&](GeoJSONData& tileData) {
+        std::vector<FeatureIdentifier> ids;
+        tileData.getTile({0, 0, 0}, [&](GeoJSONData::TileFeatures features) {
+            for (const auto& feature : features) {
+                ids.push_back(feature.id);
+            }
+            test.end();
+        });
+        test.run();
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    };
+
+    // Features indexed before the first update are not kept, so they are not updated
+    source.setGeoJSON(GeoJSONData::Features{makeFeature(1, 10, 10)});
+    test.run();
+    source.updateFeatures({makeFeature(2, 0, 0)}, {}, {});
+    test.run();
+    ASSERT_EQ(2u, data.size());
+    ASSERT_TRUE(data[1]);
+    EXPECT_EQ((std::vector<FeatureIdentifier>{uint64_t{1}}), getIDs(*data[1]));
+
+    // From then on, the features set are kept
+    source.setGeoJSON(GeoJSONData::Features{makeFeature(3, 10, 10)});
+    test.run();
+    source.updateFeatures({makeFeature(4, 0, 0)}, {}, {});
+    test.run();
+    ASSERT_EQ(4u, data.size());
+    ASSERT_TRUE(data[3]);
+    EXPECT_EQ((std::vector<FeatureIdentifier>{uint64_t{3}, uint64_t{4}}), getIDs(*data[3]));
+}
+
+TEST(Source, GeoJSONSourceClusterProperties) {
+    SourceTest test;
+    style::conversion::Error error;
+    auto options = style::conversion::convertJSON<GeoJSONOptions>(
+        R"JSON({
+        "cluster": true,
+        "clusterProperties": {
+            "sum": ["+", ["get", "value"]],
+            "max": ["max", ["get", "value"]],
+            "count": ["+", 1],
+            "double": [["+", ["accumulated"], ["get", "double"]], ["*", 2, ["get", "value"]]]
+        }
+    })JSON",
+        error);
+    ASSERT_TRUE(options);
+
+    GeoJSONData::Features features;
+    for (const Value& value : {Value(uint64_t(1)), Value(2.5), Value(int64_t(4))}) {
+        features.emplace_back(Point<double>{0.001 * features.size(), 0});
+        features.back().properties["value"] = value;
+    }
+    auto data = GeoJSONData::create(features, makeMutable<GeoJSONOptions>(std::move(*options)));
+
+    // Cluster tiles are made on the worker thread
+    GeoJSONData::TileFeatures tileFeatures;
+    data->getTile({0, 0, 0}, [&](GeoJSONData::TileFeatures result) {
+        tileFeatures = std::move(result);
+        test.end();
+    });
+    test.run();
+
+    ASSERT_EQ(1u, tileFeatures.size());
+    const auto& properties = tileFeatures[0].properties;
+    EXPECT_EQ(Value(uint64_t(3)), properties.at("point_count"));
+    EXPECT_EQ(Value(7.5), properties.at("sum"));
+    EXPECT_EQ(Value(4.0), properties.at("max"));
+    EXPECT_EQ(Value(3.0), properties.at("count"));
+    EXPECT_EQ(Value(15.0), properties.at("double"));
+}
+
+TEST(Source, FlatGeobufSource) {
+    SourceTest test;
+    FlatGeobufSource source("source", "test/fixtures/flatgeobuf/features.fgb");
+    source.setObserver(&test.styleObserver);
+    test.styleObserver.sourceLoaded = [&](Source&) { test.end(); };
+
+    // The file is opened in the background
+    source.loadDescription(*test.fileSource);
+    EXPECT_FALSE(source.loaded);
+    test.run();
+    ASSERT_TRUE(source.loaded);
+    auto data = source.impl().getData().lock();
+    ASSERT_TRUE(data);
+
+    // Only the square polygon is around the tile
+    GeoJSONData::TileFeatures tileFeatures;
+    data->getTile({5, 19, 12}, [&](GeoJSONData::TileFeatures result) {
+        tileFeatures = std::move(result);
+        test.end();
+    });
+    test.run();
+    ASSERT_EQ(1u, tileFeatures.size());
+    EXPECT_EQ(FeatureIdentifier(uint64_t(3)), tileFeatures[0].id);
+    EXPECT_TRUE(tileFeatures[0].geometry.is<mapbox::geometry::polygon<int16_t>>());
+
+    FlatGeobufSource missing("missing", "test/fixtures/flatgeobuf/missing.fgb");
+    missing.setObserver(&test.styleObserver);
+    test.styleObserver.sourceError = [&](Source& source_, std::exception_ptr) {
+        EXPECT_EQ("missing", source_.getID());
+        test.end();
+    };
+    missing.loadDescription(*test.fileSource);
+    test.run();
+    EXPECT_FALSE(missing.loaded);
+}
+
+TEST(Source, FlatGeobufSourceCorruptFeatures) {
+    // The header and the index are intact, the last feature is cut short
+    const std::string path = "test/fixtures/flatgeobuf/truncated.fgb";
+    const std::string file = util::read_file("test/fixtures/flatgeobuf/features.fgb");
+    util::write_file(path, file.substr(0, file.size() - 16));
+
+    SourceTest test;
+    FlatGeobufSource source("source", path);
+    source.setObserver(&test.styleObserver);
+    test.styleObserver.sourceLoaded = [&](Source&) { test.end(); };
+    source.loadDescription(*test.fileSource);
+    test.run();
+    ASSERT_TRUE(source.loaded);
+    auto data = source.impl().getData().lock();
+    ASSERT_TRUE(data);
+
+    // The tile reading the cut feature is left empty
+    std::optional<GeoJSONData::TileFeatures> tileFeatures;
+    data->getTile({0, 0, 0}, [&](GeoJSONData::TileFeatures result) {
+        tileFeatures = std::move(result);
+        test.end();
+    });
+    test.run();
+    ASSERT_TRUE(tileFeatures);
+    EXPECT_TRUE(tileFeatures->empty());
+
+    util::deleteFile(path);
+}
+
 TEST(Source, SetMaxParentOverscaleFactor) {
     SourceTest test;
     test.transform.jumpTo(CameraOptions().withCenter(LatLng()).withZoom(8.0));
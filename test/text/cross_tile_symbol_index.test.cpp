@@ -438,3 +438,84 @@ TEST(CrossTileSymbolLayerIndex, offscreenSymbols) {
     EXPECT_EQ(symbolBucket.symbolInstances.at(0).crossTileID, 1u);
     EXPECT_EQ(symbolBucket.symbolInstances.at(1).crossTileID, 2u);
 }
+
+TEST(CrossTileSymbolLayerIndex, keyHashCollision) {
+    uint32_t maxCrossTileID = 0;
+    uint32_t maxBucketInstanceId = 0;
+    CrossTileSymbolLayerIndex index(maxCrossTileID);
+
+    Immutable<style::SymbolLayoutProperties::PossiblyEvaluated> layout =
+        makeMutable<style::SymbolLayoutProperties::PossiblyEvaluated>();
+    bool iconsNeedLinear = false;
+    bool sortFeaturesByY = false;
+    std::string bucketLeaderID = "test";
+
+    // Every key gets the same hash
+    const auto collide = [](std::vector<SymbolInstance>& instances) {
+        for (auto& instance : instances) {
+            instance.keyHash = 42;
+        }
+    };
+
+    OverscaledTileID mainID(6, 0, 6, 8, 8);
+    std::vector<SymbolInstance> mainInstances;
+    std::vector<SortKeyRange> mainRanges;
+    mainInstances.push_back(makeSymbolInstance(1000, 1000, u"Detroit"));
+    mainInstances.push_back(makeSymbolInstance(1000, 1000, u"Windsor"));
+    collide(mainInstances);
+    SymbolBucket mainBucket{layout,
+                            {},
+                            16.0f,
+                            1.0f,
+                            0,
+                            iconsNeedLinear,
+                            sortFeaturesByY,
+                            bucketLeaderID,
+                            std::move(mainInstances),
+                            std::move(mainRanges),
+                            1.0f,
+                            false,
+                            {},
+                            false /*iconsInText*/};
+    mainBucket.bucketInstanceId = ++maxBucketInstanceId;
+    index.addBucket(mainID, mat4{}, mainBucket);
+
+    ASSERT_EQ(mainBucket.symbolInstances.at(0).crossTileID, 1u);
+    ASSERT_EQ(mainBucket.symbolInstances.at(1).crossTileID, 2u);
+
+    OverscaledTileID childID(7, 0, 7, 16, 16);
+    std::vector<SymbolInstance> childInstances;
+    std::vector<SortKeyRange> childRanges;
+    childInstances.push_back(makeSymbolInstance(2000, 2000, u"Windsor"));
+    childInstances.push_back(makeSymbolInstance(2000, 2000, u"Toronto"));
+    collide(childInstances);
+    SymbolBucket childBucket{layout,
+                             {},
+                             16.0f,
+                             1.0f,
+                             0,
+                             iconsNeedLinear,
+                             sortFeaturesByY,
+                             bucketLeaderID,
+                             std::move(childInstances),
+                             std::move(childRanges),
+                             1.0f,
+                             false,
+                             {},
+                             false /*iconsInText*/};
+    childBucket.bucketInstanceId = ++maxBucketInstanceId;
+    index.addBucket(childID, mat4{}, childBucket);
+
+    // matches the symbol with the same key, not the first one with the same hash
+    ASSERT_EQ(childBucket.symbolInstances.at(0).crossTileID, 2u);
+    // does not match because of different key
+    ASSERT_EQ(childBucket.symbolInstances.at(1).crossTileID, 3u);
+
+    // removing the tile releases the IDs of every key sharing the hash
+    std::unordered_set<uint32_t> currentIDs;
+    currentIDs.insert(childBucket.bucketInstanceId);
+    index.removeStaleBuckets(currentIDs);
+    index.addBucket(mainID, mat4{}, mainBucket);
+    ASSERT_EQ(mainBucket.symbolInstances.at(0).crossTileID, 4u);
+    ASSERT_EQ(mainBucket.symbolInstances.at(1).crossTileID, 2u);
+}
@@ -0,0 +1,118 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/glyph_atlas.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+Immutable<Glyph> makeGlyph(GlyphID id, uint32_t size, uint8_t value = 0xFF) {
+    Glyph glyph;
+    glyph.id = id;
+    glyph.bitmap = AlphaImage({size, size});
+    glyph.bitmap.fill(value);
+    glyph.metrics.width = size;
+    glyph.metrics.height = size;
+    return Immutable<Glyph>(makeMutable<Glyph>(std::move(glyph)));
+}
+
+GlyphMap makeGlyphMap(FontStackHash fontStack, const std::vector<Immutable<Glyph>>& glyphs) {
+    GlyphMap result;
+    for (const auto& glyph : glyphs) {
+        result[fontStack].emplace(glyph->id, glyph);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(SharedGlyphAtlas, SharesGlyphsBetweenTiles) {
+    auto atlas = std::make_shared<SharedGlyphAtlas>();
+    const auto a = makeGlyph(u'a', 20);
+    const auto b = makeGlyph(u'b', 20);
+
+    auto first = atlas->acquire(makeGlyphMap(1, {a, b}));
+    auto second = atlas->acquire(makeGlyphMap(1, {b}));
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_EQ(2u, atlas->getGlyphCount());
+
+    const auto& firstB = first->getPositions().at(1).at(u'b');
+    const auto& secondB = second->getPositions().at(1).at(u'b');
+    EXPECT_EQ(firstB.rect, secondB.rect);
+    EXPECT_EQ(firstB.metrics, secondB.metrics);
+    EXPECT_FALSE(first->getPositions().at(1).at(u'a').rect == firstB.rect);
+
+    // Different font stacks don't share glyphs
+    auto third = atlas->acquire(makeGlyphMap(2, {b}));
+    ASSERT_TRUE(third);
+    EXPECT_EQ(3u, atlas->getGlyphCount());
+}
+
+TEST(SharedGlyphAtlas, SkipsEmptyGlyphs) {
+    auto atlas = std::make_shared<SharedGlyphAtlas>();
+    GlyphMap glyphs = makeGlyphMap(1, {makeGlyph(u'a', 10)});
+    glyphs[1].emplace(u' ', std::nullopt);
+
+    auto reference = atlas->acquire(glyphs);
+    ASSERT_TRUE(reference);
+    EXPECT_EQ(1u, reference->getPositions().at(1).size());
+    EXPECT_EQ(1u, atlas->getGlyphCount());
+}
+
+TEST(SharedGlyphAtlas, Grows) {
+    auto atlas = std::make_shared<SharedGlyphAtlas>(Size{1024, 1024});
+    const Size initialSize = atlas->getSize();
+
+    std::vector<Immutable<Glyph>> glyphs;
+    for (GlyphID id = 0; id < 256; ++id) {
+        glyphs.push_back(makeGlyph(id, 30));
+    }
+    auto reference = atlas->acquire(makeGlyphMap(1, glyphs));
+    ASSERT_TRUE(reference);
+    EXPECT_GT(atlas->getSize().area(), initialSize.area());
+    EXPECT_LE(atlas->getSize().width, 1024u);
+    EXPECT_LE(atlas->getSize().height, 1024u);
+}
+
+TEST(SharedGlyphAtlas, EvictsUnreferencedGlyphs) {
+    // Room for exactly four padded 14x14 glyphs
+    auto atlas = std::make_shared<SharedGlyphAtlas>(Size{32, 32});
+
+    auto first = atlas->acquire(makeGlyphMap(1, {makeGlyph(1, 14), makeGlyph(2, 14)}));
+    auto second = atlas->acquire(makeGlyphMap(1, {makeGlyph(3, 14), makeGlyph(4, 14)}));
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+
+    // Everything is referenced, so there's no room
+    EXPECT_FALSE(atlas->acquire(makeGlyphMap(1, {makeGlyph(5, 14)})));
+    EXPECT_EQ(4u, atlas->getGlyphCount());
+
+    // Released glyphs stay resident until their space is needed
+    first.reset();
+    EXPECT_EQ(4u, atlas->getGlyphCount());
+    auto third = atlas->acquire(makeGlyphMap(1, {makeGlyph(5, 14)}));
+    ASSERT_TRUE(third);
+    EXPECT_EQ(4u, atlas->getGlyphCount());
+
+    // Glyphs still referenced keep their position
+    auto fourth = atlas->acquire(makeGlyphMap(1, {makeGlyph(3, 14)}));
+    ASSERT_TRUE(fourth);
+    EXPECT_EQ(second->getPositions().at(1).at(3).rect, fourth->getPositions().at(1).at(3).rect);
+}
+
+TEST(SharedGlyphAtlas, ReplacesChangedGlyphs) {
+    auto atlas = std::make_shared<SharedGlyphAtlas>();
+
+    auto first = atlas->acquire(makeGlyphMap(1, {makeGlyph(1, 10, 0x10)}));
+    ASSERT_TRUE(first);
+
+    // A glyph with the same ID but a different bitmap can't replace one in use
+    EXPECT_FALSE(atlas->acquire(makeGlyphMap(1, {makeGlyph(1, 10, 0x20)})));
+    // An identical copy is fine
+    EXPECT_TRUE(atlas->acquire(makeGlyphMap(1, {makeGlyph(1, 10, 0x10)})));
+
+    first.reset();
+    EXPECT_TRUE(atlas->acquire(makeGlyphMap(1, {makeGlyph(1, 10, 0x20)})));
+    EXPECT_EQ(1u, atlas->getGlyphCount());
+}
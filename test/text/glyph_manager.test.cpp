@@ -255,6 +255,42 @@ TEST(GlyphManager, LoadingCorrupted) {
     test.run("test/fixtures/resources/glyphs.pbf", GlyphDependencies{{{{"Test Stack"}}, {u'a', u'å'}}});
 }
 
+TEST(GlyphManager, SharesParsedRangesBetweenInstances) {
+    GlyphManagerTest test;
+    GlyphManager otherGlyphManager{std::make_unique<StubLocalGlyphRasterizer>()};
+    StubGlyphRequestor otherRequestor;
+
+    // Each response carries its own copy of the data
+    test.fileSource.glyphsResponse = [&](const Resource&) {
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+        return response;
+    };
+
+    test.observer.glyphsError = [&](const FontStack&, const GlyphRange&, std::exception_ptr) {
+        FAIL();
+        test.end();
+    };
+
+    std::optional<Immutable<Glyph>> firstGlyph;
+    test.requestor.glyphsAvailable = [&](GlyphMap glyphs) {
+        firstGlyph = glyphs.at(FontStackHasher()({{"Test Stack"}})).at(u'a');
+        otherGlyphManager.setURL("test/fixtures/resources/glyphs.pbf");
+        otherGlyphManager.getGlyphs(otherRequestor, GlyphDependencies{{{{"Test Stack"}}, {u'a'}}}, test.fileSource);
+    };
+
+    otherRequestor.glyphsAvailable = [&](GlyphMap glyphs) {
+        const auto& secondGlyph = glyphs.at(FontStackHasher()({{"Test Stack"}})).at(u'a');
+        ASSERT_TRUE(firstGlyph);
+        ASSERT_TRUE(secondGlyph);
+        // The range was decoded once and shared
+        EXPECT_TRUE(*firstGlyph == *secondGlyph);
+        test.end();
+    };
+
+    test.run("test/fixtures/resources/glyphs.pbf", GlyphDependencies{{{{"Test Stack"}}, {u'a'}}});
+}
+
 TEST(GlyphManager, LoadingCancel) {
     GlyphManagerTest test;
 
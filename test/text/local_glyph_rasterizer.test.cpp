@@ -9,6 +9,9 @@
 #include <mbgl/renderer/renderer.hpp>
 #include <mbgl/gfx/headless_frontend.hpp>
 #include <mbgl/style/style.hpp>
+#include <mbgl/text/local_glyph_rasterizer.hpp>
+
+#include <algorithm>
 
 /*
     LoadLocalCJKGlyph in glyph_manager.test.cpp exercises the
@@ -106,6 +109,32 @@ TEST(LocalGlyphRasterizer, NotoSansCJK) {
 }
 #endif // defined(__linux__) && defined(__QT__)
 
+#if defined(__linux__) && !defined(__QT__)
+TEST(LocalGlyphRasterizer, FreeType) {
+    LocalGlyphRasterizer rasterizer(std::string("Noto Sans CJK JP"));
+    const FontStack fontStack{{"Open Sans Regular"}};
+    if (!rasterizer.canRasterizeGlyph(fontStack, u'中')) {
+        GTEST_SKIP() << "Built without FreeType, or Noto Sans CJK JP is not installed";
+    }
+    EXPECT_FALSE(rasterizer.canRasterizeGlyph(fontStack, u'a'));
+
+    const Glyph glyph = rasterizer.rasterizeGlyph(fontStack, u'中');
+    EXPECT_EQ(u'中', glyph.id);
+    EXPECT_GT(glyph.metrics.width, 0u);
+    EXPECT_GT(glyph.metrics.height, 0u);
+    EXPECT_GE(glyph.metrics.advance, glyph.metrics.width);
+    EXPECT_EQ(Size(glyph.metrics.width + 2 * Glyph::borderSize, glyph.metrics.height + 2 * Glyph::borderSize),
+              glyph.bitmap.size);
+    EXPECT_TRUE(std::any_of(
+        glyph.bitmap.data.get(), glyph.bitmap.data.get() + glyph.bitmap.bytes(), [](uint8_t alpha) { return alpha; }));
+
+    // Rendered again, the same bitmap
+    const Glyph cached = rasterizer.rasterizeGlyph(fontStack, u'中');
+    EXPECT_EQ(glyph.metrics, cached.metrics);
+    EXPECT_EQ(glyph.bitmap, cached.bitmap);
+}
+#endif // defined(__linux__) && !defined(__QT__)
+
 TEST(LocalGlyphRasterizer, NoLocal) {
     // Expectation: without any local fonts set, and without any CJK glyphs
     // provided, the output should just contain basic latin characters.
@@ -0,0 +1,156 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/text/tagged_string.hpp>
+#include <mbgl/util/constants.hpp>
+
+using namespace mbgl;
+using namespace util;
+
+namespace {
+
+class ShapingCacheTest {
+public:
+    ShapingCacheTest() {
+        for (char16_t id : std::u16string(u"abc ")) {
+            Glyph glyph;
+            glyph.id = id;
+            glyph.metrics = {10, 18, 1, -8, 12};
+            glyphs[fontStackHash].emplace(id, Immutable<Glyph>(makeMutable<Glyph>(std::move(glyph))));
+            positions[fontStackHash].emplace(id, GlyphPosition{{id, 0, 12, 20}, {10, 18, 1, -8, 12}});
+        }
+    }
+
+    Shaping shape(const TaggedString& string, ShapingCache* cache = nullptr) {
+        const auto maxWidth = 2 * ONE_EM;
+        if (cache) {
+            return cache->getShaping(string,
+                                     maxWidth,
+                                     ONE_EM,
+                                     style::SymbolAnchorType::Center,
+                                     style::TextJustifyType::Center,
+                                     0,
+                                     {{0.0f, 0.0f}},
+                                     WritingModeType::Horizontal,
+                                     bidi,
+                                     glyphs,
+                                     positions,
+                                     imagePositions,
+                                     16.0f,
+                                     16.0f,
+                                     false);
+        }
+        return getShaping(string,
+                          maxWidth,
+                          ONE_EM,
+                          style::SymbolAnchorType::Center,
+                          style::TextJustifyType::Center,
+                          0,
+                          {{0.0f, 0.0f}},
+                          WritingModeType::Horizontal,
+                          bidi,
+                          glyphs,
+                          positions,
+                          imagePositions,
+                          16.0f,
+                          16.0f,
+                          false);
+    }
+
+    const FontStack fontStack{{"font-stack"}};
+    const FontStackHash fontStackHash = FontStackHasher()(fontStack);
+    const SectionOptions sectionOptions{1.0, fontStack};
+    BiDi bidi;
+    GlyphMap glyphs;
+    GlyphPositions positions;
+    ImagePositions imagePositions;
+};
+
+void expectSameShaping(const Shaping& expected, const Shaping& actual) {
+    EXPECT_EQ(expected.top, actual.top);
+    EXPECT_EQ(expected.bottom, actual.bottom);
+    EXPECT_EQ(expected.left, actual.left);
+    EXPECT_EQ(expected.right, actual.right);
+    ASSERT_EQ(expected.positionedLines.size(), actual.positionedLines.size());
+    for (std::size_t i = 0; i < expected.positionedLines.size(); ++i) {
+        const auto& expectedGlyphs = expected.positionedLines[i].positionedGlyphs;
+        const auto& actualGlyphs = actual.positionedLines[i].positionedGlyphs;
+        ASSERT_EQ(expectedGlyphs.size(), actualGlyphs.size());
+        for (std::size_t j = 0; j < expectedGlyphs.size(); ++j) {
+            EXPECT_EQ(expectedGlyphs[j].glyph, actualGlyphs[j].glyph);
+            EXPECT_EQ(expectedGlyphs[j].x, actualGlyphs[j].x);
+            EXPECT_EQ(expectedGlyphs[j].y, actualGlyphs[j].y);
+            EXPECT_EQ(expectedGlyphs[j].rect, actualGlyphs[j].rect);
+        }
+    }
+}
+
+} // namespace
+
+TEST(ShapingCache, UsesCallerGlyphPositions) {
+    ShapingCacheTest test;
+    ShapingCache cache;
+    const TaggedString string(u"abc cba", test.sectionOptions);
+
+    expectSameShaping(test.shape(string), test.shape(string, &cache));
+    EXPECT_EQ(1u, cache.size());
+
+    // Another tile has the same glyphs in different places of its atlas
+    for (auto& position : test.positions[test.fontStackHash]) {
+        position.second.rect.y = 40;
+    }
+    const Shaping cached = test.shape(string, &cache);
+    expectSameShaping(test.shape(string), cached);
+    EXPECT_EQ(40, cached.positionedLines[0].positionedGlyphs[0].rect.y);
+    EXPECT_EQ(1u, cache.size());
+}
+
+TEST(ShapingCache, ReshapesWhenGlyphsChange) {
+    ShapingCacheTest test;
+    ShapingCache cache;
+    const TaggedString string(u"abc cba", test.sectionOptions);
+    test.shape(string, &cache);
+
+    // Wider glyphs from another font with the same name
+    for (auto& position : test.positions[test.fontStackHash]) {
+        position.second.metrics.advance = 30;
+    }
+    for (auto& glyph : test.glyphs[test.fontStackHash]) {
+        Glyph wider = **glyph.second;
+        wider.metrics.advance = 30;
+        glyph.second = Immutable<Glyph>(makeMutable<Glyph>(std::move(wider)));
+    }
+    expectSameShaping(test.shape(string), test.shape(string, &cache));
+
+    // Glyphs missing from a tile
+    test.positions[test.fontStackHash].erase(u'b');
+    test.glyphs[test.fontStackHash].erase(u'b');
+    expectSameShaping(test.shape(string), test.shape(string, &cache));
+    EXPECT_EQ(1u, cache.size());
+}
+
+TEST(ShapingCache, EvictsLeastRecentlyUsed) {
+    ShapingCacheTest test;
+    ShapingCache cache(2);
+
+    test.shape(TaggedString(u"a", test.sectionOptions), &cache);
+    test.shape(TaggedString(u"b", test.sectionOptions), &cache);
+    test.shape(TaggedString(u"a", test.sectionOptions), &cache);
+    test.shape(TaggedString(u"c", test.sectionOptions), &cache);
+    EXPECT_EQ(2u, cache.size());
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.size());
+}
+
+TEST(ShapingCache, SkipsTextWithImages) {
+    ShapingCacheTest test;
+    ShapingCache cache;
+
+    TaggedString string;
+    string.addTextSection(u"ab", 1.0, test.fontStack);
+    string.addImageSection("image");
+    test.shape(string, &cache);
+    EXPECT_EQ(0u, cache.size());
+}
@@ -0,0 +1,122 @@
+#include <mbgl/geometry/anchor.hpp>
+#include <mbgl/layout/symbol_instance.hpp>
+#include <mbgl/style/layers/symbol_layer_properties.hpp>
+#include <mbgl/test/util.hpp>
+
+#include <limits>
+#include <memory>
+#include <utility>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr auto maxIndex = std::numeric_limits<uint32_t>::max();
+
+SymbolInstance makeSymbolInstance(std::size_t layoutFeatureIndex,
+                                  std::size_t dataFeatureIndex,
+                                  std::u16string key,
+                                  SymbolContent iconType = SymbolContent::None) {
+    Anchor anchor(1.0f, 2.0f, 0, 0);
+    const ShapedTextOrientations shaping{};
+    const std::array<float, 2> textOffset{{1.0f, -1.0f}};
+    const std::array<float, 2> iconOffset{{2.0f, -2.0f}};
+    const std::array<float, 2> variableTextOffset{{3.0f, -3.0f}};
+    const auto placementType = style::SymbolPlacementType::Point;
+    auto sharedData = std::make_shared<SymbolInstanceSharedData>(GeometryCoordinates{},
+                                                                 shaping,
+                                                                 std::nullopt,
+                                                                 std::nullopt,
+                                                                 style::SymbolLayoutProperties::Evaluated{},
+                                                                 placementType,
+                                                                 textOffset,
+                                                                 ImageMap{},
+                                                                 0.0f,
+                                                                 iconType,
+                                                                 false,
+                                                                 false);
+    return SymbolInstance(anchor,
+                          std::move(sharedData),
+                          shaping,
+                          std::nullopt,
+                          std::nullopt,
+                          0.5f,
+                          0,
+                          placementType,
+                          textOffset,
+                          0,
+                          0,
+                          iconOffset,
+                          IndexedSubfeature(0, "", "", 0),
+                          layoutFeatureIndex,
+                          dataFeatureIndex,
+                          std::move(key),
+                          0.0f,
+                          0.0f,
+                          0.0f,
+                          variableTextOffset,
+                          false,
+                          iconType);
+}
+
+} // namespace
+
+TEST(SymbolInstance, FeatureIndices) {
+    for (const std::size_t index : {std::size_t(0), std::size_t(1), std::size_t(maxIndex - 1), std::size_t(maxIndex)}) {
+        const auto instance = makeSymbolInstance(index, maxIndex - index, u"key");
+        EXPECT_EQ(index, instance.layoutFeatureIndex);
+        EXPECT_EQ(maxIndex - index, instance.dataFeatureIndex);
+    }
+}
+
+TEST(SymbolInstance, PlacedIndices) {
+    auto instance = makeSymbolInstance(0, 0, u"key");
+    EXPECT_FALSE(instance.getDefaultHorizontalPlacedTextIndex());
+
+    // Index 0 is a valid index, distinct from no index
+    instance.placedLeftTextIndex = 0u;
+    EXPECT_EQ(0u, instance.getDefaultHorizontalPlacedTextIndex());
+    instance.placedCenterTextIndex = maxIndex;
+    EXPECT_EQ(maxIndex, instance.getDefaultHorizontalPlacedTextIndex());
+    instance.placedRightTextIndex = maxIndex - 1;
+    EXPECT_EQ(maxIndex - 1, instance.getDefaultHorizontalPlacedTextIndex());
+
+    instance.placedVerticalTextIndex = maxIndex;
+    instance.placedIconIndex = 0u;
+    instance.placedVerticalIconIndex = maxIndex;
+    instance.crossTileID = SymbolInstance::invalidCrossTileID();
+
+    // Moving an instance, as buckets do, keeps every field
+    const auto moved = std::move(instance);
+    EXPECT_EQ(maxIndex - 1, moved.placedRightTextIndex);
+    EXPECT_EQ(maxIndex, moved.placedCenterTextIndex);
+    EXPECT_EQ(0u, moved.placedLeftTextIndex);
+    EXPECT_EQ(maxIndex, moved.placedVerticalTextIndex);
+    EXPECT_EQ(0u, moved.placedIconIndex);
+    EXPECT_EQ(maxIndex, moved.placedVerticalIconIndex);
+    EXPECT_EQ(SymbolInstance::invalidCrossTileID(), moved.crossTileID);
+}
+
+TEST(SymbolInstance, Fields) {
+    const auto instance = makeSymbolInstance(3, 4, u"key", SymbolContent::IconSDF);
+    EXPECT_EQ(u"key", instance.key);
+    EXPECT_EQ(std::hash<std::u16string>()(u"key"), instance.keyHash);
+    EXPECT_EQ((std::array<float, 2>{{1.0f, -1.0f}}), instance.textOffset);
+    EXPECT_EQ((std::array<float, 2>{{2.0f, -2.0f}}), instance.iconOffset);
+    EXPECT_EQ((std::array<float, 2>{{3.0f, -3.0f}}), instance.variableTextOffset);
+    EXPECT_EQ(0.5f, instance.textBoxScale);
+    EXPECT_EQ(0u, instance.crossTileID);
+
+    // Without shaped text there are no glyph quads and no writing modes
+    EXPECT_EQ(0u, instance.rightJustifiedGlyphQuadsSize);
+    EXPECT_EQ(0u, instance.centerJustifiedGlyphQuadsSize);
+    EXPECT_EQ(0u, instance.leftJustifiedGlyphQuadsSize);
+    EXPECT_EQ(0u, instance.verticalGlyphQuadsSize);
+    EXPECT_EQ(0u, instance.iconQuadsSize);
+    EXPECT_EQ(WritingModeType::None, instance.writingModes);
+    EXPECT_FALSE(instance.hasText());
+    EXPECT_TRUE(instance.hasIcon());
+    EXPECT_TRUE(instance.hasSdfIcon());
+    EXPECT_FALSE(instance.verticalTextCollisionFeature);
+    EXPECT_FALSE(instance.verticalIconCollisionFeature);
+}
@@ -0,0 +1,90 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/layout/symbol_projection.hpp>
+#include <mbgl/renderer/buckets/symbol_bucket.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+mat4 perspectiveMatrix() {
+    mat4 m;
+    matrix::perspective(m, 0.6435, 1.5, 1, 10000);
+    matrix::translate(m, m, -4096, -2048, -5000);
+    matrix::rotate_x(m, m, 1.0);
+    matrix::rotate_z(m, m, 0.3);
+    return m;
+}
+
+GeometryCoordinates straightLine(std::size_t size) {
+    GeometryCoordinates line;
+    for (std::size_t i = 0; i < size; ++i) {
+        line.emplace_back(static_cast<int16_t>(i * 100), static_cast<int16_t>(i * 50));
+    }
+    return line;
+}
+
+} // namespace
+
+TEST(LineProjectionCache, MatchesProject) {
+    const mat4 m = perspectiveMatrix();
+    const GeometryCoordinates line = straightLine(11);
+
+    LineProjectionCache cache;
+    cache.reset(line, m);
+    for (std::size_t i = 0; i < line.size(); ++i) {
+        const auto expected = project(convertPoint<float>(line[i]), m);
+        const auto& actual = cache.at(i);
+        EXPECT_EQ(expected.first.x, actual.first.x);
+        EXPECT_EQ(expected.first.y, actual.first.y);
+        EXPECT_EQ(expected.second, actual.second);
+    }
+    EXPECT_EQ(line.size(), cache.projectedVertices());
+}
+
+TEST(LineProjectionCache, ProjectsOnFirstUse) {
+    mat4 m;
+    matrix::identity(m);
+    const GeometryCoordinates line = straightLine(10);
+
+    LineProjectionCache cache;
+    cache.reset(line, m);
+    EXPECT_EQ(0u, cache.projectedVertices());
+
+    EXPECT_EQ(Point<float>(500, 250), cache.at(5).first);
+    EXPECT_EQ(LineProjectionCache::blockSize, cache.projectedVertices());
+    cache.at(6);
+    EXPECT_EQ(LineProjectionCache::blockSize, cache.projectedVertices());
+    // The last block is shorter
+    cache.at(9);
+    EXPECT_EQ(LineProjectionCache::blockSize + 2, cache.projectedVertices());
+
+    const GeometryCoordinates other = straightLine(3);
+    cache.reset(other, m);
+    EXPECT_EQ(0u, cache.projectedVertices());
+    EXPECT_EQ(Point<float>(200, 100), cache.at(2).first);
+}
+
+TEST(SymbolProjection, PlaceFirstAndLastGlyph) {
+    mat4 m;
+    matrix::identity(m);
+    GeometryCoordinates line;
+    for (int16_t x = 0; x <= 1000; x += 100) {
+        line.emplace_back(x, 0);
+    }
+    PlacedSymbol symbol({500, 0}, 5, 16, 16, {{0, 0}}, WritingModeType::Horizontal, line, {});
+    symbol.glyphOffsets = {-150, 0, 150};
+
+    LineProjectionCache cache;
+    cache.reset(symbol.line, m);
+    const auto glyphs = placeFirstAndLastGlyph(1, 0, 0, false, {500, 0}, {500, 0}, symbol, m, cache, false);
+    ASSERT_TRUE(glyphs);
+    EXPECT_FLOAT_EQ(350, glyphs->first.point.x);
+    EXPECT_FLOAT_EQ(650, glyphs->second.point.x);
+    // Only the blocks around the anchor were projected
+    EXPECT_EQ(2 * LineProjectionCache::blockSize, cache.projectedVertices());
+
+    symbol.glyphOffsets = {-600, 600};
+    cache.reset(symbol.line, m);
+    EXPECT_FALSE(placeFirstAndLastGlyph(1, 0, 0, false, {500, 0}, {500, 0}, symbol, m, cache, false));
+}
@@ -0,0 +1,140 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/fake_file_source.hpp>
+
+#include <mbgl/annotation/annotation_manager.hpp>
+#include <mbgl/annotation/annotation_tile.hpp>
+#include <mbgl/map/transform.hpp>
+#include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+
+using namespace mbgl;
+
+namespace {
+
+class AnnotationTileTest {
+public:
+    std::shared_ptr<FileSource> fileSource = std::make_shared<FakeFileSource>();
+    TransformState transformState;
+    util::RunLoop loop;
+    style::Style style{fileSource, 1};
+    AnnotationManager annotationManager{style};
+    ImageManager imageManager;
+    GlyphManager glyphManager;
+
+    TileParameters tileParameters{1.0,
+                                  MapDebugOptions(),
+                                  transformState,
+                                  fileSource,
+                                  MapMode::Continuous,
+                                  annotationManager.makeWeakPtr(),
+                                  imageManager,
+                                  glyphManager,
+                                  0};
+
+    // The four tiles at zoom 1, by quadrant
+    std::map<std::string, std::unique_ptr<AnnotationTile>> tiles;
+
+    AnnotationTileTest() {
+        tiles["nw"] = std::make_unique<AnnotationTile>(OverscaledTileID(1, 0, 0), tileParameters);
+        tiles["ne"] = std::make_unique<AnnotationTile>(OverscaledTileID(1, 1, 0), tileParameters);
+        tiles["sw"] = std::make_unique<AnnotationTile>(OverscaledTileID(1, 0, 1), tileParameters);
+        tiles["se"] = std::make_unique<AnnotationTile>(OverscaledTileID(1, 1, 1), tileParameters);
+    }
+
+    // The data updates of each tile since the last call
+    std::map<std::string, std::size_t> updates() {
+        std::map<std::string, std::size_t> result;
+        for (const auto& tile : tiles) {
+            result[tile.first] = tile.second->getAnnotationDataUpdates() - counts[tile.first];
+            counts[tile.first] = tile.second->getAnnotationDataUpdates();
+        }
+        return result;
+    }
+
+private:
+    std::map<std::string, std::size_t> counts;
+};
+
+using Updates = std::map<std::string, std::size_t>;
+
+LineAnnotation makeLine(LineString<double> line) {
+    LineAnnotation annotation{std::move(line)};
+    annotation.color = Color::red();
+    return annotation;
+}
+
+} // namespace
+
+TEST(AnnotationTile, UpdateTouchedTiles) {
+    AnnotationTileTest test;
+    EXPECT_EQ((Updates{{"ne", 1}, {"nw", 1}, {"se", 1}, {"sw", 1}}), test.updates());
+
+    const AnnotationID symbol = test.annotationManager.addAnnotation(
+        SymbolAnnotation{Point<double>{-90, -45}, "default_marker"});
+    const AnnotationID line = test.annotationManager.addAnnotation(makeLine({{10, 10}, {40, 40}}));
+    test.annotationManager.updateData();
+    // The first annotations are added to all the tiles
+    EXPECT_EQ((Updates{{"ne", 1}, {"nw", 1}, {"se", 1}, {"sw", 1}}), test.updates());
+    EXPECT_EQ((std::vector<CanonicalTileID>{{1, 1, 0}}), test.annotationManager.getShapeTileIDs(line));
+
+    // Without changes, no tile is rebuilt
+    test.annotationManager.updateData();
+    EXPECT_EQ((Updates{{"ne", 0}, {"nw", 0}, {"se", 0}, {"sw", 0}}), test.updates());
+
+    // Moving a symbol rebuilds the tiles it leaves and enters
+    test.annotationManager.updateAnnotation(symbol, SymbolAnnotation{Point<double>{-100, -40}, "default_marker"});
+    test.annotationManager.updateData();
+    EXPECT_EQ((Updates{{"ne", 0}, {"nw", 0}, {"se", 0}, {"sw", 1}}), test.updates());
+
+    // Updating a shape rebuilds the tiles of its old and new features
+    test.annotationManager.updateAnnotation(line, makeLine({{20, 10}, {40, 30}}));
+    test.annotationManager.updateData();
+    EXPECT_EQ((Updates{{"ne", 1}, {"nw", 0}, {"se", 0}, {"sw", 0}}), test.updates());
+
+    test.annotationManager.updateAnnotation(line, makeLine({{20, 40}, {20, -40}}));
+    test.annotationManager.updateData();
+    EXPECT_EQ((Updates{{"ne", 1}, {"nw", 0}, {"se", 1}, {"sw", 0}}), test.updates());
+
+    // Removing it rebuilds the tiles it had features in
+    test.annotationManager.removeAnnotation(line);
+    test.annotationManager.updateData();
+    EXPECT_EQ((Updates{{"ne", 1}, {"nw", 0}, {"se", 1}, {"sw", 0}}), test.updates());
+
+    // Removing the last annotation empties all the tiles
+    test.annotationManager.removeAnnotation(symbol);
+    test.annotationManager.updateData();
+    EXPECT_EQ((Updates{{"ne", 1}, {"nw", 1}, {"se", 1}, {"sw", 1}}), test.updates());
+}
+
+TEST(AnnotationTile, RemoveTileDropsShapeFeatures) {
+    AnnotationTileTest test;
+
+    const AnnotationID line = test.annotationManager.addAnnotation(makeLine({{20, 40}, {20, -40}}));
+    test.annotationManager.updateData();
+    EXPECT_EQ((std::vector<CanonicalTileID>{{1, 1, 0}, {1, 1, 1}}), [&] {
+        auto tileIDs = test.annotationManager.getShapeTileIDs(line);
+        std::sort(tileIDs.begin(), tileIDs.end());
+        return tileIDs;
+    }());
+
+    // Another tile of the same area keeps the features cached
+    auto copy = std::make_unique<AnnotationTile>(OverscaledTileID(1, 1, 1, 1, 1), test.tileParameters);
+    test.tiles.erase("se");
+    EXPECT_EQ(2u, test.annotationManager.getShapeTileIDs(line).size());
+
+    copy.reset();
+    EXPECT_EQ((std::vector<CanonicalTileID>{{1, 1, 0}}), test.annotationManager.getShapeTileIDs(line));
+
+    // Tiles away from the removed one are still not rebuilt
+    test.updates();
+    test.annotationManager.updateAnnotation(line, makeLine({{20, 40}, {30, 40}}));
+    test.annotationManager.updateData();
+    EXPECT_EQ((Updates{{"ne", 1}, {"nw", 0}, {"sw", 0}}), test.updates());
+}
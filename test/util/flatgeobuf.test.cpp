@@ -0,0 +1,48 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/flatgeobuf.hpp>
+#include <mbgl/util/geometry.hpp>
+
+using namespace mbgl;
+using namespace mbgl::util;
+
+namespace {
+
+std::vector<uint64_t> getIDs(const FlatGeobufFile::Features& features) {
+    std::vector<uint64_t> ids;
+    for (const auto& feature : features) {
+        ids.push_back(feature.id.get<uint64_t>());
+    }
+    return ids;
+}
+
+} // namespace
+
+TEST(FlatGeobuf, Query) {
+    // Six features of mixed types, indexed by an R-tree with two children per node
+    FlatGeobufFile file("test/fixtures/flatgeobuf/features.fgb");
+    EXPECT_EQ(6u, file.getFeatureCount());
+
+    const auto all = file.query({{-180, -90}, {180, 90}});
+    EXPECT_EQ((std::vector<uint64_t>{0, 1, 2, 3, 4, 5}), getIDs(all));
+    EXPECT_EQ(Point<double>(0, 0), all[0].geometry.get<Point<double>>());
+    EXPECT_EQ(Value(std::string("origin")), all[0].properties.at("name"));
+    EXPECT_EQ(Value(int64_t(-3)), all[1].properties.at("rank"));
+    EXPECT_EQ(2u, all[2].geometry.get<LineString<double>>().size());
+    EXPECT_TRUE(all[5].properties.empty());
+
+    const auto& polygon = all[3].geometry.get<Polygon<double>>();
+    ASSERT_EQ(2u, polygon.size());
+    EXPECT_EQ(5u, polygon[1].size());
+    EXPECT_EQ(Value(2.5), all[3].properties.at("area"));
+    EXPECT_EQ(2u, all[4].geometry.get<MultiPolygon<double>>().size());
+
+    EXPECT_EQ((std::vector<uint64_t>{0}), getIDs(file.query({{-1, -1}, {1, 1}})));
+    EXPECT_EQ((std::vector<uint64_t>{3, 4}), getIDs(file.query({{35, 35}, {55, 55}})));
+    EXPECT_TRUE(file.query({{100, 0}, {120, 10}}).empty());
+}
+
+TEST(FlatGeobuf, InvalidFile) {
+    EXPECT_THROW(FlatGeobufFile("test/fixtures/flatgeobuf/missing.fgb"), std::runtime_error);
+    EXPECT_THROW(FlatGeobufFile("test/fixtures/supercluster/places.json"), std::runtime_error);
+}
@@ -0,0 +1,65 @@
+#include <mbgl/util/geometry_util.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <cmath>
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+// A star shaped ring with a hole, so that horizontal lines cross many edges
+Polygon<int64_t> starPolygon() {
+    Polygon<int64_t> polygon(2);
+    constexpr int points = 200;
+    for (int i = 0; i <= points; ++i) {
+        const double angle = 2 * M_PI * i / points;
+        const double radius = i % 2 ? 400 : 250;
+        polygon[0].emplace_back(static_cast<int64_t>(500 + radius * std::cos(angle)),
+                                static_cast<int64_t>(500 + radius * std::sin(angle)));
+    }
+    polygon[1] = {{450, 450}, {550, 450}, {550, 550}, {450, 550}, {450, 450}};
+    return polygon;
+}
+
+} // namespace
+
+TEST(IndexedPolygon, PointWithin) {
+    const IndexedPolygon<int64_t> indexed({{{0, 0}, {10, 0}, {10, 10}, {0, 10}, {0, 0}}});
+    EXPECT_TRUE(indexed.pointWithin({5, 5}));
+    EXPECT_FALSE(indexed.pointWithin({15, 5}));
+    EXPECT_FALSE(indexed.pointWithin({-5, 5}));
+    EXPECT_FALSE(indexed.pointWithin({5, 20}));
+    EXPECT_FALSE(indexed.pointWithin({10, 5}));
+    EXPECT_TRUE(indexed.pointWithin({10, 5}, true));
+    EXPECT_TRUE(indexed.pointWithin({0, 0}, true));
+}
+
+TEST(IndexedPolygon, MatchesUnindexed) {
+    const Polygon<int64_t> polygon = starPolygon();
+    const IndexedPolygon<int64_t> indexed(polygon);
+
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int64_t> coordinate(-100, 1100);
+    for (int i = 0; i < 2000; ++i) {
+        Point<int64_t> a(coordinate(random), coordinate(random));
+        const Point<int64_t> b(coordinate(random), coordinate(random));
+        if (i % 4 == 0) {
+            // On the boundary
+            a = polygon[0][i % polygon[0].size()];
+        }
+        EXPECT_EQ(pointWithinPolygon(a, polygon), indexed.pointWithin(a));
+        EXPECT_EQ(pointWithinPolygon(a, polygon, true), indexed.pointWithin(a, true));
+        EXPECT_EQ(lineIntersectPolygon(a, b, polygon), indexed.lineIntersects(a, b));
+
+        const LineString<int64_t> line{a, b, {b.x + 20, b.y - 10}};
+        EXPECT_EQ(lineStringWithinPolygon(line, polygon), indexed.lineStringWithin(line));
+    }
+}
+
+TEST(IndexedPolygon, Empty) {
+    const IndexedPolygon<int64_t> indexed(Polygon<int64_t>{});
+    EXPECT_FALSE(indexed.pointWithin({0, 0}, true));
+    EXPECT_FALSE(indexed.lineIntersects({0, 0}, {10, 10}));
+}
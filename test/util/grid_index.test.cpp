@@ -55,3 +55,31 @@ TEST(GridIndex, IndexesFeaturesOverflow) {
     grid.insert(0, {{4500, 4500}, {4900, 4900}});
     EXPECT_EQ(grid.query({{4000, 4000}, {5000, 5000}}), (std::vector<int16_t>{0}));
 }
+
+TEST(GridIndex, HitTestPredicate) {
+    GridIndex<int16_t> grid(100, 100, 10);
+    grid.insert(0, {{10, 10}, {30, 30}});
+    grid.insert(1, {{50, 50}, 10});
+
+    auto isOne = [](const int16_t& key) {
+        return key == 1;
+    };
+    EXPECT_FALSE(grid.hitTest(GridIndex<int16_t>::BBox{{15, 15}, {20, 20}}, isOne));
+    EXPECT_TRUE(grid.hitTest(GridIndex<int16_t>::BBox{{15, 15}, {45, 45}}, isOne));
+    EXPECT_FALSE(grid.hitTest(GridIndex<int16_t>::BCircle{{20, 20}, 2}, isOne));
+    EXPECT_TRUE(grid.hitTest(GridIndex<int16_t>::BCircle{{20, 20}, 2}));
+}
+
+TEST(GridIndex, ReportsItemsSpanningCellsOnce) {
+    GridIndex<int16_t> grid(100, 100, 10);
+    // Enough items per cell to need several cell blocks
+    for (int16_t i = 0; i < 20; ++i) {
+        grid.insert(int16_t(i), {{5.0f + i, 5.0f}, {60.0f + i, 60.0f}});
+    }
+    grid.insert(20, {{40, 40}, 25});
+
+    std::vector<int16_t> expected(21);
+    for (int16_t i = 0; i < 21; ++i) expected[i] = i;
+    EXPECT_EQ(grid.query({{20, 20}, {50, 50}}), expected);
+    EXPECT_EQ(grid.query({{55, 55}, {90, 90}}), expected);
+}
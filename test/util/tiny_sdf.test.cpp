@@ -0,0 +1,55 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/tiny_sdf.hpp>
+
+#include <algorithm>
+
+using namespace mbgl;
+
+namespace {
+
+AlphaImage makeSquare(uint32_t width, uint32_t height, uint32_t border) {
+    AlphaImage image({width, height});
+    for (uint32_t y = border; y + border < height; ++y) {
+        for (uint32_t x = border; x + border < width; ++x) {
+            image.data[y * width + x] = (x == border || y == border) ? 128 : 255;
+        }
+    }
+    return image;
+}
+
+} // namespace
+
+TEST(TinySDF, Uniform) {
+    AlphaImage empty({8, 8});
+    const auto outside = util::transformRasterToSDF(empty, 8, .25);
+    EXPECT_TRUE(std::all_of(outside.data.get(), outside.data.get() + outside.bytes(), [](uint8_t value) {
+        return value == 0;
+    }));
+
+    AlphaImage full({8, 8});
+    full.fill(255);
+    const auto inside = util::transformRasterToSDF(full, 8, .25);
+    EXPECT_TRUE(std::all_of(inside.data.get(), inside.data.get() + inside.bytes(), [](uint8_t value) {
+        return value == 255;
+    }));
+}
+
+TEST(TinySDF, EdgeFallsOnCutoff) {
+    const auto sdf = util::transformRasterToSDF(makeSquare(20, 20, 5), 8, .25);
+    // Half covered pixels on the edge of the square
+    EXPECT_EQ(191, sdf.data[10 * 20 + 5]);
+    // Further out, the distance grows
+    EXPECT_LT(sdf.data[10 * 20 + 2], sdf.data[10 * 20 + 4]);
+    EXPECT_EQ(255, sdf.data[10 * 20 + 10]);
+}
+
+TEST(TinySDF, ReusedBuffers) {
+    // Transforming glyphs of different sizes with one instance gives the same
+    // result as a fresh transform each time
+    util::TinySDF sdf;
+    for (const auto& size : {Size{30, 30}, Size{12, 40}, Size{64, 20}, Size{30, 30}, Size{0, 0}}) {
+        const auto glyph = makeSquare(size.width, size.height, 3);
+        EXPECT_EQ(util::transformRasterToSDF(glyph, 8, .25), sdf.transform(glyph, 8, .25));
+    }
+}